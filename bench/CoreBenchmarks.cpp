@@ -0,0 +1,636 @@
+//    (google-benchmark).
+// : TrajectoryCalculatorBench --benchmark_out=results.json --benchmark_out_format=json
+// (  run_benchmarks,   benchmark_results.json   ).
+#include "../include/Calculations.h"
+#include "../include/ForceModels.h"
+#include "../include/TrajectorySink.h"
+#include "../include/ParameterSweep.h"
+#include "../include/BatchIntegrator.h"
+#include "../include/CsvExport.h"
+#include "../include/SimulationCache.h"
+#include "../include/SimulationConfig.h"
+#include "../include/NBodySimulation.h"
+#include "../include/MonteCarloEnsemble.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ---  :   operator new/delete ---
+//     ,  delete   .
+namespace {
+
+    std::atomic<long long> g_currentBytes{ 0 };
+    std::atomic<long long> g_peakBytes{ 0 };
+
+    constexpr std::size_t HEADER_SIZE = alignof(std::max_align_t);
+
+    void* trackedAllocate(std::size_t size) {
+        void* raw = std::malloc(size + HEADER_SIZE);
+        if (!raw) throw std::bad_alloc();
+        *static_cast<std::size_t*>(raw) = size;
+        long long now = g_currentBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed) + static_cast<long long>(size);
+        long long peak = g_peakBytes.load(std::memory_order_relaxed);
+        while (now > peak && !g_peakBytes.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {}
+        return static_cast<char*>(raw) + HEADER_SIZE;
+    }
+
+    void trackedFree(void* p) noexcept {
+        if (!p) return;
+        void* raw = static_cast<char*>(p) - HEADER_SIZE;
+        g_currentBytes.fetch_sub(static_cast<long long>(*static_cast<std::size_t*>(raw)), std::memory_order_relaxed);
+        std::free(raw);
+    }
+
+    //    ;      
+    long long resetPeak() {
+        long long now = g_currentBytes.load(std::memory_order_relaxed);
+        g_peakBytes.store(now, std::memory_order_relaxed);
+        return now;
+    }
+
+} // namespace
+
+void* operator new(std::size_t size) { return trackedAllocate(size); }
+void* operator new[](std::size_t size) { return trackedAllocate(size); }
+void operator delete(void* p) noexcept { trackedFree(p); }
+void operator delete[](void* p) noexcept { trackedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { trackedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { trackedFree(p); }
+//   (AlignedAllocator  TrajectoryBatch)    
+
+namespace {
+
+    //    (, G = M = 1,   x = 1.5)
+    enum Scenario {
+        SCENARIO_CIRCULAR = 0, //      
+        SCENARIO_DRAG_SPIRAL,  //     k = 0.05 (  )
+        SCENARIO_ESCAPE        //    ,   
+    };
+
+    SimulationParameters makeScenario(int scenario, int integrator) {
+        SimulationParameters params;
+        params.STEPS = 20000;
+        params.integrator = static_cast<IntegratorType>(integrator);
+        switch (scenario) {
+        case SCENARIO_CIRCULAR:
+            params.DRAG_COEFFICIENT = 0.0;
+            params.initialState.vy = std::sqrt(params.G * params.M / params.initialState.x);
+            break;
+        case SCENARIO_DRAG_SPIRAL:
+            break; //     Calculations.h
+        case SCENARIO_ESCAPE:
+            params.DRAG_COEFFICIENT = 0.0;
+            params.initialState.vy = 1.2 * std::sqrt(2.0 * params.G * params.M / params.initialState.x);
+            break;
+        }
+        return params;
+    }
+
+    const char* scenarioName(int scenario) {
+        switch (scenario) {
+        case SCENARIO_CIRCULAR: return "circular";
+        case SCENARIO_DRAG_SPIRAL: return "drag_spiral";
+        default: return "escape";
+        }
+    }
+
+    const char* integratorName(int integrator) {
+        return SimulationConfig::getIntegratorKey(static_cast<IntegratorType>(integrator));
+    }
+
+    // ,       :
+    //  ,    
+    class CountingSink : public TrajectorySink {
+    public:
+        void consume(size_t firstIndex, const State* states, size_t count) override {
+            m_count = firstIndex + count;
+            if (count > 0) m_last = states[count - 1];
+        }
+        size_t getCount() const { return m_count; }
+        const State& getLast() const { return m_last; }
+
+    private:
+        size_t m_count = 0;
+        State m_last{ 0.0, 0.0, 0.0, 0.0 };
+    };
+
+    // ---    RK4 (  ) ---
+    void BM_RK4SingleStep(benchmark::State& state) {
+        SimulationParameters params = makeScenario(SCENARIO_CIRCULAR, static_cast<int>(IntegratorType::RK4));
+        State s = { params.initialState.x, params.initialState.y, params.initialState.vx, params.initialState.vy };
+        for (auto _ : state) {
+            s = Calculations::rungeKuttaStep(s, params.DT, params);
+            const double x = s.x;
+            benchmark::DoNotOptimize(x);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    }
+    BENCHMARK(BM_RK4SingleStep);
+
+    //     :    params   ,
+    //  (F - k) * v  
+    struct ParametersForce {
+        const SimulationParameters& params;
+
+        State operator()(const State& s) const {
+            double r_squared = s.x * s.x + s.y * s.y;
+            if (r_squared == 0) {
+                return { s.vx, s.vy, 0, 0 };
+            }
+            double r = std::sqrt(r_squared);
+            double r_cubed = r_squared * r;
+            double common_factor_gravity = -params.G * params.M / r_cubed;
+            double net_propulsion_factor = params.THRUST_COEFFICIENT - params.DRAG_COEFFICIENT;
+            double ax = common_factor_gravity * s.x + net_propulsion_factor * s.vx;
+            double ay = common_factor_gravity * s.y + net_propulsion_factor * s.vy;
+            return { s.vx, s.vy, ax, ay };
+        }
+    };
+
+    // ---  RK4:      ,  dispatchForceModel ---
+    //   - KERNEL_STEPS  ;     
+    constexpr int KERNEL_STEPS = 20000;
+
+    template <typename Force>
+    State runKernel(const SimulationParameters& params, const Force& force) {
+        State s = { params.initialState.x, params.initialState.y, params.initialState.vx, params.initialState.vy };
+        for (int i = 0; i < KERNEL_STEPS; ++i) {
+            s = Calculations::rungeKuttaStep(s, params.DT, force);
+        }
+        return s;
+    }
+
+    void BM_ForceModelKernel(benchmark::State& state) {
+        const int scenario = static_cast<int>(state.range(0));
+        const bool specialised = state.range(1) != 0;
+        SimulationParameters params = makeScenario(scenario, static_cast<int>(IntegratorType::RK4));
+        state.SetLabel(std::string(scenarioName(scenario)) + (specialised ? "/specialised" : "/generic"));
+
+        State reference = runKernel(params, ParametersForce{ params });
+        State last{};
+        for (auto _ : state) {
+            if (specialised) {
+                dispatchForceModel(params, [&](const auto& force) { last = runKernel(params, force); });
+            }
+            else {
+                last = runKernel(params, ParametersForce{ params });
+            }
+            const double x = last.x;
+            benchmark::DoNotOptimize(x);
+        }
+        if (last.x != reference.x || last.y != reference.y || last.vx != reference.vx || last.vy != reference.vy) {
+            state.SkipWithError("specialised force model differs from the generic derivatives");
+            return;
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * KERNEL_STEPS);
+    }
+    BENCHMARK(BM_ForceModelKernel)
+        ->ArgNames({ "scenario", "specialised" })
+        ->ArgsProduct({ { SCENARIO_CIRCULAR, SCENARIO_DRAG_SPIRAL }, { 0, 1 } })
+        ->Unit(benchmark::kMicrosecond);
+
+    // ---  : RK4      ForceModels.h     ---
+    void BM_PerturbedRun(benchmark::State& state) {
+        const int model = static_cast<int>(state.range(0));
+        const char* labels[] = { "gravity", "j2", "atmosphere", "thrust", "all" };
+        state.SetLabel(labels[model]);
+
+        SimulationParameters params = makeScenario(SCENARIO_CIRCULAR, static_cast<int>(IntegratorType::RK4));
+        if (model == 1 || model == 4) params.perturbations.J2 = 0.1;
+        if (model == 2 || model == 4) {
+            params.perturbations.atmosphereDrag = 1e-3;
+            params.perturbations.atmosphereScaleHeight = 0.5;
+        }
+        if (model == 3 || model == 4) {
+            params.perturbations.thrustAcceleration = 1e-4;
+            params.perturbations.thrustAngle = 0.5;
+        }
+
+        Calculations calculator;
+        for (auto _ : state) {
+            CountingSink sink;
+            calculator.runSimulation(params, sink);
+            const size_t count = sink.getCount();
+            benchmark::DoNotOptimize(count);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * params.STEPS);
+    }
+    BENCHMARK(BM_PerturbedRun)
+        ->ArgName("model")
+        ->DenseRange(0, 4)
+        ->Unit(benchmark::kMillisecond);
+
+    // ---  :  x  ---
+    void BM_FullRun(benchmark::State& state) {
+        const int scenario = static_cast<int>(state.range(0));
+        const int integrator = static_cast<int>(state.range(1));
+        SimulationParameters params = makeScenario(scenario, integrator);
+        state.SetLabel(std::string(scenarioName(scenario)) + "/" + integratorName(integrator));
+
+        Calculations calculator;
+        size_t points = 0;
+        State last{};
+        for (auto _ : state) {
+            CountingSink sink;
+            calculator.runSimulation(params, sink);
+            //    DoNotOptimize: "+m,r"  benchmark 1.7  GCC  
+            const size_t count = sink.getCount();
+            benchmark::DoNotOptimize(count);
+            points = count;
+            last = sink.getLast();
+        }
+        State initial = { params.initialState.x, params.initialState.y, params.initialState.vx, params.initialState.vy };
+        double e0 = Calculations::specificEnergy(initial, params);
+        double e1 = Calculations::specificEnergy(last, params);
+
+        const IntegrationStats& stats = calculator.getLastStats();
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(points));
+        state.counters["points"] = static_cast<double>(points);
+        state.counters["integration_steps"] = static_cast<double>(stats.acceptedSteps);
+        state.counters["rejected_steps"] = static_cast<double>(stats.rejectedSteps);
+        state.counters["derivative_evals"] = static_cast<double>(stats.derivativeEvaluations);
+        state.counters["steps_per_second"] = benchmark::Counter(
+            static_cast<double>(stats.acceptedSteps), benchmark::Counter::kIsIterationInvariantRate);
+        //    :       
+        state.counters["energy_drift"] = std::fabs(e1 - e0) / std::max(std::fabs(e0), 1e-300);
+        double l0 = Calculations::specificAngularMomentum(initial);
+        double l1 = Calculations::specificAngularMomentum(last);
+        state.counters["L_drift"] = std::fabs(l1 - l0) / std::max(std::fabs(l0), 1e-300);
+    }
+    BENCHMARK(BM_FullRun)
+        ->ArgNames({ "scenario", "integrator" })
+        ->ArgsProduct({ { SCENARIO_CIRCULAR, SCENARIO_DRAG_SPIRAL, SCENARIO_ESCAPE },
+                        { static_cast<int>(IntegratorType::RK4), static_cast<int>(IntegratorType::DormandPrince45),
+                          static_cast<int>(IntegratorType::VelocityVerlet), static_cast<int>(IntegratorType::Yoshida4) } })
+        ->Unit(benchmark::kMillisecond);
+
+    // ---   :          ---
+    //   (e ~ 0.46, ~80 ); DT  ,   
+    //  ~1    : RK4 - 4  ,  - 3,  - 1
+    void BM_LongTermDrift(benchmark::State& state) {
+        const int integrator = static_cast<int>(state.range(0));
+        SimulationParameters params = makeScenario(SCENARIO_CIRCULAR, integrator);
+        params.initialState.vy = 0.6;
+        params.DT = static_cast<double>(state.range(1)) * 1e-4;
+        params.STEPS = static_cast<int>(1000.0 / params.DT);
+        state.SetLabel(std::string(integratorName(integrator)) + "/dt=" + std::to_string(params.DT));
+
+        Calculations calculator;
+        ConservationReport report;
+        for (auto _ : state) {
+            ConservationSink sink;
+            calculator.runSimulation(params, sink);
+            report = sink.getReport();
+            const size_t points = report.points;
+            benchmark::DoNotOptimize(points);
+        }
+        state.counters["derivative_evals"] = static_cast<double>(calculator.getLastStats().derivativeEvaluations);
+        state.counters["max_energy_drift"] = report.maxEnergyDrift;
+        state.counters["final_energy_drift"] = report.finalEnergyDrift;
+        state.counters["max_L_drift"] = report.maxAngularMomentumDrift;
+    }
+    BENCHMARK(BM_LongTermDrift)
+        ->ArgNames({ "integrator", "dt_1e-4" })
+        ->Args({ static_cast<int>(IntegratorType::RK4), 40 })
+        ->Args({ static_cast<int>(IntegratorType::VelocityVerlet), 10 })
+        ->Args({ static_cast<int>(IntegratorType::Yoshida4), 30 })
+        ->Args({ static_cast<int>(IntegratorType::RK4), 10 })
+        ->Unit(benchmark::kMillisecond);
+
+    // ---  :        ---
+    void BM_PeakMemory(benchmark::State& state) {
+        const bool streaming = state.range(0) != 0;
+        SimulationParameters params = makeScenario(SCENARIO_CIRCULAR, static_cast<int>(IntegratorType::RK4));
+        params.STEPS = static_cast<int>(state.range(1));
+        state.SetLabel(streaming ? "streaming" : "vector");
+
+        Calculations calculator;
+        long long peakBytes = 0;
+        for (auto _ : state) {
+            long long base = resetPeak();
+            if (streaming) {
+                CountingSink sink;
+                calculator.runSimulation(params, sink);
+                const size_t count = sink.getCount();
+                benchmark::DoNotOptimize(count);
+            }
+            else {
+                std::vector<State> states = calculator.runSimulation(params);
+                const size_t count = states.size();
+                benchmark::DoNotOptimize(count);
+            }
+            peakBytes = std::max(peakBytes, g_peakBytes.load(std::memory_order_relaxed) - base);
+        }
+        state.counters["peak_bytes"] = static_cast<double>(peakBytes);
+    }
+    BENCHMARK(BM_PeakMemory)
+        ->ArgNames({ "streaming", "steps" })
+        ->ArgsProduct({ { 0, 1 }, { 100000, 1000000 } })
+        ->Unit(benchmark::kMillisecond);
+
+    // ---  :  (Calculations)  SIMD- (TrajectoryBatch) ---
+    std::vector<SimulationParameters> makeSweepRuns(size_t count) {
+        SimulationParameters base = makeScenario(SCENARIO_DRAG_SPIRAL, static_cast<int>(IntegratorType::RK4));
+        base.STEPS = 5000;
+        std::vector<SimulationParameters> runs(count, base);
+        for (size_t i = 0; i < count; ++i) {
+            runs[i].initialState.vy = 0.5 + 0.5 * static_cast<double>(i) / static_cast<double>(count);
+            runs[i].DRAG_COEFFICIENT = 0.01 * static_cast<double>(i % 8);
+        }
+        return runs;
+    }
+
+    void BM_SweepScalar(benchmark::State& state) {
+        std::vector<SimulationParameters> runs = makeSweepRuns(static_cast<size_t>(state.range(0)));
+        Calculations calculator;
+        for (auto _ : state) {
+            for (const SimulationParameters& params : runs) {
+                CountingSink sink;
+                calculator.runSimulation(params, sink);
+                const size_t count = sink.getCount();
+                benchmark::DoNotOptimize(count);
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+    }
+    BENCHMARK(BM_SweepScalar)->Arg(64)->Unit(benchmark::kMillisecond);
+
+    void BM_SweepBatched(benchmark::State& state) {
+        std::vector<SimulationParameters> runs = makeSweepRuns(static_cast<size_t>(state.range(0)));
+        const BatchKernel kernel = state.range(1) != 0 ? BatchKernel::Native : BatchKernel::Scalar;
+
+        //    RK4:      
+        Calculations calculator;
+        TrajectoryBatch check(runs, kernel);
+        check.advance(runs.front().STEPS);
+        double maxDeviation = 0.0;
+        for (size_t i = 0; i < runs.size(); ++i) {
+            CountingSink sink;
+            calculator.runSimulation(runs[i], sink);
+            const State& a = sink.getLast();
+            State b = check.getState(i);
+            double scale = std::max(std::hypot(a.x, a.y), 1e-300);
+            maxDeviation = std::max(maxDeviation, std::hypot(a.x - b.x, a.y - b.y) / scale);
+        }
+        state.SetLabel(check.getKernelName());
+        if (maxDeviation > TrajectoryBatch::BATCH_REFERENCE_TOLERANCE) {
+            state.SkipWithError("TrajectoryBatch deviates from scalar RK4 beyond BATCH_REFERENCE_TOLERANCE");
+            return;
+        }
+
+        for (auto _ : state) {
+            TrajectoryBatch batch(runs, kernel);
+            batch.advance(runs.front().STEPS);
+            const bool active = batch.hasActiveLanes();
+            benchmark::DoNotOptimize(active);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+        state.counters["max_rel_deviation"] = maxDeviation;
+    }
+    BENCHMARK(BM_SweepBatched)
+        ->ArgNames({ "runs", "simd" })
+        ->ArgsProduct({ { 64 }, { 0, 1 } })
+        ->Unit(benchmark::kMillisecond);
+
+    // ---      (  ) ---
+    void BM_ParameterSweep(benchmark::State& state) {
+        std::vector<SimulationParameters> runs = makeSweepRuns(static_cast<size_t>(state.range(0)));
+        const bool batched = state.range(1) != 0;
+        state.SetLabel(batched ? "runBatched" : "run");
+        ParameterSweep sweep;
+        for (auto _ : state) {
+            std::vector<SweepRunSummary> summaries = batched ? sweep.runBatched(runs) : sweep.run(runs);
+            const size_t count = summaries.size();
+            benchmark::DoNotOptimize(count);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+        state.counters["threads"] = static_cast<double>(sweep.getThreadCount());
+    }
+    BENCHMARK(BM_ParameterSweep)
+        ->ArgNames({ "runs", "batched" })
+        ->ArgsProduct({ { 256 }, { 0, 1 } })
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+
+    // ,    :  ,   
+    class CountingStreamBuf : public std::streambuf {
+    public:
+        size_t getBytes() const { return m_bytes; }
+
+    protected:
+        std::streamsize xsputn(const char*, std::streamsize count) override {
+            m_bytes += static_cast<size_t>(count);
+            return count;
+        }
+        int_type overflow(int_type ch) override {
+            if (!traits_type::eq_int_type(ch, traits_type::eof())) ++m_bytes;
+            return traits_type::not_eof(ch);
+        }
+
+    private:
+        size_t m_bytes = 0;
+    };
+
+    // ---  CSV:   iostream  CsvTrajectoryWriter ---
+    void BM_CsvExport(benchmark::State& state) {
+        const size_t rows = static_cast<size_t>(state.range(0));
+        const bool fast = state.range(1) != 0;
+        state.SetLabel(fast ? "to_chars" : "iostream");
+
+        SimulationParameters params = makeScenario(SCENARIO_CIRCULAR, static_cast<int>(IntegratorType::RK4));
+        params.STEPS = static_cast<int>(rows - 1); //     
+        CollectingSink trajectory;
+        Calculations calculator;
+        calculator.runSimulation(params, trajectory);
+        const std::vector<State>& states = trajectory.getStates();
+
+        size_t bytes = 0;
+        for (auto _ : state) {
+            CountingStreamBuf buffer;
+            std::ostream out(&buffer);
+            if (fast) {
+                CsvTrajectoryWriter writer(out);
+                writer.writeHeader();
+                writer.writeRows(0, states.data(), states.size(), params.DT);
+                writer.flush();
+            }
+            else {
+                out << std::fixed << std::setprecision(5);
+                out << CsvTrajectoryWriter::HEADER;
+                for (size_t i = 0; i < states.size(); ++i) {
+                    const State& s = states[i];
+                    out << i << ",  " << static_cast<double>(i) * params.DT << ",  "
+                        << s.x << ",  " << s.y << ",  " << s.vx << ",  " << s.vy << "\n";
+                }
+            }
+            bytes = buffer.getBytes();
+            benchmark::DoNotOptimize(bytes);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(states.size()));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(bytes));
+    }
+    BENCHMARK(BM_CsvExport)
+        ->ArgNames({ "rows", "to_chars" })
+        ->ArgsProduct({ { 1000000 }, { 0, 1 } })
+        ->Unit(benchmark::kMillisecond);
+
+    // ---  :   LivePreviewSink  -     ---
+    void BM_LivePreview(benchmark::State& state) {
+        const bool preview = state.range(1) != 0;
+        SimulationParameters params = makeScenario(SCENARIO_CIRCULAR, static_cast<int>(IntegratorType::RK4));
+        params.STEPS = static_cast<int>(state.range(0));
+        state.SetLabel(preview ? "preview" : "blocking");
+
+        Calculations calculator;
+        size_t received = 0;
+        size_t dropped = 0;
+        for (auto _ : state) {
+            auto sink = std::make_shared<CountingSink>();
+            if (!preview) {
+                calculator.runSimulation(params, *sink);
+            }
+            else {
+                //     :      (~16 )
+                auto previewSink = std::make_shared<LivePreviewSink>(200000);
+                std::atomic<bool> done(false);
+                std::thread consumer([&]() {
+                    IndexedState batch[1024];
+                    received = 0;
+                    while (true) {
+                        const bool finished = done.load(std::memory_order_acquire);
+                        size_t count;
+                        while ((count = previewSink->poll(batch, 1024)) > 0) received += count;
+                        if (finished) break;
+                        std::this_thread::sleep_for(std::chrono::milliseconds(16));
+                    }
+                });
+                FanOutSink fanOut({ sink, previewSink });
+                calculator.runSimulation(params, fanOut);
+                done.store(true, std::memory_order_release);
+                state.PauseTiming(); //  ;  ""    
+                consumer.join();
+                state.ResumeTiming();
+                dropped = previewSink->getDroppedCount();
+            }
+            const size_t count = sink->getCount();
+            benchmark::DoNotOptimize(count);
+        }
+        state.counters["preview_points"] = static_cast<double>(received);
+        state.counters["dropped_points"] = static_cast<double>(dropped);
+    }
+    BENCHMARK(BM_LivePreview)
+        ->ArgNames({ "steps", "preview" })
+        ->ArgsProduct({ { 1000000, 10000000 }, { 0, 1 } })
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+
+    // ---  :          ---
+    void BM_SimulationCache(benchmark::State& state) {
+        const int mode = static_cast<int>(state.range(1)); // 0 - , 1 - , 2 - 
+        const char* labels[] = { "recompute", "memory_hit", "disk_hit" };
+        state.SetLabel(labels[mode]);
+
+        SimulationParameters params = makeScenario(SCENARIO_CIRCULAR, static_cast<int>(IntegratorType::RK4));
+        params.STEPS = static_cast<int>(state.range(0));
+
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "trajcalc_bench_cache";
+        std::filesystem::remove_all(directory);
+        SimulationCache cache(mode == 2 ? directory.u8string() : std::string());
+        {
+            CollectingSink trajectory;
+            Calculations calculator;
+            calculator.runSimulation(params, trajectory);
+            cache.store(params, std::make_shared<const std::vector<State>>(std::move(trajectory.getStates())));
+        }
+
+        SimulationCache::StatesPtr states;
+        for (auto _ : state) {
+            if (mode == 0) {
+                CollectingSink trajectory;
+                Calculations calculator;
+                calculator.runSimulation(params, trajectory);
+                states = std::make_shared<const std::vector<State>>(std::move(trajectory.getStates()));
+            }
+            else {
+                if (mode == 2) cache.clearMemory(); //    ,     
+                const bool found = cache.find(params, states);
+                benchmark::DoNotOptimize(found);
+            }
+            const size_t count = states ? states->size() : 0;
+            benchmark::DoNotOptimize(count);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(states ? states->size() : 0));
+        std::filesystem::remove_all(directory);
+    }
+    BENCHMARK(BM_SimulationCache)
+        ->ArgNames({ "steps", "mode" })
+        ->ArgsProduct({ { 100000, 1000000 }, { 0, 1, 2 } })
+        ->Unit(benchmark::kMillisecond);
+
+    // --- N :       -    ---
+    void BM_NBodyForces(benchmark::State& state) {
+        const size_t particles = static_cast<size_t>(state.range(0));
+        const bool tree = state.range(1) != 0;
+        state.SetLabel(tree ? "barnes_hut" : "direct");
+
+        NBodyParameters params;
+        NBodySystem system;
+        system.addBody(1.0, { 0.0, 0.0, 0.0, 0.0 });
+        NBodySimulation::addDebrisRing(system, params.G, 0, particles, 1.2, 2.0, 1e-9, 1);
+        NBodySimulation simulation;
+        std::vector<double> ax, ay;
+        for (auto _ : state) {
+            if (tree) simulation.computeAccelerations(params, system, ax, ay);
+            else simulation.computeAccelerationsDirect(params, system, ax, ay);
+            const double first = ax[0];
+            benchmark::DoNotOptimize(first);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(system.size()));
+        state.counters["tree_nodes"] = static_cast<double>(simulation.getLastStats().treeNodes);
+        state.counters["threads"] = static_cast<double>(simulation.getThreadCount());
+    }
+    BENCHMARK(BM_NBodyForces)
+        ->ArgNames({ "bodies", "tree" })
+        ->Args({ 1000, 0 })->Args({ 1000, 1 })
+        ->Args({ 10000, 0 })->Args({ 10000, 1 })
+        ->Args({ 100000, 1 })
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+
+    // ---  -:            ---
+    void BM_MonteCarloEnsemble(benchmark::State& state) {
+        SimulationParameters params;
+        EnsembleDispersion dispersion{ 0.01, 0.01, 0.005 };
+        EnsembleSettings settings;
+        settings.runs = static_cast<size_t>(state.range(0));
+        MonteCarloEnsemble ensemble;
+        for (auto _ : state) {
+            const size_t impacts = ensemble.run(params, dispersion, settings).impacts;
+            benchmark::DoNotOptimize(impacts);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+        state.counters["threads"] = static_cast<double>(ensemble.getThreadCount());
+    }
+    BENCHMARK(BM_MonteCarloEnsemble)
+        ->ArgName("runs")
+        ->Arg(64)->Arg(256)
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,80 @@
+#pragma once
+#ifndef BATCHINTEGRATOR_H
+#define BATCHINTEGRATOR_H
+
+#include "../include/Calculations.h"
+#include "../include/SimdVector.h"
+
+#include <vector>
+
+//    RK4
+enum class BatchKernel {
+    Native, //      (AVX-512 / AVX2 / )
+    Scalar  //    (  )
+};
+
+//  ,    RK4  (  ).
+//      (x, y, vx, vy   
+// ),    SIMD-   .
+//     G * M,  k  F,    STEPS;   DT.
+//  (SimulationParameters::perturbations)    .
+// ,       STEPS, 
+//    .
+//
+// :     Calculations::rungeKuttaStep,  
+//        FMA (-ffp-contract=off, /fp:precise)
+//     RK4 .    
+// (, -march=native  FMA),    -     
+//  ,     RK4 ( 1e-8    20000 
+//  ).    - BATCH_REFERENCE_TOLERANCE ().
+class TrajectoryBatch {
+public:
+    static constexpr double BATCH_REFERENCE_TOLERANCE = 1e-6;
+
+    explicit TrajectoryBatch(const std::vector<SimulationParameters>& runs, BatchKernel kernel = BatchKernel::Native);
+
+    size_t size() const { return m_laneCount; }
+    double getDT() const { return m_dt; }
+
+    //   maxSteps     .
+    //     ( maxSteps,    ).
+    long long advance(long long maxSteps);
+
+    bool hasActiveLanes() const;
+
+    State getState(size_t lane) const;
+    long long getStepsTaken(size_t lane) const;  //   (  - 1)
+    long long getImpactStep(size_t lane) const;  //     -1
+    double getMinR(size_t lane) const;
+    double getMaxR(size_t lane) const;
+
+    //  ,    ("AVX-512", "AVX2", "scalar")
+    const char* getKernelName() const;
+
+private:
+    template <typename Traits>
+    void stepKernel();
+
+    void recordImpacts(size_t firstLane, unsigned impactBits);
+
+    size_t m_laneCount;
+    size_t m_paddedCount;
+    double m_dt;
+    long long m_stepIndex; //    (  )
+    BatchKernel m_kernel;
+
+    // 
+    simd::AlignedDoubles m_x, m_y, m_vx, m_vy;
+    //   
+    simd::AlignedDoubles m_negGM;       // -G * M
+    simd::AlignedDoubles m_propulsion;  // F - k
+    simd::AlignedDoubles m_radiusSq;    // CENTRAL_BODY_RADIUS^2
+    simd::AlignedDoubles m_stepLimit;   // STEPS
+    //   (double,     )
+    simd::AlignedDoubles m_active;      // 1.0 -   
+    simd::AlignedDoubles m_stepsTaken;
+    simd::AlignedDoubles m_minRSq, m_maxRSq;
+    std::vector<long long> m_impactStep;
+};
+
+#endif // BATCHINTEGRATOR_H
@@ -3,9 +3,21 @@
 
 #include <vector>
 #include <string>
+#include <atomic>   //  SimulationControl
+#include <cstdint>  //  std::uint64_t
 #include <cmath>    //  std::sqrt
 #include <iostream> //  std::cerr
 
+//   
+enum class IntegratorType {
+    RK4,             //  - 4-     DT
+    DormandPrince45, //  - 5(4) (-)   
+    //      DT:     (k = F = 0)
+    //     ,    ,     
+    VelocityVerlet,  //   ("--"), 2- ,     
+    Yoshida4         //      , 4- ,     
+};
+
 //  
 struct SimulationParameters {
     double G = 1.0;
@@ -22,6 +34,38 @@ struct SimulationParameters {
         double vx = 0.0;
         double vy = 0.8;
     } initialState;
+
+    IntegratorType integrator = IntegratorType::RK4;
+
+    //    (  DormandPrince45).
+    //    DT     ,    :
+    //    i * DT      .
+    struct AdaptiveStepParams {
+        double rtol = 1e-9;         //   
+        double atol = 1e-12;        //   
+        double minStep = 1e-9;      //  ;      
+        double maxStep = 0.5;       //  
+        double initialStep = 1e-3;  //   
+    } adaptive;
+
+    //  (ForceModels.h),     . ,    
+    struct PerturbationParams {
+        double J2 = 0.0;                     //   ;   - CENTRAL_BODY_RADIUS
+        double atmosphereDrag = 0.0;         //      (r = CENTRAL_BODY_RADIUS)
+        double atmosphereScaleHeight = 0.0;  // ,       e 
+        double thrustAcceleration = 0.0;     //     
+        double thrustAngle = 0.0;            //   :    x, 
+
+        bool hasAny() const { return J2 != 0.0 || atmosphereDrag != 0.0 || thrustAcceleration != 0.0; }
+    } perturbations;
+};
+
+//    
+struct IntegrationStats {
+    long long acceptedSteps = 0;          //   
+    long long rejectedSteps = 0;          //   (  )
+    long long derivativeEvaluations = 0;  //   
+    long long forcedMinSteps = 0;         // ,   minStep   
 };
 
 //  
@@ -29,19 +73,147 @@ struct State {
     double x, y, vx, vy;
 };
 
+//     :     
+struct SimulationControl {
+    std::atomic<bool> cancelRequested{ false };
+    std::atomic<int> completedSteps{ 0 };
+};
+
+//   :    stepIndex  i * DT  ,    .
+//   resumeSimulation  ,   .
+struct SimulationCheckpoint {
+    SimulationParameters params;
+    std::uint64_t stepIndex = 0;
+    State state{ 0.0, 0.0, 0.0, 0.0 };
+};
+
+class TrajectorySink;         // TrajectorySink.h
+class TrajectoryChunkBuffer;  // TrajectorySink.h
+
 class Calculations {
 public:
     Calculations(); //   
 
-    //     
-    std::vector<State> runSimulation(const SimulationParameters& params);
+    //     .
+    // control ()   PROGRESS_INTERVAL_STEPS .
+    std::vector<State> runSimulation(const SimulationParameters& params, SimulationControl* control = nullptr);
 
-private:
-    //     
-    static State derivatives(const State& s, const SimulationParameters& params);
+    //  :       ,
+    //      .
+    void runSimulation(const SimulationParameters& params, TrajectorySink& sink, SimulationControl* control = nullptr);
+
+    //      params.STEPS:     ,
+    //    from.stepIndex + 1. params      (sameModel),
+    //  STEPS -    from.stepIndex;     std::cerr   false.
+    //  RK4 (    k = F = 0)     
+    // ; DormandPrince45      adaptive.initialStep, 
+    //      .
+    bool resumeSimulation(const SimulationParameters& params, const SimulationCheckpoint& from,
+        TrajectorySink& sink, SimulationControl* control = nullptr);
+
+    //   ,     (STEPS  )
+    static bool sameModel(const SimulationParameters& a, const SimulationParameters& b);
+
+    //   ( )       
+    static constexpr int PROGRESS_INTERVAL_STEPS = 4096;
+
+    //    runSimulation
+    const IntegrationStats& getLastStats() const { return m_lastStats; }
+
+    //       std::cout (;      )
+    void setEventMessages(bool enabled) { m_eventMessages = enabled; }
+
+    //    v^2 / 2 - G * M / r
+    static double specificEnergy(const State& s, const SimulationParameters& params);
+
+    //    x * vy - y * vx (  k = F = 0)
+    static double specificAngularMomentum(const State& s);
 
     //     - 4- 
     static State rungeKuttaStep(const State& s, double dt, const SimulationParameters& params);
+
+    //      h. derivative -      (  vx, vy);
+    //         ,     .
+    //  k, F != 0           (   )
+    static void velocityVerletStep(State& s, State& derivative, double h, const SimulationParameters& params);
+
+    //       (ForceModels.h): force(s)   .
+    //     ,     params   
+    template <typename Force>
+    static State rungeKuttaStep(const State& s, double dt, const Force& force);
+    template <typename Force>
+    static void velocityVerletStep(State& s, State& derivative, double h, const Force& force);
+
+private:
+    //     DT; currentState -    firstStep.
+    // step(state)      DT 
+    template <typename StepFunction>
+    void integrateFixedStep(const SimulationParameters& params, State currentState, int firstStep,
+        TrajectoryChunkBuffer& output, SimulationControl* control, StepFunction step);
+
+    //   - 5(4)     i * DT
+    template <typename Force>
+    void integrateAdaptive(const SimulationParameters& params, const Force& force, State currentState, int firstStep,
+        TrajectoryChunkBuffer& output, SimulationControl* control);
+
+    //    (dispatchForceModel)  ;    
+    //     currentState
+    void integrate(const SimulationParameters& params, const State& currentState, int firstStep,
+        TrajectoryChunkBuffer& output, SimulationControl* control);
+    template <typename Force>
+    void integrateWithForce(const SimulationParameters& params, const Force& force, const State& currentState, int firstStep,
+        TrajectoryChunkBuffer& output, SimulationControl* control);
+
+    IntegrationStats m_lastStats;
+    bool m_eventMessages = true;
 };
 
+template <typename Force>
+State Calculations::rungeKuttaStep(const State& s, double dt, const Force& force) {
+    State k1 = force(s);
+
+    State s_temp_k2 = {
+        s.x + dt * k1.x / 2.0,
+        s.y + dt * k1.y / 2.0,
+        s.vx + dt * k1.vx / 2.0,
+        s.vy + dt * k1.vy / 2.0
+    };
+    State k2 = force(s_temp_k2);
+
+    State s_temp_k3 = {
+        s.x + dt * k2.x / 2.0,
+        s.y + dt * k2.y / 2.0,
+        s.vx + dt * k2.vx / 2.0,
+        s.vy + dt * k2.vy / 2.0
+    };
+    State k3 = force(s_temp_k3);
+
+    State s_temp_k4 = {
+        s.x + dt * k3.x,
+        s.y + dt * k3.y,
+        s.vx + dt * k3.vx,
+        s.vy + dt * k3.vy
+    };
+    State k4 = force(s_temp_k4);
+
+    return {
+        s.x + dt / 6.0 * (k1.x + 2.0 * k2.x + 2.0 * k3.x + k4.x),
+        s.y + dt / 6.0 * (k1.y + 2.0 * k2.y + 2.0 * k3.y + k4.y),
+        s.vx + dt / 6.0 * (k1.vx + 2.0 * k2.vx + 2.0 * k3.vx + k4.vx),
+        s.vy + dt / 6.0 * (k1.vy + 2.0 * k2.vy + 2.0 * k3.vy + k4.vy)
+    };
+}
+
+template <typename Force>
+void Calculations::velocityVerletStep(State& s, State& derivative, double h, const Force& force) {
+    const double halfStep = 0.5 * h;
+    s.vx += halfStep * derivative.vx; // derivative = { vx, vy, ax, ay }
+    s.vy += halfStep * derivative.vy;
+    s.x += h * s.vx;
+    s.y += h * s.vy;
+    derivative = force(s);
+    s.vx += halfStep * derivative.vx;
+    s.vy += halfStep * derivative.vy;
+}
+
 #endif CALCULATIONS_H
\ No newline at end of file
@@ -0,0 +1,101 @@
+#pragma once
+#ifndef CSVEXPORT_H
+#define CSVEXPORT_H
+
+#include "../include/Calculations.h"
+
+#include <atomic>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+//    CSV  std::to_chars (   iostream   ).
+//     std::fixed << std::setprecision(5):
+//   Step_Index, Time_dimless(approx), x_dimless, y_dimless, vx_dimless, vy_dimless
+//   0,  0.00000,  1.50000,  0.00000,  0.00000,  0.71068
+//           BUFFER_SIZE.
+class CsvTrajectoryWriter {
+public:
+    static constexpr int PRECISION = 5;
+    static constexpr size_t BUFFER_SIZE = size_t(1) << 20;
+    static constexpr size_t MAX_ROW_LENGTH = 2048; //  : 5   1e308  fixed  
+    static const char* const HEADER;
+
+    explicit CsvTrajectoryWriter(std::ostream& out);
+    ~CsvTrajectoryWriter(); //   
+
+    CsvTrajectoryWriter(const CsvTrajectoryWriter&) = delete;
+    CsvTrajectoryWriter& operator=(const CsvTrajectoryWriter&) = delete;
+
+    void writeHeader();
+    //  firstIndex .. firstIndex + count - 1,   i  i * dt
+    void writeRows(size_t firstIndex, const State* states, size_t count, double dt);
+
+    //    ; false,     
+    bool flush();
+
+    //      (path  UTF-8). completedRows  cancelRequested
+    // :     ,    .
+    static bool writeFile(const std::string& path, const State* states, size_t count, double dt,
+        std::atomic<size_t>* completedRows = nullptr, const std::atomic<bool>* cancelRequested = nullptr);
+
+private:
+    void appendRow(size_t index, double time, const State& state);
+
+    std::ostream& m_out;
+    std::vector<char> m_buffer;
+    size_t m_used;
+};
+
+//   CSV,       .
+//   SimulationJob,      .
+//  states        .
+class CsvExportJob {
+public:
+    enum class Status {
+        Idle,      //       
+        Running,   //  
+        Finished,  //  
+        Failed,    //     
+        Cancelled  //  ,  
+    };
+
+    CsvExportJob();
+    ~CsvExportJob(); //      
+
+    CsvExportJob(const CsvExportJob&) = delete;
+    CsvExportJob& operator=(const CsvExportJob&) = delete;
+
+    //  .    .
+    void start(const std::string& path, const State* states, size_t count, double dt);
+    void cancel();
+
+    Status getStatus() const { return m_status.load(std::memory_order_acquire); }
+    bool isRunning() const { return getStatus() == Status::Running; }
+
+    //      [0, 1]
+    double getProgress() const;
+    size_t getRowCount() const { return m_count; }
+    const std::string& getPath() const { return m_path; }
+
+    //    (   ),    Idle
+    //   true; succeeded  .
+    bool acknowledgeFinished(bool& succeeded);
+
+private:
+    void cancelAndJoin();
+    void workerMain();
+
+    std::thread m_worker;
+    std::atomic<Status> m_status;
+    std::atomic<bool> m_cancelRequested;
+    std::atomic<size_t> m_completedRows;
+
+    std::string m_path;
+    const State* m_states;
+    size_t m_count;
+    double m_dt;
+};
+
+#endif // CSVEXPORT_H
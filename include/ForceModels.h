@@ -0,0 +1,231 @@
+#pragma once
+#ifndef FORCEMODELS_H
+#define FORCEMODELS_H
+
+#include "../include/Calculations.h" //  State  SimulationParameters
+
+#include <cmath> //  std::sqrt, std::exp, std::cos, std::sin
+#include <tuple>
+#include <utility> //  std::index_sequence
+
+//       ;   
+// GCC       (-),      
+#if defined(_MSC_VER)
+#define FORCE_MODEL_INLINE __forceinline
+#elif defined(__GNUC__)
+#define FORCE_MODEL_INLINE inline __attribute__((always_inline))
+#else
+#define FORCE_MODEL_INLINE inline
+#endif
+
+//         Calculations::rungeKuttaStep<Force>
+//  velocityVerletStep<Force>.       (dispatchForceModel),
+//    ,      SimulationParameters
+//    ,      .
+//
+//  - Composite<Terms...>,   ,   
+// (  ).  -     SimulationParameters  
+//   void accumulate(const State& s, const Position& p, double& ax, double& ay) const,
+//      (ax, ay).   
+//   static bool isActive(const SimulationParameters& params)
+//    Perturbations: dispatchForceModel     .
+//   :       .
+namespace ForceModel {
+
+    //      :       
+    struct Position {
+        double r_squared;
+        double r;
+    };
+
+    //    : -G * M / r^3 * r
+    class CentralGravity {
+    public:
+        explicit CentralGravity(const SimulationParameters& params)
+            : m_negativeMu(-params.G * params.M) {
+        }
+
+        FORCE_MODEL_INLINE void accumulate(const State& s, const Position& p, double& ax, double& ay) const {
+            double common_factor_gravity = m_negativeMu / (p.r_squared * p.r);
+            ax += common_factor_gravity * s.x;
+            ay += common_factor_gravity * s.y;
+        }
+
+    private:
+        double m_negativeMu;
+    };
+
+    //   -k * v ( F = 0)
+    class LinearDrag {
+    public:
+        explicit LinearDrag(const SimulationParameters& params)
+            : m_factor(-params.DRAG_COEFFICIENT) {
+        }
+
+        FORCE_MODEL_INLINE void accumulate(const State& s, const Position&, double& ax, double& ay) const {
+            ax += m_factor * s.vx;
+            ay += m_factor * s.vy;
+        }
+
+    private:
+        double m_factor;
+    };
+
+    //      : (F - k) * v
+    class LinearDragThrust {
+    public:
+        explicit LinearDragThrust(const SimulationParameters& params)
+            : m_factor(params.THRUST_COEFFICIENT - params.DRAG_COEFFICIENT) {
+        }
+
+        FORCE_MODEL_INLINE void accumulate(const State& s, const Position&, double& ax, double& ay) const {
+            ax += m_factor * s.vx;
+            ay += m_factor * s.vy;
+        }
+
+    private:
+        double m_factor;
+    };
+
+    //    (  )   :
+    // -3/2 * J2 * G * M * R^2 / r^5 * r, R - CENTRAL_BODY_RADIUS
+    class J2Oblateness {
+    public:
+        explicit J2Oblateness(const SimulationParameters& params)
+            : m_factor(-1.5 * params.perturbations.J2 * params.G * params.M
+                * params.CENTRAL_BODY_RADIUS * params.CENTRAL_BODY_RADIUS) {
+        }
+
+        static bool isActive(const SimulationParameters& params) { return params.perturbations.J2 != 0.0; }
+
+        FORCE_MODEL_INLINE void accumulate(const State& s, const Position& p, double& ax, double& ay) const {
+            double factor = m_factor / (p.r_squared * p.r_squared * p.r);
+            ax += factor * s.x;
+            ay += factor * s.y;
+        }
+
+    private:
+        double m_factor;
+    };
+
+    //    :
+    // -k0 * exp(-(r - R) / H) * |v| * v, k0 -    (r = R), H -   
+    class ExponentialAtmosphereDrag {
+    public:
+        explicit ExponentialAtmosphereDrag(const SimulationParameters& params)
+            : m_surfaceDrag(params.perturbations.atmosphereDrag),
+            m_radius(params.CENTRAL_BODY_RADIUS),
+            m_inverseScaleHeight(1.0 / params.perturbations.atmosphereScaleHeight) {
+        }
+
+        static bool isActive(const SimulationParameters& params) {
+            return params.perturbations.atmosphereDrag != 0.0 && params.perturbations.atmosphereScaleHeight > 0.0;
+        }
+
+        FORCE_MODEL_INLINE void accumulate(const State& s, const Position& p, double& ax, double& ay) const {
+            double speed = std::sqrt(s.vx * s.vx + s.vy * s.vy);
+            double factor = -m_surfaceDrag * std::exp((m_radius - p.r) * m_inverseScaleHeight) * speed;
+            ax += factor * s.vx;
+            ay += factor * s.vy;
+        }
+
+    private:
+        double m_surfaceDrag;
+        double m_radius;
+        double m_inverseScaleHeight;
+    };
+
+    //       ( thrustAngle   x)
+    class ConstantDirectionThrust {
+    public:
+        explicit ConstantDirectionThrust(const SimulationParameters& params)
+            : m_ax(params.perturbations.thrustAcceleration * std::cos(params.perturbations.thrustAngle)),
+            m_ay(params.perturbations.thrustAcceleration * std::sin(params.perturbations.thrustAngle)) {
+        }
+
+        static bool isActive(const SimulationParameters& params) { return params.perturbations.thrustAcceleration != 0.0; }
+
+        FORCE_MODEL_INLINE void accumulate(const State&, const Position&, double& ax, double& ay) const {
+            ax += m_ax;
+            ay += m_ay;
+        }
+
+    private:
+        double m_ax;
+        double m_ay;
+    };
+
+    //     .    (r = 0)  
+    template <typename... Terms>
+    class Composite {
+    public:
+        explicit Composite(const SimulationParameters& params)
+            : m_terms(Terms(params)...) {
+        }
+
+        FORCE_MODEL_INLINE State operator()(const State& s) const {
+            double r_squared = s.x * s.x + s.y * s.y;
+            if (r_squared == 0) {
+                return { s.vx, s.vy, 0, 0 };
+            }
+            const Position p{ r_squared, std::sqrt(r_squared) };
+            // -0.0 -    (0.0 + -0.0   +0.0),  
+            //          ,   Composite
+            double ax = -0.0;
+            double ay = -0.0;
+            accumulateTerms(s, p, ax, ay, std::index_sequence_for<Terms...>());
+            return { s.vx, s.vy, ax, ay };
+        }
+
+    private:
+        template <size_t... Indices>
+        FORCE_MODEL_INLINE void accumulateTerms(const State& s, const Position& p, double& ax, double& ay, std::index_sequence<Indices...>) const {
+            (std::get<Indices>(m_terms).accumulate(s, p, ax, ay), ...);
+        }
+
+        std::tuple<Terms...> m_terms;
+    };
+
+    //   .      Calculations::derivatives
+    using GravityOnly = Composite<CentralGravity>;
+    using GravityWithDrag = Composite<CentralGravity, LinearDrag>;
+    using GravityDragThrust = Composite<CentralGravity, LinearDragThrust>;
+
+    template <typename... Terms>
+    struct TermList {};
+
+    // ,  dispatchForceModel   ;    
+    using Perturbations = TermList<J2Oblateness, ExponentialAtmosphereDrag, ConstantDirectionThrust>;
+
+    //  Perturbations:      Chosen
+    template <typename... Chosen, typename Visitor>
+    void visitActiveTerms(const SimulationParameters& params, TermList<Chosen...>, TermList<>, Visitor& visit) {
+        visit(Composite<Chosen...>(params));
+    }
+
+    template <typename... Chosen, typename Next, typename... Rest, typename Visitor>
+    void visitActiveTerms(const SimulationParameters& params, TermList<Chosen...>, TermList<Next, Rest...>, Visitor& visit) {
+        if (Next::isActive(params)) visitActiveTerms(params, TermList<Chosen..., Next>(), TermList<Rest...>(), visit);
+        else visitActiveTerms(params, TermList<Chosen...>(), TermList<Rest...>(), visit);
+    }
+
+} // namespace ForceModel
+
+//  visit(force)    ,   : ,
+//    k  F (  )   .
+// visit   :       
+template <typename Visitor>
+void dispatchForceModel(const SimulationParameters& params, Visitor&& visit) {
+    using namespace ForceModel;
+    if (params.THRUST_COEFFICIENT - params.DRAG_COEFFICIENT == 0.0) {
+        visitActiveTerms(params, TermList<CentralGravity>(), Perturbations(), visit);
+    }
+    else if (params.THRUST_COEFFICIENT == 0.0) {
+        visitActiveTerms(params, TermList<CentralGravity, LinearDrag>(), Perturbations(), visit);
+    }
+    else {
+        visitActiveTerms(params, TermList<CentralGravity, LinearDragThrust>(), Perturbations(), visit);
+    }
+}
+
+#endif // FORCEMODELS_H
@@ -0,0 +1,109 @@
+#pragma once
+#ifndef MONTECARLOENSEMBLE_H
+#define MONTECARLOENSEMBLE_H
+
+#include "../include/Calculations.h"
+#include "../include/WorkStealingPool.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+//     :    
+// ,     
+struct EnsembleDispersion {
+    double velocitySigma = 0.0; //   vy
+    double positionSigma = 0.0; //  ,  x   y 
+    double dragSigma = 0.0;     // DRAG_COEFFICIENT;    
+};
+
+struct EnsembleSettings {
+    size_t runs = 1000;
+    std::uint64_t seed = 1;
+    size_t sampleCount = 200;  //       (  0..STEPS)
+    size_t histogramBins = 40; //       0..STEPS * DT
+};
+
+// ,        :   ,
+//       ,    
+class RunningCovariance2D {
+public:
+    void add(double x, double y) {
+        ++m_count;
+        const double n = static_cast<double>(m_count);
+        const double dx = x - m_meanX;
+        const double dy = y - m_meanY;
+        m_meanX += dx / n;
+        m_meanY += dy / n;
+        m_m2X += dx * (x - m_meanX);
+        m_m2Y += dy * (y - m_meanY);
+        m_cXY += dx * (y - m_meanY);
+    }
+
+    //      ( )
+    void merge(const RunningCovariance2D& other);
+
+    size_t count() const { return m_count; }
+    double meanX() const { return m_meanX; }
+    double meanY() const { return m_meanY; }
+    //   (  n - 1); 0,    
+    double varianceX() const { return (m_count > 1) ? m_m2X / static_cast<double>(m_count - 1) : 0.0; }
+    double varianceY() const { return (m_count > 1) ? m_m2Y / static_cast<double>(m_count - 1) : 0.0; }
+    double covarianceXY() const { return (m_count > 1) ? m_cXY / static_cast<double>(m_count - 1) : 0.0; }
+
+private:
+    size_t m_count = 0;
+    double m_meanX = 0.0, m_meanY = 0.0;
+    double m_m2X = 0.0, m_m2Y = 0.0, m_cXY = 0.0;
+};
+
+//     time  ,       
+struct EnsembleTimeSample {
+    double time = 0.0;
+    size_t count = 0;
+    double meanX = 0.0, meanY = 0.0;
+    double varianceX = 0.0, varianceY = 0.0, covarianceXY = 0.0;
+};
+
+struct EnsembleResult {
+    size_t runs = 0;               //   (   )
+    size_t impacts = 0;
+    double impactProbability = 0.0;
+    double meanImpactTime = 0.0;   //   ,  
+    double impactTimeStdDev = 0.0;
+    double histogramBinWidth = 0.0;
+    std::vector<size_t> impactTimeHistogram;
+    std::vector<EnsembleTimeSample> samples;
+};
+
+//  -  Calculations:     V0, 
+//   k,    ,   .
+//      RUNS_PER_TASK;       
+// (,  seed   )   ,   
+//    .     seed,     
+//  ,     .
+class MonteCarloEnsemble {
+public:
+    static constexpr size_t RUNS_PER_TASK = 32;
+
+    // threadCount == 0:    
+    explicit MonteCarloEnsemble(unsigned threadCount = 0);
+
+    // control (): completedSteps   ,   
+    EnsembleResult run(const SimulationParameters& nominal, const EnsembleDispersion& dispersion,
+        const EnsembleSettings& settings, SimulationControl* control = nullptr);
+
+    //      
+    static SimulationParameters samplePerturbed(const SimulationParameters& nominal, const EnsembleDispersion& dispersion,
+        std::mt19937_64& generator);
+
+    //   task:       task * RUNS_PER_TASK  
+    static std::mt19937_64 makeTaskGenerator(std::uint64_t seed, size_t task);
+
+    unsigned getThreadCount() const { return m_pool.getThreadCount(); }
+
+private:
+    WorkStealingPool m_pool;
+};
+
+#endif // MONTECARLOENSEMBLE_H
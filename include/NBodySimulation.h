@@ -0,0 +1,159 @@
+#pragma once
+#ifndef NBODYSIMULATION_H
+#define NBODYSIMULATION_H
+
+#include "../include/Calculations.h"     //  State  SimulationControl
+#include "../include/TrajectoryLod.h"    // WorldTrajectoryData   
+#include "../include/WorkStealingPool.h"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+//   N .  ,    ;
+//    -      .
+struct NBodyParameters {
+    double G = 1.0;
+    double DT = 0.001;
+    int STEPS = 1000;
+    int outputInterval = 1;          //  (  )  outputInterval     
+    double theta = 0.5;              //    s   d     s < theta * d
+    double softening = 1e-3;         // eps:  ~ r / (r^2 + eps^2)^(3/2),     
+    size_t directSumThreshold = 64;  //    -   O(N^2):     
+};
+
+//    :      
+struct NBodySystem {
+    std::vector<double> x, y, vx, vy;
+    std::vector<double> mass; // 0 -  : ,    
+
+    size_t size() const { return mass.size(); }
+    void addBody(double bodyMass, const State& state);
+    State getState(size_t body) const { return { x[body], y[body], vx[body], vy[body] }; }
+};
+
+//    N  ( TrajectorySink)
+class NBodyFrameSink {
+public:
+    virtual ~NBodyFrameSink() = default;
+
+    //      
+    virtual void begin(const NBodyParameters& params, const NBodySystem& system) { (void)params; (void)system; }
+
+    //      step ( step * DT);     step
+    virtual void consumeFrame(size_t step, const NBodySystem& system) = 0;
+
+    //       (    )
+    virtual void end() {}
+};
+
+//       : getTracks()[body][frame]
+class NBodyTrackSink : public NBodyFrameSink {
+public:
+    void begin(const NBodyParameters& params, const NBodySystem& system) override;
+    void consumeFrame(size_t step, const NBodySystem& system) override;
+
+    std::vector<WorldTrajectoryData>& getTracks() { return m_tracks; }
+    size_t getFrameCount() const { return m_tracks.empty() ? 0 : m_tracks[0].size(); }
+
+private:
+    std::vector<WorldTrajectoryData> m_tracks;
+};
+
+//    CSV:     
+//   Step_Index, Body, x_dimless, y_dimless, vx_dimless, vy_dimless
+class NBodyCsvSink : public NBodyFrameSink {
+public:
+    explicit NBodyCsvSink(const std::string& path);
+    //      (, std::cout);   
+    explicit NBodyCsvSink(std::ostream& out);
+
+    bool hasFailed() const { return m_failed; }
+
+    void begin(const NBodyParameters& params, const NBodySystem& system) override;
+    void consumeFrame(size_t step, const NBodySystem& system) override;
+    void end() override;
+
+private:
+    void flushBuffer();
+
+    std::ofstream m_file;
+    std::ostream* m_out;
+    std::vector<char> m_buffer;
+    size_t m_used;
+    bool m_failed;
+};
+
+struct NBodyStats {
+    size_t forceEvaluations = 0; //    
+    size_t treeNodes = 0;        //      (0 -  )
+};
+
+//  N    .
+// :     directSumThreshold -    ,  
+// - (O(N log N)):       .  
+//     BODIES_PER_TASK   ,  
+//     .  - "--" ( ),
+//     .
+class NBodySimulation {
+public:
+    static constexpr size_t BODIES_PER_TASK = 256;
+    static constexpr unsigned LEAF_CAPACITY = 8;  //     ( )
+    static constexpr unsigned MAX_TREE_DEPTH = 48; //  -      ( )
+
+    // threadCount == 0:    
+    explicit NBodySimulation(unsigned threadCount = 0);
+
+    //  params.STEPS ; system   .   -  .
+    // control (): completedSteps -  ,     .
+    // false -    validate() (  std::cerr)
+    bool run(const NBodyParameters& params, NBodySystem& system, NBodyFrameSink& sink, SimulationControl* control = nullptr);
+
+    //   :      directSumThreshold
+    void computeAccelerations(const NBodyParameters& params, const NBodySystem& system, std::vector<double>& ax, std::vector<double>& ay);
+    //    O(N^2) (    )
+    void computeAccelerationsDirect(const NBodyParameters& params, const NBodySystem& system, std::vector<double>& ax, std::vector<double>& ay);
+
+    //      -G * mi * mj / sqrt(r^2 + eps^2);   O(N^2)
+    double computeEnergy(const NBodyParameters& params, const NBodySystem& system);
+
+    const NBodyStats& getLastStats() const { return m_stats; }
+    unsigned getThreadCount() const { return m_pool.getThreadCount(); }
+
+    static bool validate(const NBodyParameters& params);
+
+    //  : count   particleMass     centralBody,
+    //     innerRadius..outerRadius (   seed)
+    static void addDebrisRing(NBodySystem& system, double G, size_t centralBody, size_t count,
+        double innerRadius, double outerRadius, double particleMass, std::uint32_t seed);
+
+    //    "=" (  data/nbody_debris.txt):
+    // G, dt, steps, output_every, theta, softening, direct_threshold,
+    // body=m x y vx vy (), ring=count inner outer mass [seed] (   )
+    static bool loadScenario(const std::string& path, NBodyParameters& params, NBodySystem& system);
+
+private:
+    //  .  ( )    firstChild;   -
+    //  [first, first + count)  m_order    
+    struct TreeNode {
+        double centerX, centerY, halfSize;
+        double mass, massX, massY; //    
+        std::uint32_t first, count;
+        std::int32_t firstChild;   // -1  
+        std::uint32_t childCount;
+    };
+
+    void buildTree(const NBodySystem& system);
+    void buildNode(const NBodySystem& system, std::uint32_t nodeIndex, unsigned depth);
+    void accumulateTreeForce(size_t sortedIndex, double G, double theta, double softeningSquared, double& ax, double& ay) const;
+
+    WorkStealingPool m_pool;
+    std::vector<TreeNode> m_nodes;
+    std::vector<std::uint32_t> m_order;  //     :    
+    std::vector<double> m_sortedX, m_sortedY, m_sortedMass;
+    std::vector<double> m_ax, m_ay;
+    NBodyStats m_stats;
+};
+
+#endif // NBODYSIMULATION_H
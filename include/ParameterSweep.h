@@ -0,0 +1,68 @@
+#pragma once
+#ifndef PARAMETERSWEEP_H
+#define PARAMETERSWEEP_H
+
+#include "../include/Calculations.h"
+#include "../include/TrajectorySink.h"
+#include "../include/WorkStealingPool.h"
+
+#include <vector>
+
+//     (   )
+struct SweepRunSummary {
+    size_t runIndex = 0;
+    size_t pointCount = 0;       //   ,  
+    long long impactStep = -1;   //     -1
+    double finalR = 0.0;
+    double minR = 0.0;
+    double maxR = 0.0;
+    double initialEnergy = 0.0;  //     
+    double finalEnergy = 0.0;
+    double energyDrift = 0.0;    // |E - E0| / |E0|   
+};
+
+// ,      
+class SummarySink : public TrajectorySink {
+public:
+    void begin(const SimulationParameters& params) override;
+    void consume(size_t firstIndex, const State* states, size_t count) override;
+    void end() override;
+
+    const SweepRunSummary& getSummary() const { return m_summary; }
+
+private:
+    SimulationParameters m_params;
+    SweepRunSummary m_summary;
+    State m_lastState;
+};
+
+//         
+class ParameterSweep {
+public:
+    // threadCount == 0:    
+    explicit ParameterSweep(unsigned threadCount = 0);
+
+    //     ,   runs.
+    // control (): completedSteps   ,   .
+    std::vector<SweepRunSummary> run(const std::vector<SimulationParameters>& runs, SimulationControl* control = nullptr);
+
+    //  ,  run(),   RK4     DT   TrajectoryBatch
+    //  BATCH_LANES   (SIMD).     run().
+    std::vector<SweepRunSummary> runBatched(const std::vector<SimulationParameters>& runs, SimulationControl* control = nullptr);
+
+    static constexpr size_t BATCH_LANES = 64;
+
+    //    vy, DRAG_COEFFICIENT  THRUST_COEFFICIENT  base.
+    //    "   base".
+    static std::vector<SimulationParameters> makeGrid(const SimulationParameters& base,
+        const std::vector<double>& vyValues,
+        const std::vector<double>& dragValues,
+        const std::vector<double>& thrustValues);
+
+    unsigned getThreadCount() const { return m_pool.getThreadCount(); }
+
+private:
+    WorkStealingPool m_pool;
+};
+
+#endif // PARAMETERSWEEP_H
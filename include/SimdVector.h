@@ -0,0 +1,141 @@
+#pragma once
+#ifndef SIMDVECTOR_H
+#define SIMDVECTOR_H
+
+//     SIMD    (BatchIntegrator).
+//        Traits;     :
+// AVX-512 (__AVX512F__), AVX2 (__AVX2__)    ( ).
+//      (  FMA),  
+//      Calculations.
+
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace simd {
+
+    constexpr std::size_t ALIGNMENT = 64; //   AVX-512
+
+    //    ALIGNMENT    SoA
+    template <typename T>
+    struct AlignedAllocator {
+        using value_type = T;
+
+        AlignedAllocator() noexcept = default;
+        template <typename U>
+        AlignedAllocator(const AlignedAllocator<U>&) noexcept {}
+
+        T* allocate(std::size_t n) {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(ALIGNMENT)));
+        }
+        void deallocate(T* p, std::size_t) noexcept {
+            ::operator delete(p, std::align_val_t(ALIGNMENT));
+        }
+
+        template <typename U>
+        struct rebind { using other = AlignedAllocator<U>; };
+    };
+
+    template <typename T, typename U>
+    bool operator==(const AlignedAllocator<T>&, const AlignedAllocator<U>&) { return true; }
+    template <typename T, typename U>
+    bool operator!=(const AlignedAllocator<T>&, const AlignedAllocator<U>&) { return false; }
+
+    using AlignedDoubles = std::vector<double, AlignedAllocator<double>>;
+
+    // ---   (1 ) ---
+    struct ScalarTraits {
+        using Vec = double;
+        using Mask = bool;
+        static constexpr std::size_t WIDTH = 1;
+        static constexpr const char* NAME = "scalar";
+
+        static Vec load(const double* p) { return *p; }
+        static void store(double* p, Vec v) { *p = v; }
+        static Vec set1(double a) { return a; }
+        static Vec add(Vec a, Vec b) { return a + b; }
+        static Vec sub(Vec a, Vec b) { return a - b; }
+        static Vec mul(Vec a, Vec b) { return a * b; }
+        static Vec div(Vec a, Vec b) { return a / b; }
+        static Vec sqrt(Vec a) { return std::sqrt(a); }
+        static Vec min(Vec a, Vec b) { return a < b ? a : b; } //  minpd
+        static Vec max(Vec a, Vec b) { return a > b ? a : b; } //  maxpd
+        static Mask lt(Vec a, Vec b) { return a < b; }
+        static Mask eq(Vec a, Vec b) { return a == b; }
+        static Mask maskAnd(Mask a, Mask b) { return a && b; }
+        static Vec select(Mask m, Vec ifTrue, Vec ifFalse) { return m ? ifTrue : ifFalse; }
+        static unsigned bits(Mask m) { return m ? 1u : 0u; }
+    };
+
+#if defined(__AVX2__)
+    // --- AVX2 (4  double) ---
+    struct Avx2Traits {
+        using Vec = __m256d;
+        using Mask = __m256d;
+        static constexpr std::size_t WIDTH = 4;
+        static constexpr const char* NAME = "AVX2";
+
+        static Vec load(const double* p) { return _mm256_load_pd(p); }
+        static void store(double* p, Vec v) { _mm256_store_pd(p, v); }
+        static Vec set1(double a) { return _mm256_set1_pd(a); }
+        static Vec add(Vec a, Vec b) { return _mm256_add_pd(a, b); }
+        static Vec sub(Vec a, Vec b) { return _mm256_sub_pd(a, b); }
+        static Vec mul(Vec a, Vec b) { return _mm256_mul_pd(a, b); }
+        static Vec div(Vec a, Vec b) { return _mm256_div_pd(a, b); }
+        static Vec sqrt(Vec a) { return _mm256_sqrt_pd(a); }
+        static Vec min(Vec a, Vec b) { return _mm256_min_pd(a, b); }
+        static Vec max(Vec a, Vec b) { return _mm256_max_pd(a, b); }
+        static Mask lt(Vec a, Vec b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+        static Mask eq(Vec a, Vec b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+        static Mask maskAnd(Mask a, Mask b) { return _mm256_and_pd(a, b); }
+        static Vec select(Mask m, Vec ifTrue, Vec ifFalse) { return _mm256_blendv_pd(ifFalse, ifTrue, m); }
+        static unsigned bits(Mask m) { return static_cast<unsigned>(_mm256_movemask_pd(m)); }
+    };
+#endif
+
+#if defined(__AVX512F__)
+    // --- AVX-512 (8  double) ---
+    struct Avx512Traits {
+        using Vec = __m512d;
+        using Mask = __mmask8;
+        static constexpr std::size_t WIDTH = 8;
+        static constexpr const char* NAME = "AVX-512";
+
+        static Vec load(const double* p) { return _mm512_load_pd(p); }
+        static void store(double* p, Vec v) { _mm512_store_pd(p, v); }
+        static Vec set1(double a) { return _mm512_set1_pd(a); }
+        static Vec add(Vec a, Vec b) { return _mm512_add_pd(a, b); }
+        static Vec sub(Vec a, Vec b) { return _mm512_sub_pd(a, b); }
+        static Vec mul(Vec a, Vec b) { return _mm512_mul_pd(a, b); }
+        static Vec div(Vec a, Vec b) { return _mm512_div_pd(a, b); }
+        static Vec sqrt(Vec a) { return _mm512_sqrt_pd(a); }
+        static Vec min(Vec a, Vec b) { return _mm512_min_pd(a, b); }
+        static Vec max(Vec a, Vec b) { return _mm512_max_pd(a, b); }
+        static Mask lt(Vec a, Vec b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+        static Mask eq(Vec a, Vec b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+        static Mask maskAnd(Mask a, Mask b) { return static_cast<Mask>(a & b); }
+        static Vec select(Mask m, Vec ifTrue, Vec ifFalse) { return _mm512_mask_blend_pd(m, ifFalse, ifTrue); }
+        static unsigned bits(Mask m) { return static_cast<unsigned>(m); }
+    };
+#endif
+
+#if defined(__AVX512F__)
+    using NativeTraits = Avx512Traits;
+#elif defined(__AVX2__)
+    using NativeTraits = Avx2Traits;
+#else
+    using NativeTraits = ScalarTraits;
+#endif
+
+    // ,     SoA (  )
+    constexpr std::size_t MAX_WIDTH = 8;
+
+} // namespace simd
+
+#endif // SIMDVECTOR_H
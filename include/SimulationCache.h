@@ -0,0 +1,97 @@
+#pragma once
+#ifndef SIMULATIONCACHE_H
+#define SIMULATIONCACHE_H
+
+#include "../include/Calculations.h"
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//   :        .
+//  - 64- FNV-1a    SimulationParameters  INTEGRATOR_VERSION;
+//      ,      .
+//  ,       (LRU)   :
+//   -   (memoryLimitBytes);
+//   -  ,  *.trjb  diskDirectory (diskLimitBytes).   -
+//       ,    .  diskDirectory -  .
+//      shared_ptr       .
+//      .
+class SimulationCache {
+public:
+    //       :
+    //        
+    static constexpr std::uint32_t INTEGRATOR_VERSION = 1;
+
+    static constexpr size_t DEFAULT_MEMORY_LIMIT_BYTES = size_t(256) << 20;          // 256 
+    static constexpr std::uintmax_t DEFAULT_DISK_LIMIT_BYTES = std::uintmax_t(1) << 30; // 1 
+
+    explicit SimulationCache(const std::string& diskDirectory = "",
+        size_t memoryLimitBytes = DEFAULT_MEMORY_LIMIT_BYTES,
+        std::uintmax_t diskLimitBytes = DEFAULT_DISK_LIMIT_BYTES);
+
+    //  :  ,   ,   
+    //  little-endian; -0.0   0.0,    -   DormandPrince45,
+    //  -   -   
+    static std::vector<unsigned char> serializeParameters(const SimulationParameters& params);
+    static std::uint64_t makeKey(const SimulationParameters& params);
+
+    using StatesPtr = std::shared_ptr<const std::vector<State>>;
+
+    //  true,        ; states     
+    bool find(const SimulationParameters& params, StatesPtr& states);
+    //        (Calculations::sameModel)   STEPS,
+    //      :      .
+    //   RK4 -       .   .
+    //     prefixPath (*.trjb), from -      :
+    //        BinaryTrajectorySink(prefixPath, ..., from).
+    bool findExtendable(const SimulationParameters& params, const std::string& prefixPath, SimulationCheckpoint& from);
+    //    ( )    
+    void store(const SimulationParameters& params, StatesPtr states);
+
+    //     ,     params     
+    // (BinaryTrajectorySink),      .   -    .
+    std::string getTemporaryPath(const SimulationParameters& params);
+    //    getTemporaryPath(params)     (   ) 
+    //    ,   -  .       .
+    std::string storeFile(const SimulationParameters& params, const std::string& temporaryPath);
+
+    void clearMemory();
+
+    unsigned getHitCount() const { return m_hits; }
+    unsigned getMissCount() const { return m_misses; }
+    size_t getMemoryBytes() const { return m_memoryBytes; }
+
+private:
+    struct Entry {
+        std::uint64_t key = 0;
+        SimulationParameters params;
+        std::vector<unsigned char> canonical; //    
+        StatesPtr states;
+    };
+    using EntryList = std::list<Entry>; //  -  
+
+    std::string getDiskPath(std::uint64_t key) const;
+    bool findInMemory(std::uint64_t key, const std::vector<unsigned char>& canonical, StatesPtr& states);
+    bool loadFromDisk(std::uint64_t key, const std::vector<unsigned char>& canonical, StatesPtr& states);
+    void storeInMemory(std::uint64_t key, const SimulationParameters& params, std::vector<unsigned char> canonical, StatesPtr states);
+    void storeOnDisk(std::uint64_t key, const SimulationParameters& params, const std::vector<State>& states);
+    std::string moveIntoCache(std::uint64_t key, const std::string& temporaryPath);
+    void evictDisk(const std::string& keepPath);
+
+    std::string m_diskDirectory;
+    size_t m_memoryLimitBytes;
+    std::uintmax_t m_diskLimitBytes;
+
+    EntryList m_entries;
+    std::unordered_map<std::uint64_t, EntryList::iterator> m_index;
+    size_t m_memoryBytes = 0;
+
+    unsigned m_hits = 0;
+    unsigned m_misses = 0;
+};
+
+#endif // SIMULATIONCACHE_H
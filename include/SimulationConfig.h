@@ -0,0 +1,106 @@
+#pragma once
+#ifndef SIMULATIONCONFIG_H
+#define SIMULATIONCONFIG_H
+
+#include "../include/Calculations.h"
+#include "../include/MonteCarloEnsemble.h" //  EnsembleDispersion  EnsembleSettings
+
+#include <string>
+
+//     ,       (=)
+struct ParameterStrings {
+    std::string m_satellite_kg;
+    std::string M_central_body_factor;
+    std::string V0_m_per_s;
+    std::string T_days;
+    std::string k_coeff;
+    std::string F_coeff;
+    std::string integrator; //  : "rk4" ( ), "dp45", "verlet"  "yoshida4"
+    std::string dt;         //  :   DT (   Calculations.h)
+    //    (SimulationParameters::PerturbationParams),  - 
+    std::string j2;
+    std::string atmosphere_drag;
+    std::string atmosphere_scale_height;
+    std::string thrust_accel;
+    std::string thrust_angle_deg;
+    //    - (EnsembleDispersion, EnsembleSettings),  -  
+    std::string mc_runs;
+    std::string mc_seed;
+    std::string mc_v0_sigma_m_per_s;
+    std::string mc_position_sigma;
+    std::string mc_k_sigma;
+};
+
+//   
+struct InputParameters {
+    double m_satellite_kg = 0.0;
+    double M_central_body_factor = 0.0;
+    double V0_m_per_s = 0.0;
+    double T_days = 0.0;
+    double k_coeff = 0.0;
+    double F_coeff = 0.0;
+    IntegratorType integrator = IntegratorType::RK4;
+    double dt = 0.0; // 0 -   
+    double j2 = 0.0;
+    double atmosphere_drag = 0.0;
+    double atmosphere_scale_height = 0.0;
+    double thrust_accel = 0.0;
+    double thrust_angle_deg = 0.0;
+    double mc_runs = 0.0;   // 0 - DEFAULT_ENSEMBLE_RUNS
+    double mc_seed = 1.0;
+    double mc_v0_sigma_m_per_s = -1.0; //   -   
+    double mc_position_sigma = -1.0;
+    double mc_k_sigma = -1.0;
+    bool isValid = true;
+    std::wstring errorMessage;
+};
+
+//  simulation_params.txt,       .
+//    SFML/TGUI:    ,   .
+class SimulationConfig {
+public:
+    static constexpr double G_SI = 6.67430e-11;
+    static constexpr double REFERENCE_PHYSICAL_LENGTH_FOR_X_1_5 = 1.495978707e11; // 1 .., 
+    static constexpr double SECONDS_PER_DAY = 24.0 * 60.0 * 60.0;
+    static constexpr double CENTRAL_MASS_MULTIPLIER = 1.0e25; // M      1e25 
+    static constexpr double MIN_DT = 1e-5; //   dt;   T / dt   (  INT_MAX)
+    static constexpr double MAX_DT = 0.1;
+    static constexpr double MAX_J2 = 1.0;               //    ()
+    static constexpr double MAX_ATMOSPHERE_DRAG = 1.0e3;
+    static constexpr double MAX_THRUST_ACCELERATION = 1.0;
+    static constexpr double MAX_ENSEMBLE_RUNS = 1.0e6;
+    //  ,   mc_*  
+    static constexpr size_t DEFAULT_ENSEMBLE_RUNS = 1000;
+    static constexpr double DEFAULT_V0_SIGMA_M_PER_S = 2.0;
+    static constexpr double DEFAULT_POSITION_SIGMA = 0.01;
+    static constexpr double DEFAULT_K_SIGMA = 0.005;
+
+    //   =.   ,   .
+    static bool loadParameterFile(const std::string& path, ParameterStrings& values);
+    static bool saveParameterFile(const std::string& path, const ParameterStrings& values);
+
+    //       ("0,05"  "0.05"),    .
+    //   (   )   .
+    static bool parseDecimal(const std::string& text, double& value);
+
+    static InputParameters validate(const ParameterStrings& values);
+
+    //   integrator   ("rk4", "dp45", "verlet", "yoshida4")
+    static const char* getIntegratorKey(IntegratorType integrator);
+
+    // :  - ,    x = 1.5  1 ..,
+    //  - M  ,  -   G = 1.
+    // timeUnit -      .
+    static bool toSimulationParameters(const InputParameters& input, SimulationParameters& params, double& timeUnit);
+
+    //  mc_*       ( V0   /)
+    static bool toEnsembleSettings(const InputParameters& input, EnsembleDispersion& dispersion, EnsembleSettings& settings);
+
+private:
+    // lengthUnit ()  timeUnit ()  
+    static bool getUnits(const InputParameters& input, double& lengthUnit, double& timeUnit);
+    //   T / DT  double:   M   dt      int
+    static double getStepCount(const InputParameters& input, double timeUnit);
+};
+
+#endif // SIMULATIONCONFIG_H
@@ -0,0 +1,69 @@
+#pragma once
+#ifndef SIMULATIONJOB_H
+#define SIMULATIONJOB_H
+
+#include "../include/Calculations.h"
+#include "../include/TrajectorySink.h"
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+
+//   Calculations::runSimulation,     .
+//      ;      .
+class SimulationJob {
+public:
+    enum class Status {
+        Idle,      //       
+        Running,   //  
+        Finished,  //  ,     takeResult
+        Cancelled  //   ,  
+    };
+
+    SimulationJob();
+    ~SimulationJob(); //      
+
+    SimulationJob(const SimulationJob&) = delete;
+    SimulationJob& operator=(const SimulationJob&) = delete;
+
+    //   .    .
+    //     sinks   ;
+    //          Finished.
+    void start(const SimulationParameters& params, std::vector<std::shared_ptr<TrajectorySink>> sinks);
+    //  ,       (Calculations::resumeSimulation):
+    //      from.stepIndex
+    void resume(const SimulationParameters& params, const SimulationCheckpoint& from, std::vector<std::shared_ptr<TrajectorySink>> sinks);
+
+    //       
+    void cancel();
+
+    Status getStatus() const { return m_status.load(std::memory_order_acquire); }
+    bool isRunning() const { return getStatus() == Status::Running; }
+
+    //      [0, 1]
+    double getProgress() const;
+
+    //    
+    const SimulationParameters& getParameters() const { return m_params; }
+
+    //   ,    Idle   true.
+    //    ,   start().
+    bool acknowledgeFinished();
+
+private:
+    void cancelAndJoin();
+    void launch(const SimulationParameters& params, std::vector<std::shared_ptr<TrajectorySink>> sinks);
+    void workerMain();
+
+    std::thread m_worker;
+    SimulationControl m_control;
+    std::atomic<Status> m_status;
+    SimulationParameters m_params;
+    bool m_resume = false;
+    SimulationCheckpoint m_resumeFrom;
+
+    FanOutSink m_sinks;
+};
+
+#endif // SIMULATIONJOB_H
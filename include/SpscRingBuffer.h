@@ -0,0 +1,76 @@
+#pragma once
+#ifndef SPSCRINGBUFFER_H
+#define SPSCRINGBUFFER_H
+
+//          .
+// push     , pop -   ;    :
+// push   ,  , pop   .
+//      ,    -  & ( - 1).
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+template <typename T>
+class SpscRingBuffer {
+public:
+    //      
+    explicit SpscRingBuffer(size_t minCapacity)
+        : m_items(roundUpToPowerOfTwo(minCapacity)),
+        m_mask(m_items.size() - 1) {
+    }
+
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    size_t capacity() const { return m_items.size(); }
+
+    //  .     ( count,   )
+    size_t push(const T* items, size_t count) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead + count > m_items.size()) {
+            m_cachedHead = m_head.load(std::memory_order_acquire); // ,     
+        }
+        const size_t written = std::min(count, m_items.size() - (tail - m_cachedHead));
+        for (size_t i = 0; i < written; ++i) {
+            m_items[(tail + i) & m_mask] = items[i];
+        }
+        m_tail.store(tail + written, std::memory_order_release);
+        return written;
+    }
+
+    //  .    
+    size_t pop(T* out, size_t maxCount) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (m_cachedTail - head < maxCount) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+        }
+        const size_t available = std::min(maxCount, m_cachedTail - head);
+        for (size_t i = 0; i < available; ++i) {
+            out[i] = m_items[(head + i) & m_mask];
+        }
+        m_head.store(head + available, std::memory_order_release);
+        return available;
+    }
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    static size_t roundUpToPowerOfTwo(size_t value) {
+        size_t result = 1;
+        while (result < value) result <<= 1;
+        return result;
+    }
+
+    std::vector<T> m_items;
+    size_t m_mask;
+
+    //        ,      
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_tail{ 0 }; //  
+    size_t m_cachedHead = 0;                                  //  m_head  
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_head{ 0 }; //  
+    size_t m_cachedTail = 0;                                  //  m_tail  
+};
+
+#endif // SPSCRINGBUFFER_H
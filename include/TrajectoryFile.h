@@ -0,0 +1,147 @@
+#pragma once
+#ifndef TRAJECTORYFILE_H
+#define TRAJECTORYFILE_H
+
+#include "../include/Calculations.h"
+#include "../include/TrajectorySink.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+//    (*.trjb),   little-endian:
+//   [0, 256)  :  "TRAJBIN\0", ,  ,  ,
+//             DT,     (0 - )  SimulationParameters
+//             ( -   ,       );
+//   [256, ...)  : x, y, vx, vy (double) -   State.
+//     64 ,     
+//    State  .
+namespace TrajectoryFile {
+    constexpr char MAGIC[8] = { 'T', 'R', 'A', 'J', 'B', 'I', 'N', '\0' };
+    constexpr std::uint32_t VERSION = 1;
+    constexpr std::size_t HEADER_SIZE = 256;
+    constexpr const char* EXTENSION = ".trjb";
+
+    //      EXTENSION
+    bool hasBinaryExtension(const std::string& path);
+
+    //   :      CHECKPOINT_MAGIC,    -
+    //  ,       (x, y, vx, vy).
+    //       ,      .
+    constexpr char CHECKPOINT_MAGIC[8] = { 'T', 'R', 'A', 'J', 'C', 'K', 'P', '\0' };
+    bool saveCheckpoint(const std::string& path, const SimulationCheckpoint& checkpoint);
+    bool loadCheckpoint(const std::string& path, SimulationCheckpoint& checkpoint);
+}
+
+static_assert(sizeof(State) == 4 * sizeof(double), "State must be four packed doubles for the binary trajectory format");
+
+//        ;       end(),
+//      
+class BinaryTrajectorySink : public TrajectorySink {
+public:
+    // timeUnitSeconds -     (   )
+    explicit BinaryTrajectorySink(const std::string& path, double timeUnitSeconds = 0.0);
+    //    *.trjb   :      
+    // (Calculations::sameModel),    resumeFrom.stepIndex -   resumeFrom.state .
+    //       (,   );    
+    //  hasFailed() == true. begin()  .
+    BinaryTrajectorySink(const std::string& path, double timeUnitSeconds, const SimulationCheckpoint& resumeFrom);
+
+    bool isOpen() const { return m_file.is_open(); }
+    bool hasFailed() const { return m_failed; }
+
+    // ,       (fsync / FlushFileBuffers), -
+    //    .      std::cerr   false.
+    bool flush();
+
+    void begin(const SimulationParameters& params) override;
+    void consume(size_t firstIndex, const State* states, size_t count) override;
+    void end() override;
+
+private:
+    std::filesystem::path m_path;
+    std::fstream m_file;
+    double m_timeUnitSeconds;
+    std::uint64_t m_keepCount;
+    std::uint64_t m_count;
+    bool m_failed;
+    std::vector<double> m_swapBuffer; //   big-endian 
+};
+
+//    (  ,     )
+//  intervalPoints    end(). dataFile,  ,      ,
+//         (   ,  
+//    hasFailed() == true);       FanOutSink.
+class CheckpointSink : public TrajectorySink {
+public:
+    CheckpointSink(const std::string& path, size_t intervalPoints, BinaryTrajectorySink* dataFile = nullptr);
+
+    bool hasFailed() const { return m_failed; }
+    size_t getWrittenCount() const { return m_writtenCount; }
+
+    void begin(const SimulationParameters& params) override;
+    void consume(size_t firstIndex, const State* states, size_t count) override;
+    void end() override;
+
+private:
+    void write();
+
+    std::string m_path;
+    size_t m_intervalPoints;
+    BinaryTrajectorySink* m_dataFile;
+    SimulationCheckpoint m_checkpoint;
+    bool m_hasState = false;
+    std::uint64_t m_nextWriteIndex = 0;
+    size_t m_writtenCount = 0;
+    bool m_failed = false;
+};
+
+//  *.trjb,       (mmap / MapViewOfFile).
+// data()        close()   .
+class MappedTrajectoryFile {
+public:
+    MappedTrajectoryFile() = default;
+    ~MappedTrajectoryFile();
+    MappedTrajectoryFile(const MappedTrajectoryFile&) = delete;
+    MappedTrajectoryFile& operator=(const MappedTrajectoryFile&) = delete;
+
+    // path  UTF-8.      std::cerr   false.
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return m_open; }
+    const State* data() const { return m_states; }
+    size_t size() const { return m_count; }
+
+    const SimulationParameters& getParameters() const { return m_params; }
+    double getDT() const { return m_params.DT; }
+    double getTimeUnitSeconds() const { return m_timeUnitSeconds; }
+
+private:
+    bool m_open = false;
+    void* m_mapping = nullptr;      //  
+    size_t m_mappingSize = 0;
+#ifdef _WIN32
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+#endif
+    const State* m_states = nullptr;
+    size_t m_count = 0;
+    SimulationParameters m_params;
+    double m_timeUnitSeconds = 0.0;
+    std::vector<State> m_swappedStates; //     ( big-endian)
+};
+
+//      CSV- (   ,   )
+class TrajectoryFileConverter {
+public:
+    static bool binaryToCsv(const std::string& binaryPath, const std::string& csvPath);
+
+    //  CSV   : DT    ,
+    //       Calculations.h.
+    static bool csvToBinary(const std::string& csvPath, const std::string& binaryPath);
+};
+
+#endif // TRAJECTORYFILE_H
@@ -0,0 +1,45 @@
+#pragma once
+#ifndef TRAJECTORYLOD_H
+#define TRAJECTORYLOD_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+using WorldTrajectoryPoint = std::pair<double, double>;
+using WorldTrajectoryData = std::vector<WorldTrajectoryPoint>;
+
+//      .
+//  k (k >= 1) -    k - 1:  ,  
+//     ,    ERROR_GROWTH   .
+// maxError -        (  ),
+//    scale      maxError * scale <= 0.5
+//      .     
+//       ,     .
+class TrajectoryLodPyramid {
+public:
+    static constexpr double ERROR_GROWTH = 2.0;      //    
+    static constexpr size_t MIN_LEVEL_POINTS = 256;  //   
+    static constexpr size_t MAX_LEVELS = 40;
+
+    struct Level {
+        double maxError;             //     ,  
+        std::vector<size_t> indices; //   ,  ;     
+    };
+
+    //  ;     
+    void build(const WorldTrajectoryData& points);
+
+    //      maxError <= maxWorldError; 0   
+    size_t selectLevel(double maxWorldError) const;
+
+    //  ,   ()
+    size_t getLevelCount() const { return m_levels.size() + 1; }
+    // level >= 1
+    const Level& getLevel(size_t level) const { return m_levels[level - 1]; }
+
+private:
+    std::vector<Level> m_levels;
+};
+
+#endif // TRAJECTORYLOD_H
@@ -0,0 +1,165 @@
+#pragma once
+#ifndef TRAJECTORYSINK_H
+#define TRAJECTORYSINK_H
+
+#include "../include/Calculations.h"
+#include "../include/CsvExport.h"
+#include "../include/SpscRingBuffer.h"
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <fstream>
+#include <atomic>
+
+//       .
+//   ;     index * DT.
+class TrajectorySink {
+public:
+    virtual ~TrajectorySink() = default;
+
+    //      
+    virtual void begin(const SimulationParameters& params) { (void)params; }
+
+    // states[0]   firstIndex,     
+    virtual void consume(size_t firstIndex, const State* states, size_t count) = 0;
+
+    //       (    )
+    virtual void end() {}
+};
+
+//         CHUNK_SIZE 
+class TrajectoryChunkBuffer {
+public:
+    static constexpr size_t CHUNK_SIZE = 4096;
+
+    // firstIndex -    ( 0     )
+    explicit TrajectoryChunkBuffer(TrajectorySink& sink, size_t firstIndex = 0);
+
+    void push(const State& state) {
+        m_buffer[m_count++] = state;
+        if (m_count == CHUNK_SIZE) flush();
+    }
+    void flush();
+
+    //     (    )
+    size_t emitted() const { return m_firstIndex + m_count; }
+
+private:
+    TrajectorySink& m_sink;
+    std::vector<State> m_buffer;
+    size_t m_count;
+    size_t m_firstIndex;
+};
+
+//      (  runSimulation)
+class CollectingSink : public TrajectorySink {
+public:
+    void begin(const SimulationParameters& params) override;
+    void consume(size_t firstIndex, const State* states, size_t count) override;
+
+    std::vector<State>& getStates() { return m_states; }
+
+private:
+    std::vector<State> m_states;
+};
+
+//     :      .
+//  : |E - E0| / |E0|  |L - L0| / |L0|, E0  L0 -    .
+struct ConservationReport {
+    size_t points = 0;
+    double initialEnergy = 0.0;
+    double initialAngularMomentum = 0.0;
+    double maxEnergyDrift = 0.0;
+    double finalEnergyDrift = 0.0;
+    double maxAngularMomentumDrift = 0.0;
+    double finalAngularMomentumDrift = 0.0;
+};
+
+//  ConservationReport   ,   .    
+//      (k = F = 0):    -  
+class ConservationSink : public TrajectorySink {
+public:
+    void begin(const SimulationParameters& params) override;
+    void consume(size_t firstIndex, const State* states, size_t count) override;
+
+    const ConservationReport& getReport() const { return m_report; }
+
+private:
+    SimulationParameters m_params;
+    ConservationReport m_report;
+};
+
+//         i * DT
+struct IndexedState {
+    size_t index;
+    State state;
+};
+
+//        ()  SpscRingBuffer.
+//    ,    ,      ,    .
+// consume        :      ,
+//   (getDroppedCount) -      .
+class LivePreviewSink : public TrajectorySink {
+public:
+    static constexpr size_t RING_CAPACITY = size_t(1) << 16;
+
+    explicit LivePreviewSink(size_t maxPoints);
+
+    void begin(const SimulationParameters& params) override;
+    void consume(size_t firstIndex, const State* states, size_t count) override;
+    void end() override;
+
+    //  :   maxCount    
+    size_t poll(IndexedState* out, size_t maxCount) { return m_ring.pop(out, maxCount); }
+    // end()  :       
+    bool isFinished() const { return m_finished.load(std::memory_order_acquire); }
+    size_t getDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    size_t m_maxPoints;
+    size_t m_stride;
+    SpscRingBuffer<IndexedState> m_ring;
+    std::atomic<bool> m_finished;
+    std::atomic<size_t> m_dropped;
+};
+
+//    CSV-    ,   "   ..."
+class CsvTrajectorySink : public TrajectorySink {
+public:
+    explicit CsvTrajectorySink(const std::string& path);
+    //      (, std::cout);   
+    explicit CsvTrajectorySink(std::ostream& out);
+
+    bool isOpen() const { return m_out != nullptr; }
+    bool hasFailed() const { return m_failed; }
+
+    void begin(const SimulationParameters& params) override;
+    void consume(size_t firstIndex, const State* states, size_t count) override;
+    void end() override;
+
+private:
+    std::ofstream m_file;
+    std::ostream* m_out;
+    std::unique_ptr<CsvTrajectoryWriter> m_writer;
+    double m_dt;
+    bool m_failed;
+};
+
+//     
+class FanOutSink : public TrajectorySink {
+public:
+    FanOutSink() = default;
+    explicit FanOutSink(std::vector<std::shared_ptr<TrajectorySink>> sinks);
+
+    void add(std::shared_ptr<TrajectorySink> sink);
+
+    void begin(const SimulationParameters& params) override;
+    void consume(size_t firstIndex, const State* states, size_t count) override;
+    void end() override;
+
+private:
+    std::vector<std::shared_ptr<TrajectorySink>> m_sinks;
+};
+
+#endif // TRAJECTORYSINK_H
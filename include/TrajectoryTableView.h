@@ -0,0 +1,75 @@
+#pragma once
+#ifndef TRAJECTORYTABLEVIEW_H
+#define TRAJECTORYTABLEVIEW_H
+
+#include "../include/Calculations.h" //  State
+
+#include <SFML/Graphics.hpp>
+#include <TGUI/TGUI.hpp>
+
+#include <array>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+//   :     .
+//      ;      ,
+//       .     ,
+//         (    ).
+//        (std::to_chars)  
+//  LRU-  ROW_CACHE_CAPACITY ,      .
+//  states  ,       setTrajectory.
+class TrajectoryTableView {
+public:
+    static constexpr size_t COLUMN_COUNT = 5; // h, x, y, Vx, Vy
+    static constexpr float ROW_HEIGHT = 30.f;
+    static constexpr unsigned int WHEEL_SCROLL_ROWS = 3;
+    static constexpr int CELL_PRECISION = 2;            //   
+    static constexpr size_t ROW_CACHE_CAPACITY = 4096;  //     
+
+    //           parent
+    void create(const tgui::Panel::Ptr& parent, const tgui::Layout2d& position, const tgui::Layout2d& rowsAreaSize, float scrollbarWidth);
+
+    // dt -  , timeUnitSeconds -     (  h  )
+    void setTrajectory(const State* states, size_t count, double dt, double timeUnitSeconds);
+    void clear() { setTrajectory(nullptr, 0, 0.0, 0.0); }
+
+    size_t getRowCount() const { return m_count; }
+
+    //      ; true,   
+    bool handleMouseWheel(const sf::Event& event);
+
+private:
+    static constexpr size_t NO_ROW = static_cast<size_t>(-1);
+
+    using FormattedRow = std::array<tgui::String, COLUMN_COUNT>;
+    using RowCacheList = std::list<std::pair<size_t, FormattedRow>>; //  -  
+
+    struct RowWidgets {
+        std::array<tgui::Label::Ptr, COLUMN_COUNT> cells;
+        size_t shownIndex = NO_ROW; //      (    )
+    };
+
+    void updateRowPool();
+    void refreshVisibleRows();
+    void fillRow(RowWidgets& row, size_t index);
+    const FormattedRow& getFormattedRow(size_t index);
+    void formatRow(size_t index, FormattedRow& cells);
+
+    tgui::Panel::Ptr m_rowsPanel;
+    tgui::Scrollbar::Ptr m_scrollbar;
+    tgui::Label::Ptr m_emptyLabel;
+    std::vector<RowWidgets> m_rows; //  ,   ,   
+
+    const State* m_states = nullptr;
+    size_t m_count = 0;
+    double m_dt = 0.0;
+    double m_timeUnitSeconds = 0.0;
+    size_t m_firstRow = 0;
+
+    RowCacheList m_rowCache;
+    std::unordered_map<size_t, RowCacheList::iterator> m_rowCacheIndex;
+    std::array<char, 512> m_formatBuffer; //   fixed-  double
+};
+
+#endif // TRAJECTORYTABLEVIEW_H
@@ -2,6 +2,8 @@
 #ifndef TRAJECTORYVISUALIZER_H
 #define TRAJECTORYVISUALIZER_H
 
+#include "../include/TrajectoryLod.h"
+
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <string>
@@ -11,15 +13,24 @@
 #include <sstream>  //  std::istringstream, std::ostringstream
 #include <iomanip>  //  std::fixed, std::setprecision
 #include <algorithm> //  std::min, std::max ( )
-
-using WorldTrajectoryPoint = std::pair<double, double>;
-using WorldTrajectoryData = std::vector<WorldTrajectoryPoint>;
+#include <functional> //  std::function
 
 class TrajectoryVisualizer {
 public:
     TrajectoryVisualizer(unsigned int width, unsigned int height, const std::wstring& windowTitle = L"2D- ");
 
+    //    :   ,      points
+    //   true,   .    ( false)  
+    // points  (,    ).
+    using LiveSource = std::function<bool(WorldTrajectoryData& points)>;
+
     void setData(const WorldTrajectoryData& data);
+    //  N : tracks[body][frame],      .  0  
+    //   ( ,   ),  -  
+    // ( MAX_BODY_POLYLINES )      ( )
+    void setBodyTracks(std::vector<WorldTrajectoryData>&& tracks);
+    //   setData;   ,    
+    void setLiveSource(LiveSource source) { m_liveSource = std::move(source); }
     void run();
     void resetViewAndAnimation();
 
@@ -35,13 +46,45 @@ private:
     static constexpr float CENTER_POINT_RADIUS = 5.0f;
     static constexpr float TRAJECTORY_START_POINT_RADIUS = 2.0f;
     static constexpr float ZOOM_FACTOR_STEP = 1.3f;
+    static constexpr double LOD_MAX_PIXEL_ERROR = 0.5; //    , 
+    static constexpr size_t CHUNK_VERTICES = 65536;     //      
+    //     ,      
+    //  ( ):  float      0.01 
+    static constexpr double REBASE_PIXEL_DISTANCE = 1.0e5;
+    static constexpr size_t MAX_BODY_POLYLINES = 2000; //    ;   
 
     sf::RenderWindow m_window;
     WorldTrajectoryData m_worldTrajectoryData;
-    std::vector<sf::Vertex> m_screenTrajectory;
+    TrajectoryLodPyramid m_lodPyramid;       //   setData     
+    LiveSource m_liveSource;                 //  ,      
+
+    //  N :   1..N-1 ( 0 - m_worldTrajectoryData).   float 
+    //  :     ,     
+    std::vector<WorldTrajectoryData> m_bodyTracks;
+    sf::VertexArray m_bodyLines;  //     ;    
+    size_t m_bodyLinesFrames;     //     m_bodyLines
+    sf::VertexArray m_bodyPoints; //      
+
+    //   .    float    (origin, double),
+    //      ,     .
+    //       ;   
+    //         .
+    struct TrajectoryChunk {
+        size_t firstVertex;  //     ;     
+        size_t vertexCount;
+        double originX, originY;
+        double minX, minY, maxX, maxY; //    
+        sf::VertexBuffer buffer;
+        std::vector<sf::Vertex> vertices; //  sf::VertexBuffer 
+    };
+    std::vector<std::vector<TrajectoryChunk>> m_levelChunks; // [0] -  
+    bool m_useVertexBuffers;
+    size_t m_drawnLodLevel;
+    size_t m_drawnVertexCount;
+    size_t m_rebasedChunkCount; //     ( )
 
-    float m_scale;
-    sf::Vector2f m_offset;
+    double m_scale;                    //    
+    double m_viewCenterX, m_viewCenterY; //     
     sf::Vector2f m_screenCenter;
 
     size_t m_currentPointIndex;
@@ -57,8 +100,17 @@ private:
 
     //  
     sf::Vector2f toScreenCoords(double worldX, double worldY) const;
-    sf::Vector2f toWorldCoords(sf::Vector2f screenPos) const;
-    void recalculateScreenTrajectory();
+    WorldTrajectoryPoint toWorldCoords(sf::Vector2f screenPos) const;
+    //  ,  toScreenCoords,  ,   (originX, originY)
+    sf::Transform getWorldToScreenTransform(double originX, double originY) const;
+    const WorldTrajectoryPoint& getLevelPoint(size_t level, size_t vertex) const;
+    void uploadTrajectoryVertices();
+    bool extendLevelChunks(size_t level, size_t levelVertexCount);
+    void pollLiveSource();
+    bool fillChunk(size_t level, TrajectoryChunk& chunk);
+    void drawTrajectory(size_t pointsToDraw);
+    void drawBodies(size_t framesToDraw);
+    static sf::Color getBodyColor(size_t body);
     void setupInfoText();
     void updateInfoText();
     void handleEvent(const sf::Event& event);
@@ -3,6 +3,16 @@
 #ifndef USERINTERFACE_H
 #define USERINTERFACE_H
 #include "../include/Calculations.h" //  Calculations.h    State
+#include "../include/SimulationJob.h" //   
+#include "../include/TrajectorySink.h" //    
+#include "../include/SimulationConfig.h" //  ,   
+#include "../include/TrajectoryFile.h" //    (*.trjb)
+#include "../include/CsvExport.h" //   CSV
+#include "../include/TrajectoryTableView.h" //      
+#include "../include/TrajectoryLod.h" // WorldTrajectoryData  
+#include "../include/SimulationCache.h" //     
+#include "../include/NBodySimulation.h" //  N 
+#include "../include/MonteCarloEnsemble.h" //  -
 
 #include <SFML/Graphics.hpp>
 #include <TGUI/TGUI.hpp>
@@ -14,24 +24,34 @@
 
 #include <vector>
 #include <string>
+#include <future>
 #include <iomanip>
 #include <sstream>
 
-struct TableRowData {
-    float h_days;
-    float x, y;
-    float Vx, Vy;
-};
+//         .
+//    maxVertices  (    +  ).
+class CanvasVertexSink : public TrajectorySink {
+public:
+    explicit CanvasVertexSink(size_t maxVertices, sf::Color color = sf::Color::Blue);
+
+    void begin(const SimulationParameters& params) override;
+    void consume(size_t firstIndex, const State* states, size_t count) override;
+    void end() override;
+
+    std::vector<sf::Vertex>& getVertices() { return m_vertices; }
+    //     (  ), Y    
+    sf::FloatRect getBounds() const;
 
-struct InputParameters {  
-   double m_satellite_kg = 0.0;  
-   double M_central_body_factor = 0.0;  
-   double V0_m_per_s = 0.0;  
-   double T_days = 0.0;  
-   double k_coeff = 0.0;  
-   double F_coeff = 0.0;  
-   bool isValid = true;  
-   std::wstring errorMessage;  
+private:
+    size_t m_maxVertices;
+    size_t m_stride;
+    sf::Color m_color;
+    bool m_hasLast;
+    size_t m_lastIndex;
+    State m_lastState;
+    std::vector<sf::Vertex> m_vertices;
+    bool m_hasBounds;
+    float m_minX, m_maxX, m_minY, m_maxY;
 };
 
 class UserInterface {
@@ -48,13 +68,24 @@ private:
     static constexpr float TITLE_HEIGHT = 20.f;
     static constexpr float SCROLLBAR_WIDTH_ESTIMATE = 16.f;
     const unsigned int BUTTON_TEXT_SIZE = 16;
+    static constexpr size_t MAX_CANVAS_VERTICES = 200000;
+    static constexpr float FRAME_STATS_HEIGHT = 18.f;
+
+    //  :        .
+    //      waitEvent;  ,    ,
+    //     ( )      ANIMATION_LINGER ()
+    static constexpr int IDLE_POLL_INTERVAL_MS = 15;
+    static constexpr int ANIMATION_LINGER_MS = 1500;
+    static constexpr int FRAME_STATS_INTERVAL_MS = 1000;
 
     double m_lastCalculationDT = 0.001;
+    double m_lastTimeUnit = 1.0; //   ()  ,   
 
     const std::string PARAMS_FILENAME = "data/simulation_params.txt";
     const std::string README_FILENAME = "data/README.txt";
     const std::string TEST_DATA_FILENAME = "data/test_data.txt";
     const std::string USER_SAVES_DIR = "data/user_data/"; 
+    const std::string SIMULATION_CACHE_DIR = "data/cache/";
 
     bool m_readmeNeedsInitialization = false;
 
@@ -63,6 +94,16 @@ private:
     // -    
     void onSaveParamsAsMenuItemClicked();
     void onSaveTrajectoryDataAsMenuItemClicked();
+    void onOpenTrajectoryFileMenuItemClicked();
+    bool openTrajectoryFile(const std::string& path);
+    void onOpenNBodyScenarioMenuItemClicked();
+    void startNBodySimulation(const std::string& path);
+    void updateNBodySimulation();
+    void onEnsembleMenuItemClicked();
+    void updateEnsemble();
+    void buildEnsembleOverlay(const EnsembleResult& result);
+    void clearEnsembleOverlay();
+    void drawEnsembleHistogram(sf::RenderTarget& target);
     void onOpenDataFolderMenuItemClicked();
     void onShowHelpMenuItemClicked();       
     void onShowAboutMenuItemClicked();     
@@ -76,23 +117,38 @@ private:
     
     void setupLayout();
     void connectSignals();
-    void handleEvents();
+    void handleEvents(bool waitForEvent);
+    bool canWaitForEvents();
     
     void update();
     void render();
+    void updateFrameStats();
     
     void onCalculateButtonPressed();
+    void onSimulationFinished();
+    void showCachedTrajectory(SimulationCache::StatesPtr states);
+    void showCalculatedStatesOnCanvas(const SimulationParameters& params);
+    void discardJobFile();
+    void updateSimulationProgress();
+    void drainLivePreview();
+    WorldTrajectoryData buildWorldTrajectory() const;
+    void updateCsvExportProgress();
+    void onCsvExportFinished();
+    void cancelCsvExport();
     void onShowVisualizerButtonPressed();
     void onLoadTestDataButtonPressed();
 
-    void populateTable(const std::vector<TableRowData>& data);
-    InputParameters validateAndParseParameters(
-        const std::string& m_str, const std::string& M_str, const std::string& V0_str,
-        const std::string& T_str, const std::string& k_str, const std::string& F_str
-    );
+    void refreshTable();
+
+    //  :   *.trjb (       )
+    //      -  
+    const State* getTrajectoryData() const;
+    size_t getTrajectorySize() const;
 
     void drawTrajectoryOnCanvas(sf::RenderTarget& target_rt);
     void prepareTrajectoryForDisplay();
+    void setTrajectoryDisplayPoints(std::vector<sf::Vertex>&& points, const sf::FloatRect& bounds);
+    void updateFittedCanvasView(sf::Vector2u canvasSize);
 
     sf::RenderWindow m_window;
     tgui::Gui m_gui;
@@ -122,17 +178,64 @@ private:
     tgui::Canvas::Ptr m_trajectoryCanvas;
     sf::Font m_sfmlFont;
 
-    std::vector<TableRowData> m_currentTableData;
-    std::vector<State> m_calculatedStates;
+    SimulationCache::StatesPtr m_calculatedStates; //      (   )
+    MappedTrajectoryFile m_openedTrajectoryFile;   //  ,  m_calculatedStates
+    SimulationParameters m_lastSimulationParams;  //    (  *.trjb)
+    SimulationJob m_simulationJob;
+    //     
+    std::shared_ptr<BinaryTrajectorySink> m_jobFileSink; //    ,    
+    std::string m_jobFilePath;                           //  ;     
+    std::shared_ptr<CanvasVertexSink> m_jobCanvasSink;
+    std::shared_ptr<LivePreviewSink> m_jobPreviewSink; //   ,   
+    WorldTrajectoryData m_previewWorldPoints;          //     double (    )
+    int m_lastShownProgressPercent = -1;
+    SimulationCache m_simulationCache{ SIMULATION_CACHE_DIR }; //    (  data/cache/)
+    CsvExportJob m_csvExportJob; //  getTrajectoryData(),     
+    tgui::String m_csvExportFilename;
+    int m_lastShownExportPercent = -1;
     std::vector<sf::Vertex> m_trajectoryDisplayPoints;
     bool m_trajectoryAvailable;
 
+    //   N   ;      .
+    // m_nbodyControl   m_nbodyResult:  future  ,   
+    SimulationControl m_nbodyControl;
+    std::future<bool> m_nbodyResult;
+    std::shared_ptr<NBodyTrackSink> m_nbodyTracks;
+    int m_nbodySteps = 0;
+    int m_lastShownNBodyPercent = -1;
+
+    //  -   :   ,  
+    //        2 ,   -    .
+    // m_ensembleControl   m_ensembleResult    ,   m_nbodyControl
+    SimulationControl m_ensembleControl;
+    std::future<EnsembleResult> m_ensembleResult;
+    size_t m_ensembleRuns = 0;
+    double m_ensembleTimeUnit = 1.0;
+    int m_lastShownEnsemblePercent = -1;
+    std::vector<sf::Vertex> m_ensembleMeanPath;  // sf::LineStrip,  
+    std::vector<sf::Vertex> m_ensembleEllipses;  // sf::Lines
+    std::vector<size_t> m_ensembleHistogram;     //  -   
+
+    //        
+    sf::FloatRect m_trajectoryBounds;   //  m_trajectoryDisplayPoints,     
     sf::View m_fittedCanvasView;
+    sf::Vector2u m_fittedCanvasSize;    //  ,    m_fittedCanvasView
+    bool m_canvasViewDirty = true;
+    bool m_canvasDirty = true;
+    bool m_windowDirty = true;          //    (  )
+    sf::Clock m_lastActivityClock;      //     
+
+    //         FRAME_STATS_INTERVAL_MS
+    tgui::Label::Ptr m_frameStatsLabel;
+    sf::Clock m_frameStatsClock;
+    double m_frameStatsCpuStart = 0.0;  //      , 
+    unsigned m_frameStatsFrames = 0;
+    unsigned m_frameStatsWakeups = 0;
+    sf::Time m_frameStatsRenderTime;
 
     tgui::Label::Ptr m_tableTitleLabel;
     tgui::Grid::Ptr m_tableHeaderGrid;
-    tgui::ScrollablePanel::Ptr m_tableDataPanel;
-    tgui::Grid::Ptr m_tableDataGrid;
+    TrajectoryTableView m_tableView; //  getTrajectoryData(),   refreshTable()
 };
 
 #endif USERINTERFACE_H
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+//          
+// (, ,        ).
+//      ;    
+//     .
+class WorkStealingPool {
+public:
+    // threadCount == 0:    
+    explicit WorkStealingPool(unsigned threadCount = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    unsigned getThreadCount() const { return static_cast<unsigned>(m_workers.size()); }
+
+    //  task(index, workerId)   index  [0, count)   .
+    // workerId   [0, getThreadCount()) -   .
+    void parallelFor(size_t count, const std::function<void(size_t index, unsigned workerId)>& task);
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+
+    void workerLoop(unsigned workerId);
+    void runBatch(unsigned workerId);
+    bool popLocal(unsigned workerId, size_t& index);
+    bool steal(unsigned thiefId, size_t& index);
+
+    std::vector<std::thread> m_workers;
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+
+    std::mutex m_callMutex;  // parallelFor  
+    std::mutex m_batchMutex;
+    std::condition_variable m_batchStart;
+    std::condition_variable m_batchDone;
+    const std::function<void(size_t, unsigned)>* m_task;
+    size_t m_batchId;
+    unsigned m_activeWorkers;
+    bool m_stop;
+    std::atomic<size_t> m_remaining;
+};
+
+#endif // WORKSTEALINGPOOL_H
@@ -0,0 +1,191 @@
+#include "../include/BatchIntegrator.h"
+
+#include <algorithm> //  std::max
+#include <cmath>     //  std::sqrt
+
+TrajectoryBatch::TrajectoryBatch(const std::vector<SimulationParameters>& runs, BatchKernel kernel)
+    : m_laneCount(runs.size()),
+    m_paddedCount((runs.size() + simd::MAX_WIDTH - 1) / simd::MAX_WIDTH * simd::MAX_WIDTH),
+    m_dt(runs.empty() ? 0.0 : runs.front().DT),
+    m_stepIndex(0),
+    m_kernel(kernel),
+    m_impactStep(runs.size(), -1) {
+
+    //       
+    auto init = [this](simd::AlignedDoubles& v, double value) { v.assign(m_paddedCount, value); };
+    init(m_x, 1.0); init(m_y, 0.0); init(m_vx, 0.0); init(m_vy, 0.0);
+    init(m_negGM, 0.0); init(m_propulsion, 0.0); init(m_radiusSq, 0.0); init(m_stepLimit, 0.0);
+    init(m_active, 0.0); init(m_stepsTaken, 0.0); init(m_minRSq, 1.0); init(m_maxRSq, 1.0);
+
+    for (size_t i = 0; i < m_laneCount; ++i) {
+        const SimulationParameters& p = runs[i];
+        if (p.DT != m_dt) {
+            std::cerr << "TrajectoryBatch: run " << i << " has DT=" << p.DT
+                << ", the batch uses the common DT=" << m_dt << "." << std::endl;
+        }
+        m_x[i] = p.initialState.x;
+        m_y[i] = p.initialState.y;
+        m_vx[i] = p.initialState.vx;
+        m_vy[i] = p.initialState.vy;
+        m_negGM[i] = -p.G * p.M;
+        m_propulsion[i] = p.THRUST_COEFFICIENT - p.DRAG_COEFFICIENT;
+        m_radiusSq[i] = p.CENTRAL_BODY_RADIUS * p.CENTRAL_BODY_RADIUS;
+        m_stepLimit[i] = static_cast<double>(std::max(p.STEPS, 0));
+
+        double r2 = m_x[i] * m_x[i] + m_y[i] * m_y[i];
+        m_minRSq[i] = r2;
+        m_maxRSq[i] = r2;
+        if (r2 < m_radiusSq[i]) {
+            m_impactStep[i] = 0; //     
+        }
+        else {
+            m_active[i] = 1.0;
+        }
+    }
+}
+
+const char* TrajectoryBatch::getKernelName() const {
+    return (m_kernel == BatchKernel::Scalar) ? simd::ScalarTraits::NAME : simd::NativeTraits::NAME;
+}
+
+long long TrajectoryBatch::advance(long long maxSteps) {
+    long long done = 0;
+    while (done < maxSteps && hasActiveLanes()) {
+        //  hasActiveLanes    :     
+        long long burst = std::min<long long>(maxSteps - done, 256);
+        for (long long i = 0; i < burst; ++i) {
+            if (m_kernel == BatchKernel::Scalar) stepKernel<simd::ScalarTraits>();
+            else stepKernel<simd::NativeTraits>();
+            ++m_stepIndex;
+        }
+        done += burst;
+    }
+    return done;
+}
+
+bool TrajectoryBatch::hasActiveLanes() const {
+    for (size_t i = 0; i < m_laneCount; ++i) {
+        if (m_active[i] != 0.0 && static_cast<double>(m_stepIndex) < m_stepLimit[i]) return true;
+    }
+    return false;
+}
+
+void TrajectoryBatch::recordImpacts(size_t firstLane, unsigned impactBits) {
+    for (unsigned bit = 0; impactBits != 0; ++bit, impactBits >>= 1) {
+        if ((impactBits & 1u) && firstLane + bit < m_laneCount) {
+            m_impactStep[firstLane + bit] = m_stepIndex + 1;
+        }
+    }
+}
+
+//   RK4   .    ForceModel::GravityDragThrust
+//  Calculations::rungeKuttaStep.
+template <typename T>
+void TrajectoryBatch::stepKernel() {
+    using Vec = typename T::Vec;
+    using Mask = typename T::Mask;
+
+    const Vec dt = T::set1(m_dt);
+    const Vec dt6 = T::set1(m_dt / 6.0);
+    const Vec two = T::set1(2.0);
+    const Vec zero = T::set1(0.0);
+    const Vec stepNow = T::set1(static_cast<double>(m_stepIndex));
+    const Vec stepNext = T::set1(static_cast<double>(m_stepIndex + 1));
+
+    for (size_t i = 0; i < m_paddedCount; i += T::WIDTH) {
+        Mask active = T::maskAnd(T::lt(zero, T::load(&m_active[i])), T::lt(stepNow, T::load(&m_stepLimit[i])));
+        if (T::bits(active) == 0) continue;
+
+        const Vec x = T::load(&m_x[i]);
+        const Vec y = T::load(&m_y[i]);
+        const Vec vx = T::load(&m_vx[i]);
+        const Vec vy = T::load(&m_vy[i]);
+        const Vec negGM = T::load(&m_negGM[i]);
+        const Vec prop = T::load(&m_propulsion[i]);
+
+        // : -G*M/r^3 * r + (F - k) * v;  r == 0  
+        auto accel = [&](Vec sx, Vec sy, Vec svx, Vec svy, Vec& ax, Vec& ay) {
+            Vec r2 = T::add(T::mul(sx, sx), T::mul(sy, sy));
+            Vec r = T::sqrt(r2);
+            Vec r3 = T::mul(r2, r);
+            Vec g = T::div(negGM, r3);
+            Mask atOrigin = T::eq(r2, zero);
+            ax = T::select(atOrigin, zero, T::add(T::mul(g, sx), T::mul(prop, svx)));
+            ay = T::select(atOrigin, zero, T::add(T::mul(g, sy), T::mul(prop, svy)));
+        };
+
+        Vec k1ax, k1ay;
+        accel(x, y, vx, vy, k1ax, k1ay);
+
+        Vec x2 = T::add(x, T::div(T::mul(dt, vx), two));
+        Vec y2 = T::add(y, T::div(T::mul(dt, vy), two));
+        Vec vx2 = T::add(vx, T::div(T::mul(dt, k1ax), two));
+        Vec vy2 = T::add(vy, T::div(T::mul(dt, k1ay), two));
+        Vec k2ax, k2ay;
+        accel(x2, y2, vx2, vy2, k2ax, k2ay);
+
+        Vec x3 = T::add(x, T::div(T::mul(dt, vx2), two));
+        Vec y3 = T::add(y, T::div(T::mul(dt, vy2), two));
+        Vec vx3 = T::add(vx, T::div(T::mul(dt, k2ax), two));
+        Vec vy3 = T::add(vy, T::div(T::mul(dt, k2ay), two));
+        Vec k3ax, k3ay;
+        accel(x3, y3, vx3, vy3, k3ax, k3ay);
+
+        Vec x4 = T::add(x, T::mul(dt, vx3));
+        Vec y4 = T::add(y, T::mul(dt, vy3));
+        Vec vx4 = T::add(vx, T::mul(dt, k3ax));
+        Vec vy4 = T::add(vy, T::mul(dt, k3ay));
+        Vec k4ax, k4ay;
+        accel(x4, y4, vx4, vy4, k4ax, k4ay);
+
+        // s + dt / 6 * (k1 + 2 * k2 + 2 * k3 + k4)
+        auto combine = [&](Vec s, Vec k1, Vec k2, Vec k3, Vec k4) {
+            Vec sum = T::add(T::add(T::add(k1, T::mul(two, k2)), T::mul(two, k3)), k4);
+            return T::add(s, T::mul(dt6, sum));
+        };
+        Vec nx = combine(x, vx, vx2, vx3, vx4);
+        Vec ny = combine(y, vy, vy2, vy3, vy4);
+        Vec nvx = combine(vx, k1ax, k2ax, k3ax, k4ax);
+        Vec nvy = combine(vy, k1ay, k2ay, k3ay, k4ay);
+
+        T::store(&m_x[i], T::select(active, nx, x));
+        T::store(&m_y[i], T::select(active, ny, y));
+        T::store(&m_vx[i], T::select(active, nvx, vx));
+        T::store(&m_vy[i], T::select(active, nvy, vy));
+        T::store(&m_stepsTaken[i], T::select(active, stepNext, T::load(&m_stepsTaken[i])));
+
+        Vec r2 = T::add(T::mul(nx, nx), T::mul(ny, ny));
+        Vec minR2 = T::load(&m_minRSq[i]);
+        Vec maxR2 = T::load(&m_maxRSq[i]);
+        T::store(&m_minRSq[i], T::select(active, T::min(minR2, r2), minR2));
+        T::store(&m_maxRSq[i], T::select(active, T::max(maxR2, r2), maxR2));
+
+        //   ;      (  runSimulation)
+        Mask impact = T::maskAnd(active, T::lt(r2, T::load(&m_radiusSq[i])));
+        unsigned impactBits = T::bits(impact);
+        if (impactBits != 0) {
+            T::store(&m_active[i], T::select(impact, zero, T::load(&m_active[i])));
+            recordImpacts(i, impactBits);
+        }
+    }
+}
+
+State TrajectoryBatch::getState(size_t lane) const {
+    return { m_x[lane], m_y[lane], m_vx[lane], m_vy[lane] };
+}
+
+long long TrajectoryBatch::getStepsTaken(size_t lane) const {
+    return static_cast<long long>(m_stepsTaken[lane]);
+}
+
+long long TrajectoryBatch::getImpactStep(size_t lane) const {
+    return m_impactStep[lane];
+}
+
+double TrajectoryBatch::getMinR(size_t lane) const {
+    return std::sqrt(m_minRSq[lane]);
+}
+
+double TrajectoryBatch::getMaxR(size_t lane) const {
+    return std::sqrt(m_maxRSq[lane]);
+}
@@ -1,96 +1,359 @@
 #include "../include/Calculations.h"
+#include "../include/TrajectorySink.h"
+#include "../include/ForceModels.h"
+
+#include <algorithm> //  std::min, std::max
 
 Calculations::Calculations() {
     //  ,     
 }
 
 //     
-std::vector<State> Calculations::runSimulation(const SimulationParameters& params) {
+std::vector<State> Calculations::runSimulation(const SimulationParameters& params, SimulationControl* control) {
+    CollectingSink collector;
+    runSimulation(params, collector, control);
+    return std::move(collector.getStates());
+}
+
+//    
+void Calculations::runSimulation(const SimulationParameters& params, TrajectorySink& sink, SimulationControl* control) {
+    m_lastStats = IntegrationStats();
+
     State currentState;
     currentState.x = params.initialState.x;
     currentState.y = params.initialState.y;
     currentState.vx = params.initialState.vx;
     currentState.vy = params.initialState.vy;
 
-    std::vector<State> trajectoryStates; //   
-    trajectoryStates.reserve(static_cast<size_t>(params.STEPS) + 1);
-    trajectoryStates.push_back(currentState); //   
+    sink.begin(params);
+    TrajectoryChunkBuffer output(sink);
+    output.push(currentState); //   
 
     double initial_r_squared = currentState.x * currentState.x + currentState.y * currentState.y;
     if (initial_r_squared < params.CENTRAL_BODY_RADIUS * params.CENTRAL_BODY_RADIUS) {
-        std::cout << ":   (" << currentState.x << ", " << currentState.y
+        if (m_eventMessages) std::cout << ":   (" << currentState.x << ", " << currentState.y
             << ")     (" << params.CENTRAL_BODY_RADIUS << ").\n";
-        return trajectoryStates;
+    }
+    else {
+        integrate(params, currentState, 0, output, control);
     }
 
-    for (int i = 0; i < params.STEPS; ++i) {
-        currentState = rungeKuttaStep(currentState, params.DT, params); //  params 
+    output.flush();
+    sink.end();
 
-        trajectoryStates.push_back(currentState); //   
+    if (control) {
+        control->completedSteps.store(static_cast<int>(output.emitted()) - 1, std::memory_order_relaxed);
+    }
+}
+
+bool Calculations::resumeSimulation(const SimulationParameters& params, const SimulationCheckpoint& from,
+    TrajectorySink& sink, SimulationControl* control) {
+    if (!sameModel(params, from.params)) {
+        std::cerr << "Error: checkpoint was written for different simulation parameters." << std::endl;
+        return false;
+    }
+    if (params.STEPS < 0 || from.stepIndex > static_cast<std::uint64_t>(params.STEPS)) {
+        std::cerr << "Error: checkpoint step " << from.stepIndex << " is beyond STEPS = " << params.STEPS << "." << std::endl;
+        return false;
+    }
+    m_lastStats = IntegrationStats();
+
+    const int firstStep = static_cast<int>(from.stepIndex);
+    sink.begin(params);
+    TrajectoryChunkBuffer output(sink, from.stepIndex + 1); //     
+
+    const State& currentState = from.state;
+    double r_squared = currentState.x * currentState.x + currentState.y * currentState.y;
+    if (r_squared < params.CENTRAL_BODY_RADIUS * params.CENTRAL_BODY_RADIUS) {
+        //    :  
+        if (m_eventMessages) std::cout << ":   (" << currentState.x << ", " << currentState.y
+            << ")     (" << params.CENTRAL_BODY_RADIUS << ").\n";
+    }
+    else {
+        integrate(params, currentState, firstStep, output, control);
+    }
+
+    output.flush();
+    sink.end();
+
+    if (control) {
+        control->completedSteps.store(static_cast<int>(output.emitted()) - 1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+bool Calculations::sameModel(const SimulationParameters& a, const SimulationParameters& b) {
+    bool same = a.G == b.G && a.M == b.M && a.CENTRAL_BODY_RADIUS == b.CENTRAL_BODY_RADIUS
+        && a.DRAG_COEFFICIENT == b.DRAG_COEFFICIENT && a.THRUST_COEFFICIENT == b.THRUST_COEFFICIENT
+        && a.DT == b.DT && a.integrator == b.integrator
+        && a.initialState.x == b.initialState.x && a.initialState.y == b.initialState.y
+        && a.initialState.vx == b.initialState.vx && a.initialState.vy == b.initialState.vy
+        && a.perturbations.J2 == b.perturbations.J2 && a.perturbations.atmosphereDrag == b.perturbations.atmosphereDrag
+        && a.perturbations.atmosphereScaleHeight == b.perturbations.atmosphereScaleHeight
+        && a.perturbations.thrustAcceleration == b.perturbations.thrustAcceleration
+        && a.perturbations.thrustAngle == b.perturbations.thrustAngle;
+    if (same && a.integrator == IntegratorType::DormandPrince45) {
+        same = a.adaptive.rtol == b.adaptive.rtol && a.adaptive.atol == b.adaptive.atol
+            && a.adaptive.minStep == b.adaptive.minStep && a.adaptive.maxStep == b.adaptive.maxStep
+            && a.adaptive.initialStep == b.adaptive.initialStep;
+    }
+    return same;
+}
+
+namespace {
+    //   4- :    W1 * DT, W0 * DT, W1 * DT,
+    // W1 = 1 / (2 - 2^(1/3)), W0 = -2^(1/3) / (2 - 2^(1/3)); W0 + 2 * W1 = 1
+    constexpr double YOSHIDA_W1 = 1.35120719195965763405;
+    constexpr double YOSHIDA_W0 = -1.70241438391931526810;
+}
+
+template <typename StepFunction>
+void Calculations::integrateFixedStep(const SimulationParameters& params, State currentState, int firstStep,
+    TrajectoryChunkBuffer& output, SimulationControl* control, StepFunction step) {
+    for (int i = firstStep; i < params.STEPS; ++i) {
+        if (control && (i % PROGRESS_INTERVAL_STEPS) == 0) {
+            control->completedSteps.store(i, std::memory_order_relaxed);
+            if (control->cancelRequested.load(std::memory_order_relaxed)) {
+                if (m_eventMessages) std::cout << "    " << i << ".\n";
+                break;
+            }
+        }
+        step(currentState);
+        ++m_lastStats.acceptedSteps;
+
+        output.push(currentState); //   
 
         double r_squared = currentState.x * currentState.x + currentState.y * currentState.y;
         if (r_squared < params.CENTRAL_BODY_RADIUS * params.CENTRAL_BODY_RADIUS) {
-            std::cout << "    " << i + 1
+            if (m_eventMessages) std::cout << "    " << i + 1
                 << "  . : (" << currentState.x << ", " << currentState.y
                 << "), r = " << std::sqrt(r_squared) << "\n";
             break;
         }
     }
-    return trajectoryStates;
 }
 
-//     
-State Calculations::derivatives(const State& s, const SimulationParameters& params) {
-    double r_squared = s.x * s.x + s.y * s.y;
-    if (r_squared == 0) {
-        return { s.vx, s.vy, 0, 0 };
+void Calculations::integrate(const SimulationParameters& params, const State& currentState, int firstStep,
+    TrajectoryChunkBuffer& output, SimulationControl* control) {
+    dispatchForceModel(params, [&](const auto& force) {
+        integrateWithForce(params, force, currentState, firstStep, output, control);
+    });
+}
+
+template <typename Force>
+void Calculations::integrateWithForce(const SimulationParameters& params, const Force& force, const State& currentState,
+    int firstStep, TrajectoryChunkBuffer& output, SimulationControl* control) {
+    const double dt = params.DT;
+    switch (params.integrator) {
+    case IntegratorType::DormandPrince45:
+        integrateAdaptive(params, force, currentState, firstStep, output, control);
+        break;
+    case IntegratorType::VelocityVerlet: {
+        State derivative = force(currentState);
+        integrateFixedStep(params, currentState, firstStep, output, control,
+            [&](State& s) { velocityVerletStep(s, derivative, dt, force); });
+        m_lastStats.derivativeEvaluations = 1 + m_lastStats.acceptedSteps;
+        break;
+    }
+    case IntegratorType::Yoshida4: {
+        State derivative = force(currentState);
+        integrateFixedStep(params, currentState, firstStep, output, control, [&](State& s) {
+            velocityVerletStep(s, derivative, YOSHIDA_W1 * dt, force);
+            velocityVerletStep(s, derivative, YOSHIDA_W0 * dt, force);
+            velocityVerletStep(s, derivative, YOSHIDA_W1 * dt, force);
+        });
+        m_lastStats.derivativeEvaluations = 1 + 3 * m_lastStats.acceptedSteps;
+        break;
+    }
+    default:
+        integrateFixedStep(params, currentState, firstStep, output, control,
+            [&](State& s) { s = rungeKuttaStep(s, dt, force); });
+        m_lastStats.derivativeEvaluations = 4 * m_lastStats.acceptedSteps;
+        break;
+    }
+}
+
+namespace {
+    // acc += h * (a1 * k1 + a2 * k2 + ...)    
+    inline void accumulateStages(State&, double) {}
+
+    template <typename... Rest>
+    inline void accumulateStages(State& acc, double h, double a, const State& k, const Rest&... rest) {
+        acc.x += h * a * k.x;
+        acc.y += h * a * k.y;
+        acc.vx += h * a * k.vx;
+        acc.vy += h * a * k.vy;
+        accumulateStages(acc, h, rest...);
+    }
+
+    template <typename... Stages>
+    inline State stageState(const State& s, double h, const Stages&... stages) {
+        State result = s;
+        accumulateStages(result, h, stages...);
+        return result;
     }
-    double r = std::sqrt(r_squared);
-    double r_cubed = r_squared * r;
 
-    double common_factor_gravity = -params.G * params.M / r_cubed;
-    double net_propulsion_factor = params.THRUST_COEFFICIENT - params.DRAG_COEFFICIENT;
+    //   - 5(4) (Hairer, Norsett, Wanner, DOPRI5)
+    namespace dp {
+        constexpr double a21 = 1.0 / 5.0;
+        constexpr double a31 = 3.0 / 40.0, a32 = 9.0 / 40.0;
+        constexpr double a41 = 44.0 / 45.0, a42 = -56.0 / 15.0, a43 = 32.0 / 9.0;
+        constexpr double a51 = 19372.0 / 6561.0, a52 = -25360.0 / 2187.0, a53 = 64448.0 / 6561.0, a54 = -212.0 / 729.0;
+        constexpr double a61 = 9017.0 / 3168.0, a62 = -355.0 / 33.0, a63 = 46732.0 / 5247.0, a64 = 49.0 / 176.0, a65 = -5103.0 / 18656.0;
+        constexpr double a71 = 35.0 / 384.0, a73 = 500.0 / 1113.0, a74 = 125.0 / 192.0, a75 = -2187.0 / 6784.0, a76 = 11.0 / 84.0;
 
-    double ax = common_factor_gravity * s.x + net_propulsion_factor * s.vx;
-    double ay = common_factor_gravity * s.y + net_propulsion_factor * s.vy;
-    return { s.vx, s.vy, ax, ay };
+        //    5-  4-  (  )
+        constexpr double e1 = 71.0 / 57600.0, e3 = -71.0 / 16695.0, e4 = 71.0 / 1920.0,
+            e5 = -17253.0 / 339200.0, e6 = 22.0 / 525.0, e7 = -1.0 / 40.0;
+
+        //   4- 
+        constexpr double d1 = -12715105075.0 / 11282082432.0, d3 = 87487479700.0 / 32700410799.0,
+            d4 = -10690763975.0 / 1880347072.0, d5 = 701980252875.0 / 199316789632.0,
+            d6 = -1453857185.0 / 822651844.0, d7 = 69997945.0 / 29380423.0;
+
+        constexpr double SAFETY = 0.9;
+        constexpr double MIN_FACTOR = 0.2;
+        constexpr double MAX_FACTOR = 5.0;
+    }
+
+    inline double scaledError(double err, double y0, double y1, double atol, double rtol) {
+        double sc = atol + rtol * std::max(std::fabs(y0), std::fabs(y1));
+        double q = err / sc;
+        return q * q;
+    }
 }
 
-//     - 4- 
-State Calculations::rungeKuttaStep(const State& s, double dt, const SimulationParameters& params) {
-    State k1 = derivatives(s, params);
-
-    State s_temp_k2 = {
-        s.x + dt * k1.x / 2.0,
-        s.y + dt * k1.y / 2.0,
-        s.vx + dt * k1.vx / 2.0,
-        s.vy + dt * k1.vy / 2.0
-    };
-    State k2 = derivatives(s_temp_k2, params);
-
-    State s_temp_k3 = {
-        s.x + dt * k2.x / 2.0,
-        s.y + dt * k2.y / 2.0,
-        s.vx + dt * k2.vx / 2.0,
-        s.vy + dt * k2.vy / 2.0
-    };
-    State k3 = derivatives(s_temp_k3, params);
-
-    State s_temp_k4 = {
-        s.x + dt * k3.x,
-        s.y + dt * k3.y,
-        s.vx + dt * k3.vx,
-        s.vy + dt * k3.vy
-    };
-    State k4 = derivatives(s_temp_k4, params);
-
-    return {
-        s.x + dt / 6.0 * (k1.x + 2.0 * k2.x + 2.0 * k3.x + k4.x),
-        s.y + dt / 6.0 * (k1.y + 2.0 * k2.y + 2.0 * k3.y + k4.y),
-        s.vx + dt / 6.0 * (k1.vx + 2.0 * k2.vx + 2.0 * k3.vx + k4.vx),
-        s.vy + dt / 6.0 * (k1.vy + 2.0 * k2.vy + 2.0 * k3.vy + k4.vy)
-    };
+template <typename Force>
+void Calculations::integrateAdaptive(const SimulationParameters& params, const Force& force, State currentState, int firstStep,
+    TrajectoryChunkBuffer& output, SimulationControl* control) {
+    const auto& cfg = params.adaptive;
+    const double radius_squared = params.CENTRAL_BODY_RADIUS * params.CENTRAL_BODY_RADIUS;
+    const double t_end = params.STEPS * params.DT;
+
+    double t = firstStep * params.DT;
+    double h = std::min(std::max(cfg.initialStep > 0.0 ? cfg.initialStep : params.DT, cfg.minStep), cfg.maxStep);
+    int nextOutput = firstStep + 1; //       i * DT
+    bool previousRejected = false;
+
+    State k1 = force(currentState); // FSAL: k7   = k1 
+    ++m_lastStats.derivativeEvaluations;
+
+    while (nextOutput <= params.STEPS) {
+        if (control && (m_lastStats.acceptedSteps % PROGRESS_INTERVAL_STEPS) == 0) {
+            control->completedSteps.store(nextOutput - 1, std::memory_order_relaxed);
+            if (control->cancelRequested.load(std::memory_order_relaxed)) {
+                if (m_eventMessages) std::cout << "     " << nextOutput - 1 << ".\n";
+                break;
+            }
+        }
+
+        const bool atMinStep = h <= cfg.minStep;
+        const bool lastStep = t + h >= t_end;
+        if (lastStep) h = t_end - t; //     
+
+        using namespace dp;
+        State k2 = force(stageState(currentState, h, a21, k1));
+        State k3 = force(stageState(currentState, h, a31, k1, a32, k2));
+        State k4 = force(stageState(currentState, h, a41, k1, a42, k2, a43, k3));
+        State k5 = force(stageState(currentState, h, a51, k1, a52, k2, a53, k3, a54, k4));
+        State k6 = force(stageState(currentState, h, a61, k1, a62, k2, a63, k3, a64, k4, a65, k5));
+        State nextState = stageState(currentState, h, a71, k1, a73, k3, a74, k4, a75, k5, a76, k6);
+        State k7 = force(nextState);
+        m_lastStats.derivativeEvaluations += 6;
+
+        State err = stageState(State{ 0.0, 0.0, 0.0, 0.0 }, h, e1, k1, e3, k3, e4, k4, e5, k5, e6, k6, e7, k7);
+        double errNorm = std::sqrt((
+            scaledError(err.x, currentState.x, nextState.x, cfg.atol, cfg.rtol) +
+            scaledError(err.y, currentState.y, nextState.y, cfg.atol, cfg.rtol) +
+            scaledError(err.vx, currentState.vx, nextState.vx, cfg.atol, cfg.rtol) +
+            scaledError(err.vy, currentState.vy, nextState.vy, cfg.atol, cfg.rtol)) / 4.0);
+
+        if (errNorm > 1.0 && !atMinStep) {
+            //  :   
+            ++m_lastStats.rejectedSteps;
+            previousRejected = true;
+            h *= std::max(MIN_FACTOR, SAFETY * std::pow(errNorm, -0.2));
+            h = std::max(h, cfg.minStep);
+            continue;
+        }
+        if (errNorm > 1.0) ++m_lastStats.forcedMinSteps;
+        ++m_lastStats.acceptedSteps;
+
+        //  :    i * DT,   (t, t + h]
+        const double t_next = lastStep ? t_end : t + h;
+        bool collided = false;
+        if (nextOutput * params.DT <= t_next) {
+            State ydiff = stageState(nextState, -1.0, 1.0, currentState);
+            State bspl = stageState(State{ 0.0, 0.0, 0.0, 0.0 }, h, 1.0, k1);
+            accumulateStages(bspl, -1.0, 1.0, ydiff);
+            State rcont4 = stageState(ydiff, -h, 1.0, k7);
+            accumulateStages(rcont4, -1.0, 1.0, bspl);
+            State rcont5 = stageState(State{ 0.0, 0.0, 0.0, 0.0 }, h, d1, k1, d3, k3, d4, k4, d5, k5, d6, k6, d7, k7);
+
+            while (nextOutput <= params.STEPS && nextOutput * params.DT <= t_next) {
+                double theta = (nextOutput * params.DT - t) / h;
+                double theta1 = 1.0 - theta;
+                // y = y0 + theta * (ydiff + theta1 * (bspl + theta * (rcont4 + theta1 * rcont5)))
+                State sample = stageState(rcont4, theta1, 1.0, rcont5);
+                sample = stageState(bspl, theta, 1.0, sample);
+                sample = stageState(ydiff, theta1, 1.0, sample);
+                sample = stageState(currentState, theta, 1.0, sample);
+
+                output.push(sample);
+                ++nextOutput;
+
+                double r_squared = sample.x * sample.x + sample.y * sample.y;
+                if (r_squared < radius_squared) {
+                    if (m_eventMessages) std::cout << "    " << nextOutput - 1
+                        << "  . : (" << sample.x << ", " << sample.y
+                        << "), r = " << std::sqrt(r_squared) << "\n";
+                    collided = true;
+                    break;
+                }
+            }
+        }
+        if (collided) break;
+
+        t = t_next;
+        currentState = nextState;
+        k1 = k7;
+
+        //       :     
+        double r_squared = currentState.x * currentState.x + currentState.y * currentState.y;
+        if (r_squared < radius_squared) {
+            output.push(currentState);
+            if (m_eventMessages) std::cout << "     (t = " << t
+                << "). : (" << currentState.x << ", " << currentState.y
+                << "), r = " << std::sqrt(r_squared) << "\n";
+            break;
+        }
+
+        //  :    
+        double factor = (errNorm > 0.0) ? SAFETY * std::pow(errNorm, -0.2) : MAX_FACTOR;
+        factor = std::min(previousRejected ? 1.0 : MAX_FACTOR, std::max(MIN_FACTOR, factor));
+        previousRejected = false;
+        h = std::min(std::max(h * factor, cfg.minStep), cfg.maxStep);
+    }
 }
 
+//    v^2 / 2 - G * M / r
+double Calculations::specificEnergy(const State& s, const SimulationParameters& params) {
+    double r = std::sqrt(s.x * s.x + s.y * s.y);
+    double kinetic = 0.5 * (s.vx * s.vx + s.vy * s.vy);
+    return (r > 0.0) ? kinetic - params.G * params.M / r : kinetic;
+}
 
+double Calculations::specificAngularMomentum(const State& s) {
+    return s.x * s.vy - s.y * s.vx;
+}
 
+//     - 4- 
+State Calculations::rungeKuttaStep(const State& s, double dt, const SimulationParameters& params) {
+    State result;
+    dispatchForceModel(params, [&](const auto& force) { result = rungeKuttaStep(s, dt, force); });
+    return result;
+}
+
+void Calculations::velocityVerletStep(State& s, State& derivative, double h, const SimulationParameters& params) {
+    dispatchForceModel(params, [&](const auto& force) { velocityVerletStep(s, derivative, h, force); });
+}
@@ -0,0 +1,208 @@
+#include "../include/CsvExport.h"
+
+#include <algorithm> //  std::min
+#include <charconv>  //  std::to_chars
+#include <cmath>     //  std::fma, std::nearbyint
+#include <cstdint>
+#include <cstring>   //  std::memcpy
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+// --- CsvTrajectoryWriter ---
+const char* const CsvTrajectoryWriter::HEADER =
+    "Step_Index, Time_dimless(approx), x_dimless, y_dimless, vx_dimless, vy_dimless\n";
+
+namespace {
+    //         
+    constexpr size_t ROWS_PER_BLOCK = 16384;
+
+    constexpr char FIELD_SEPARATOR[] = ",  ";
+    constexpr size_t FIELD_SEPARATOR_LENGTH = sizeof(FIELD_SEPARATOR) - 1;
+
+    inline char* appendSeparator(char* p) {
+        std::memcpy(p, FIELD_SEPARATOR, FIELD_SEPARATOR_LENGTH);
+        return p + FIELD_SEPARATOR_LENGTH;
+    }
+
+    constexpr double pow10(int exponent) {
+        return exponent == 0 ? 1.0 : 10.0 * pow10(exponent - 1);
+    }
+    constexpr double FIXED_SCALE = pow10(CsvTrajectoryWriter::PRECISION);
+    constexpr std::uint64_t FIXED_SCALE_INT = static_cast<std::uint64_t>(FIXED_SCALE);
+    //  2^51  value * FIXED_SCALE   double   0.5,    
+    constexpr double FIXED_FAST_LIMIT = 2251799813685248.0;
+
+    //  ,  to_chars(fixed, PRECISION)  printf("%.5f"):   
+    //    .  value * 10^5   
+    // scaled + error (error  fma),     .
+    //  , NaN     std::to_chars.
+    inline char* appendFixed(char* p, char* last, double value) {
+        const double scaled = value * FIXED_SCALE;
+        if (!(std::fabs(scaled) < FIXED_FAST_LIMIT)) {
+            return std::to_chars(p, last, value, std::chars_format::fixed, CsvTrajectoryWriter::PRECISION).ptr;
+        }
+        const double error = std::fma(value, FIXED_SCALE, -scaled); // value * 10^5 == scaled + error 
+        double rounded = std::nearbyint(scaled);                    //   :   
+        const double fraction = scaled - rounded;                    // , |fraction| <= 0.5
+        if (fraction == 0.5 && error > 0.0) rounded += 1.0;
+        else if (fraction == -0.5 && error < 0.0) rounded -= 1.0;
+
+        if (std::signbit(value)) *p++ = '-'; //  printf: -0.00000   
+        const std::uint64_t units = static_cast<std::uint64_t>(std::fabs(rounded));
+        p = std::to_chars(p, last, units / FIXED_SCALE_INT).ptr;
+        *p++ = '.';
+        std::uint64_t digits = units % FIXED_SCALE_INT;
+        for (int i = CsvTrajectoryWriter::PRECISION - 1; i >= 0; --i) {
+            p[i] = static_cast<char>('0' + digits % 10);
+            digits /= 10;
+        }
+        return p + CsvTrajectoryWriter::PRECISION;
+    }
+}
+
+CsvTrajectoryWriter::CsvTrajectoryWriter(std::ostream& out)
+    : m_out(out),
+    m_buffer(BUFFER_SIZE),
+    m_used(0) {
+}
+
+CsvTrajectoryWriter::~CsvTrajectoryWriter() {
+    flush();
+}
+
+void CsvTrajectoryWriter::writeHeader() {
+    size_t length = std::strlen(HEADER);
+    if (m_used + length > m_buffer.size()) flush();
+    std::memcpy(m_buffer.data() + m_used, HEADER, length);
+    m_used += length;
+}
+
+void CsvTrajectoryWriter::appendRow(size_t index, double time, const State& state) {
+    char* p = m_buffer.data() + m_used;
+    char* last = m_buffer.data() + m_buffer.size();
+    p = std::to_chars(p, last, index).ptr;
+    p = appendSeparator(p);
+    p = appendFixed(p, last, time);
+    p = appendSeparator(p);
+    p = appendFixed(p, last, state.x);
+    p = appendSeparator(p);
+    p = appendFixed(p, last, state.y);
+    p = appendSeparator(p);
+    p = appendFixed(p, last, state.vx);
+    p = appendSeparator(p);
+    p = appendFixed(p, last, state.vy);
+    *p++ = '\n';
+    m_used = static_cast<size_t>(p - m_buffer.data());
+}
+
+void CsvTrajectoryWriter::writeRows(size_t firstIndex, const State* states, size_t count, double dt) {
+    for (size_t i = 0; i < count; ++i) {
+        if (m_used + MAX_ROW_LENGTH > m_buffer.size()) flush();
+        size_t index = firstIndex + i;
+        appendRow(index, static_cast<double>(index) * dt, states[i]);
+    }
+}
+
+bool CsvTrajectoryWriter::flush() {
+    if (m_used > 0) {
+        m_out.write(m_buffer.data(), static_cast<std::streamsize>(m_used));
+        m_used = 0;
+    }
+    return !m_out.fail();
+}
+
+bool CsvTrajectoryWriter::writeFile(const std::string& path, const State* states, size_t count, double dt,
+    std::atomic<size_t>* completedRows, const std::atomic<bool>* cancelRequested) {
+    std::ofstream outFile(std::filesystem::u8path(path), std::ios::binary);
+    if (!outFile.is_open()) {
+        std::cerr << "CsvTrajectoryWriter: Could not open file '" << path << "' for writing." << std::endl;
+        return false;
+    }
+
+    {
+        CsvTrajectoryWriter writer(outFile);
+        writer.writeHeader();
+        for (size_t first = 0; first < count; first += ROWS_PER_BLOCK) {
+            if (cancelRequested && cancelRequested->load(std::memory_order_relaxed)) return false;
+            size_t blockSize = std::min(ROWS_PER_BLOCK, count - first);
+            writer.writeRows(first, states + first, blockSize, dt);
+            if (completedRows) completedRows->store(first + blockSize, std::memory_order_relaxed);
+        }
+    } //  writer   
+
+    outFile.close();
+    if (outFile.fail()) {
+        std::cerr << "CsvTrajectoryWriter: Failed to write or close '" << path << "'." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// --- CsvExportJob ---
+CsvExportJob::CsvExportJob()
+    : m_status(Status::Idle),
+    m_cancelRequested(false),
+    m_completedRows(0),
+    m_states(nullptr),
+    m_count(0),
+    m_dt(0.0) {
+}
+
+CsvExportJob::~CsvExportJob() {
+    cancelAndJoin();
+}
+
+void CsvExportJob::start(const std::string& path, const State* states, size_t count, double dt) {
+    cancelAndJoin();
+
+    m_path = path;
+    m_states = states;
+    m_count = count;
+    m_dt = dt;
+    m_cancelRequested.store(false, std::memory_order_relaxed);
+    m_completedRows.store(0, std::memory_order_relaxed);
+    m_status.store(Status::Running, std::memory_order_release);
+    m_worker = std::thread(&CsvExportJob::workerMain, this);
+}
+
+void CsvExportJob::cancel() {
+    cancelAndJoin();
+}
+
+void CsvExportJob::cancelAndJoin() {
+    if (m_worker.joinable()) {
+        m_cancelRequested.store(true, std::memory_order_relaxed);
+        m_worker.join();
+    }
+    if (getStatus() == Status::Running) {
+        m_status.store(Status::Cancelled, std::memory_order_release);
+    }
+}
+
+double CsvExportJob::getProgress() const {
+    if (m_count == 0) return isRunning() ? 0.0 : 1.0;
+    double done = static_cast<double>(m_completedRows.load(std::memory_order_relaxed));
+    return std::min(1.0, done / static_cast<double>(m_count));
+}
+
+bool CsvExportJob::acknowledgeFinished(bool& succeeded) {
+    Status status = getStatus();
+    if (status != Status::Finished && status != Status::Failed) return false;
+    if (m_worker.joinable()) m_worker.join();
+
+    succeeded = (status == Status::Finished);
+    m_states = nullptr;
+    m_status.store(Status::Idle, std::memory_order_release);
+    return true;
+}
+
+void CsvExportJob::workerMain() {
+    bool ok = CsvTrajectoryWriter::writeFile(m_path, m_states, m_count, m_dt, &m_completedRows, &m_cancelRequested);
+
+    if (m_cancelRequested.load(std::memory_order_relaxed)) {
+        m_status.store(Status::Cancelled, std::memory_order_release);
+        return;
+    }
+    m_status.store(ok ? Status::Finished : Status::Failed, std::memory_order_release);
+}
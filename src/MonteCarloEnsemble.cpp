@@ -0,0 +1,203 @@
+#include "../include/MonteCarloEnsemble.h"
+#include "../include/TrajectorySink.h"
+
+#include <algorithm> //  std::min, std::max
+#include <cmath>     //  std::sqrt
+
+// --- RunningCovariance2D ---
+void RunningCovariance2D::merge(const RunningCovariance2D& other) {
+    if (other.m_count == 0) return;
+    if (m_count == 0) {
+        *this = other;
+        return;
+    }
+    const double n1 = static_cast<double>(m_count);
+    const double n2 = static_cast<double>(other.m_count);
+    const double n = n1 + n2;
+    const double dx = other.m_meanX - m_meanX;
+    const double dy = other.m_meanY - m_meanY;
+    m_meanX += dx * n2 / n;
+    m_meanY += dy * n2 / n;
+    m_m2X += other.m_m2X + dx * dx * n1 * n2 / n;
+    m_m2Y += other.m_m2Y + dy * dy * n1 * n2 / n;
+    m_cXY += other.m_cXY + dx * dy * n1 * n2 / n;
+    m_count += other.m_count;
+}
+
+namespace {
+
+    //      (),    
+    struct RunningStatistics {
+        size_t count = 0;
+        double mean = 0.0;
+        double m2 = 0.0;
+
+        void add(double value) {
+            ++count;
+            const double delta = value - mean;
+            mean += delta / static_cast<double>(count);
+            m2 += delta * (value - mean);
+        }
+
+        void merge(const RunningStatistics& other) {
+            if (other.count == 0) return;
+            if (count == 0) {
+                *this = other;
+                return;
+            }
+            const double n1 = static_cast<double>(count);
+            const double n2 = static_cast<double>(other.count);
+            const double delta = other.mean - mean;
+            mean += delta * n2 / (n1 + n2);
+            m2 += other.m2 + delta * delta * n1 * n2 / (n1 + n2);
+            count += other.count;
+        }
+    };
+
+    //    
+    struct EnsemblePartial {
+        size_t runs = 0;
+        std::vector<RunningCovariance2D> samples;
+        std::vector<size_t> histogram;
+        RunningStatistics impactTimes;
+    };
+
+    //     sampleSteps      
+    class EnsembleStatisticsSink : public TrajectorySink {
+    public:
+        EnsembleStatisticsSink(const std::vector<size_t>& sampleSteps, std::vector<RunningCovariance2D>& samples)
+            : m_sampleSteps(sampleSteps),
+            m_samples(samples) {
+        }
+
+        void consume(size_t firstIndex, const State* states, size_t count) override {
+            if (count == 0) return;
+            const size_t end = firstIndex + count;
+            while (m_nextSample < m_sampleSteps.size() && m_sampleSteps[m_nextSample] < end) {
+                const size_t step = m_sampleSteps[m_nextSample];
+                if (step >= firstIndex) m_samples[m_nextSample].add(states[step - firstIndex].x, states[step - firstIndex].y);
+                ++m_nextSample;
+            }
+            m_pointCount = end;
+            m_lastState = states[count - 1];
+        }
+
+        size_t getPointCount() const { return m_pointCount; }
+        const State& getLastState() const { return m_lastState; }
+
+    private:
+        const std::vector<size_t>& m_sampleSteps;
+        std::vector<RunningCovariance2D>& m_samples;
+        size_t m_nextSample = 0;
+        size_t m_pointCount = 0;
+        State m_lastState{ 0.0, 0.0, 0.0, 0.0 };
+    };
+
+} // namespace
+
+// --- MonteCarloEnsemble ---
+MonteCarloEnsemble::MonteCarloEnsemble(unsigned threadCount)
+    : m_pool(threadCount) {
+}
+
+SimulationParameters MonteCarloEnsemble::samplePerturbed(const SimulationParameters& nominal, const EnsembleDispersion& dispersion,
+    std::mt19937_64& generator) {
+    //     (   ),       
+    std::normal_distribution<double> normal(0.0, 1.0);
+    const double velocity = normal(generator);
+    const double positionX = normal(generator);
+    const double positionY = normal(generator);
+    const double drag = normal(generator);
+
+    SimulationParameters params = nominal;
+    params.initialState.vy += dispersion.velocitySigma * velocity;
+    params.initialState.x += dispersion.positionSigma * positionX;
+    params.initialState.y += dispersion.positionSigma * positionY;
+    params.DRAG_COEFFICIENT = std::max(0.0, params.DRAG_COEFFICIENT + dispersion.dragSigma * drag);
+    return params;
+}
+
+std::mt19937_64 MonteCarloEnsemble::makeTaskGenerator(std::uint64_t seed, size_t task) {
+    std::seed_seq sequence{ static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32),
+        static_cast<std::uint32_t>(task), static_cast<std::uint32_t>(static_cast<std::uint64_t>(task) >> 32) };
+    return std::mt19937_64(sequence);
+}
+
+EnsembleResult MonteCarloEnsemble::run(const SimulationParameters& nominal, const EnsembleDispersion& dispersion,
+    const EnsembleSettings& settings, SimulationControl* control) {
+    EnsembleResult result;
+    if (control) control->completedSteps.store(0, std::memory_order_relaxed);
+
+    //  :  k * STEPS / (n - 1),  -  ,  - STEPS
+    const size_t steps = static_cast<size_t>(std::max(nominal.STEPS, 0));
+    const size_t sampleCount = std::min(std::max<size_t>(settings.sampleCount, 1), steps + 1);
+    std::vector<size_t> sampleSteps(sampleCount, 0);
+    for (size_t k = 1; k < sampleCount; ++k) sampleSteps[k] = k * steps / (sampleCount - 1);
+
+    const size_t bins = std::max<size_t>(settings.histogramBins, 1);
+    const double duration = static_cast<double>(steps) * nominal.DT;
+    result.histogramBinWidth = (duration > 0.0) ? duration / static_cast<double>(bins) : nominal.DT;
+
+    const size_t taskCount = (settings.runs + RUNS_PER_TASK - 1) / RUNS_PER_TASK;
+    std::vector<EnsemblePartial> partials(taskCount);
+    m_pool.parallelFor(taskCount, [&](size_t task, unsigned) {
+        EnsemblePartial& partial = partials[task];
+        partial.samples.resize(sampleCount);
+        partial.histogram.assign(bins, 0);
+
+        std::mt19937_64 generator = makeTaskGenerator(settings.seed, task);
+        Calculations calculator;
+        calculator.setEventMessages(false);
+
+        const size_t end = std::min(settings.runs, (task + 1) * RUNS_PER_TASK);
+        for (size_t runIndex = task * RUNS_PER_TASK; runIndex < end; ++runIndex) {
+            if (control && control->cancelRequested.load(std::memory_order_relaxed)) return;
+
+            const SimulationParameters params = samplePerturbed(nominal, dispersion, generator);
+            EnsembleStatisticsSink statistics(sampleSteps, partial.samples);
+            calculator.runSimulation(params, statistics);
+            ++partial.runs;
+
+            //         (  SummarySink)
+            const State& last = statistics.getLastState();
+            if (statistics.getPointCount() > 0
+                && last.x * last.x + last.y * last.y < params.CENTRAL_BODY_RADIUS * params.CENTRAL_BODY_RADIUS) {
+                const double impactTime = static_cast<double>(statistics.getPointCount() - 1) * params.DT;
+                partial.impactTimes.add(impactTime);
+                const size_t bin = static_cast<size_t>(impactTime / result.histogramBinWidth);
+                ++partial.histogram[std::min(bin, bins - 1)];
+            }
+            if (control) control->completedSteps.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    //    :     ,    
+    std::vector<RunningCovariance2D> samples(sampleCount);
+    RunningStatistics impactTimes;
+    result.impactTimeHistogram.assign(bins, 0);
+    for (const EnsemblePartial& partial : partials) {
+        result.runs += partial.runs;
+        if (partial.samples.empty()) continue; //    ()
+        for (size_t k = 0; k < sampleCount; ++k) samples[k].merge(partial.samples[k]);
+        for (size_t b = 0; b < bins; ++b) result.impactTimeHistogram[b] += partial.histogram[b];
+        impactTimes.merge(partial.impactTimes);
+    }
+
+    result.impacts = impactTimes.count;
+    result.impactProbability = (result.runs > 0) ? static_cast<double>(result.impacts) / static_cast<double>(result.runs) : 0.0;
+    result.meanImpactTime = impactTimes.mean;
+    result.impactTimeStdDev = (impactTimes.count > 1) ? std::sqrt(impactTimes.m2 / static_cast<double>(impactTimes.count - 1)) : 0.0;
+
+    result.samples.resize(sampleCount);
+    for (size_t k = 0; k < sampleCount; ++k) {
+        EnsembleTimeSample& sample = result.samples[k];
+        sample.time = static_cast<double>(sampleSteps[k]) * nominal.DT;
+        sample.count = samples[k].count();
+        sample.meanX = samples[k].meanX();
+        sample.meanY = samples[k].meanY();
+        sample.varianceX = samples[k].varianceX();
+        sample.varianceY = samples[k].varianceY();
+        sample.covarianceXY = samples[k].covarianceXY();
+    }
+    return result;
+}
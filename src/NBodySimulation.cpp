@@ -0,0 +1,486 @@
+#include "../include/NBodySimulation.h"
+#include "../include/CsvExport.h" //    ,   CSV  
+
+#include <algorithm> //  std::partition, std::min, std::max
+#include <charconv>  //  std::to_chars
+#include <cmath>     //  std::sqrt, std::cos, std::sin, std::abs
+#include <iostream>
+#include <random>
+#include <sstream>   //  std::istringstream
+
+// --- NBodySystem ---
+void NBodySystem::addBody(double bodyMass, const State& state) {
+    x.push_back(state.x);
+    y.push_back(state.y);
+    vx.push_back(state.vx);
+    vy.push_back(state.vy);
+    mass.push_back(bodyMass);
+}
+
+// --- NBodyTrackSink ---
+void NBodyTrackSink::begin(const NBodyParameters& params, const NBodySystem& system) {
+    (void)params;
+    m_tracks.assign(system.size(), WorldTrajectoryData());
+}
+
+void NBodyTrackSink::consumeFrame(size_t step, const NBodySystem& system) {
+    (void)step;
+    for (size_t body = 0; body < m_tracks.size(); ++body) {
+        m_tracks[body].emplace_back(system.x[body], system.y[body]);
+    }
+}
+
+// --- NBodyCsvSink ---
+namespace {
+    constexpr size_t CSV_BUFFER_SIZE = size_t(1) << 20;
+    constexpr size_t CSV_MAX_ROW_LENGTH = 2048; //   CsvTrajectoryWriter: 4   1e308  fixed   
+}
+
+NBodyCsvSink::NBodyCsvSink(const std::string& path)
+    : m_file(path, std::ios::binary),
+    m_out(&m_file),
+    m_buffer(CSV_BUFFER_SIZE),
+    m_used(0),
+    m_failed(false) {
+    if (!m_file.is_open()) {
+        std::cerr << "NBodyCsvSink: Could not open file '" << path << "' for writing." << std::endl;
+        m_failed = true;
+    }
+}
+
+NBodyCsvSink::NBodyCsvSink(std::ostream& out)
+    : m_out(&out),
+    m_buffer(CSV_BUFFER_SIZE),
+    m_used(0),
+    m_failed(false) {
+}
+
+void NBodyCsvSink::begin(const NBodyParameters& params, const NBodySystem& system) {
+    (void)params;
+    (void)system;
+    if (m_failed) return;
+    *m_out << "Step_Index,Body,x_dimless,y_dimless,vx_dimless,vy_dimless\n";
+}
+
+void NBodyCsvSink::consumeFrame(size_t step, const NBodySystem& system) {
+    if (m_failed) return;
+    for (size_t body = 0; body < system.size(); ++body) {
+        if (m_used + CSV_MAX_ROW_LENGTH > m_buffer.size()) flushBuffer();
+        char* out = m_buffer.data() + m_used;
+        char* last = m_buffer.data() + m_buffer.size();
+        out = std::to_chars(out, last, step).ptr;
+        *out++ = ',';
+        out = std::to_chars(out, last, body).ptr;
+        const double values[] = { system.x[body], system.y[body], system.vx[body], system.vy[body] };
+        for (double value : values) {
+            *out++ = ',';
+            out = std::to_chars(out, last, value, std::chars_format::fixed, CsvTrajectoryWriter::PRECISION).ptr;
+        }
+        *out++ = '\n';
+        m_used = static_cast<size_t>(out - m_buffer.data());
+    }
+}
+
+void NBodyCsvSink::end() {
+    if (m_failed) return;
+    flushBuffer();
+    if (m_out == &m_file) m_file.close();
+    else m_out->flush();
+    if (m_out->fail()) {
+        std::cerr << "NBodyCsvSink: Failed to write or close the output file." << std::endl;
+        m_failed = true;
+    }
+}
+
+void NBodyCsvSink::flushBuffer() {
+    m_out->write(m_buffer.data(), static_cast<std::streamsize>(m_used));
+    m_used = 0;
+}
+
+// --- NBodySimulation ---
+NBodySimulation::NBodySimulation(unsigned threadCount)
+    : m_pool(threadCount) {
+}
+
+bool NBodySimulation::validate(const NBodyParameters& params) {
+    if (!(params.DT > 0.0) || params.STEPS < 0 || params.outputInterval <= 0) {
+        std::cerr << "NBodySimulation: DT must be positive, STEPS non-negative and the output interval positive." << std::endl;
+        return false;
+    }
+    if (!(params.theta >= 0.0) || !(params.softening >= 0.0)) {
+        std::cerr << "NBodySimulation: theta and softening must be non-negative." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool NBodySimulation::run(const NBodyParameters& params, NBodySystem& system, NBodyFrameSink& sink, SimulationControl* control) {
+    if (!validate(params)) return false;
+    m_stats = NBodyStats();
+
+    const size_t count = system.size();
+    const double halfDt = 0.5 * params.DT;
+    std::vector<double> ax, ay;
+    computeAccelerations(params, system, ax, ay);
+
+    sink.begin(params, system);
+    sink.consumeFrame(0, system);
+    for (int step = 1; step <= params.STEPS; ++step) {
+        //   ,      ,    ,  
+        for (size_t i = 0; i < count; ++i) {
+            system.vx[i] += halfDt * ax[i];
+            system.vy[i] += halfDt * ay[i];
+            system.x[i] += params.DT * system.vx[i];
+            system.y[i] += params.DT * system.vy[i];
+        }
+        computeAccelerations(params, system, ax, ay);
+        for (size_t i = 0; i < count; ++i) {
+            system.vx[i] += halfDt * ax[i];
+            system.vy[i] += halfDt * ay[i];
+        }
+
+        const bool cancelled = control && control->cancelRequested.load(std::memory_order_relaxed);
+        if (step % params.outputInterval == 0 || step == params.STEPS || cancelled) {
+            sink.consumeFrame(static_cast<size_t>(step), system);
+        }
+        if (control) control->completedSteps.store(step, std::memory_order_relaxed);
+        if (cancelled) break;
+    }
+    sink.end();
+    return true;
+}
+
+void NBodySimulation::computeAccelerations(const NBodyParameters& params, const NBodySystem& system, std::vector<double>& ax, std::vector<double>& ay) {
+    const size_t count = system.size();
+    if (count <= params.directSumThreshold || count < 2) {
+        computeAccelerationsDirect(params, system, ax, ay);
+        return;
+    }
+    ++m_stats.forceEvaluations;
+    buildTree(system);
+    m_stats.treeNodes = m_nodes.size();
+
+    //     :        ,
+    //  ,   ,   
+    ax.resize(count);
+    ay.resize(count);
+    const double G = params.G;
+    const double theta = params.theta;
+    const double softeningSquared = params.softening * params.softening;
+    const size_t taskCount = (count + BODIES_PER_TASK - 1) / BODIES_PER_TASK;
+    m_pool.parallelFor(taskCount, [&](size_t task, unsigned) {
+        const size_t end = std::min(count, (task + 1) * BODIES_PER_TASK);
+        for (size_t k = task * BODIES_PER_TASK; k < end; ++k) {
+            double bodyAx = 0.0;
+            double bodyAy = 0.0;
+            accumulateTreeForce(k, G, theta, softeningSquared, bodyAx, bodyAy);
+            ax[m_order[k]] = bodyAx;
+            ay[m_order[k]] = bodyAy;
+        }
+    });
+}
+
+void NBodySimulation::computeAccelerationsDirect(const NBodyParameters& params, const NBodySystem& system, std::vector<double>& ax, std::vector<double>& ay) {
+    ++m_stats.forceEvaluations;
+    m_stats.treeNodes = 0;
+
+    const size_t count = system.size();
+    ax.resize(count);
+    ay.resize(count);
+    const double G = params.G;
+    const double softeningSquared = params.softening * params.softening;
+    const double* x = system.x.data();
+    const double* y = system.y.data();
+    const double* mass = system.mass.data();
+    const size_t taskCount = (count + BODIES_PER_TASK - 1) / BODIES_PER_TASK;
+    m_pool.parallelFor(taskCount, [&](size_t task, unsigned) {
+        const size_t end = std::min(count, (task + 1) * BODIES_PER_TASK);
+        for (size_t i = task * BODIES_PER_TASK; i < end; ++i) {
+            double bodyAx = 0.0;
+            double bodyAy = 0.0;
+            for (size_t j = 0; j < count; ++j) {
+                if (j == i) continue;
+                double dx = x[j] - x[i];
+                double dy = y[j] - y[i];
+                double inverse = 1.0 / (dx * dx + dy * dy + softeningSquared);
+                double factor = mass[j] * inverse * std::sqrt(inverse);
+                bodyAx += factor * dx;
+                bodyAy += factor * dy;
+            }
+            ax[i] = G * bodyAx;
+            ay[i] = G * bodyAy;
+        }
+    });
+}
+
+double NBodySimulation::computeEnergy(const NBodyParameters& params, const NBodySystem& system) {
+    const size_t count = system.size();
+    const double softeningSquared = params.softening * params.softening;
+    const size_t taskCount = (count + BODIES_PER_TASK - 1) / BODIES_PER_TASK;
+    //       :      
+    std::vector<double> partial(taskCount, 0.0);
+    m_pool.parallelFor(taskCount, [&](size_t task, unsigned) {
+        const size_t end = std::min(count, (task + 1) * BODIES_PER_TASK);
+        double sum = 0.0;
+        for (size_t i = task * BODIES_PER_TASK; i < end; ++i) {
+            sum += 0.5 * system.mass[i] * (system.vx[i] * system.vx[i] + system.vy[i] * system.vy[i]);
+            if (system.mass[i] == 0.0) continue;
+            double potential = 0.0;
+            for (size_t j = i + 1; j < count; ++j) {
+                double dx = system.x[j] - system.x[i];
+                double dy = system.y[j] - system.y[i];
+                potential += system.mass[j] / std::sqrt(dx * dx + dy * dy + softeningSquared);
+            }
+            sum -= params.G * system.mass[i] * potential;
+        }
+        partial[task] = sum;
+    });
+    double energy = 0.0;
+    for (double value : partial) energy += value;
+    return energy;
+}
+
+void NBodySimulation::buildTree(const NBodySystem& system) {
+    const size_t count = system.size();
+    m_order.resize(count);
+    for (size_t i = 0; i < count; ++i) m_order[i] = static_cast<std::uint32_t>(i);
+
+    double minX = system.x[0], maxX = system.x[0];
+    double minY = system.y[0], maxY = system.y[0];
+    for (size_t i = 1; i < count; ++i) {
+        minX = std::min(minX, system.x[i]);
+        maxX = std::max(maxX, system.x[i]);
+        minY = std::min(minY, system.y[i]);
+        maxY = std::max(maxY, system.y[i]);
+    }
+
+    m_nodes.clear();
+    m_nodes.reserve(2 * count / LEAF_CAPACITY + 1);
+    TreeNode root{};
+    root.centerX = 0.5 * (minX + maxX);
+    root.centerY = 0.5 * (minY + maxY);
+    root.halfSize = 0.5 * std::max(maxX - minX, maxY - minY);
+    root.first = 0;
+    root.count = static_cast<std::uint32_t>(count);
+    m_nodes.push_back(root);
+    buildNode(system, 0, 0);
+
+    //       :     
+    m_sortedX.resize(count);
+    m_sortedY.resize(count);
+    m_sortedMass.resize(count);
+    for (size_t k = 0; k < count; ++k) {
+        m_sortedX[k] = system.x[m_order[k]];
+        m_sortedY[k] = system.y[m_order[k]];
+        m_sortedMass[k] = system.mass[m_order[k]];
+    }
+}
+
+void NBodySimulation::buildNode(const NBodySystem& system, std::uint32_t nodeIndex, unsigned depth) {
+    // m_nodes     :    
+    const TreeNode node = m_nodes[nodeIndex];
+    std::uint32_t* first = m_order.data() + node.first;
+    std::uint32_t* last = first + node.count;
+
+    if (node.count <= LEAF_CAPACITY || depth >= MAX_TREE_DEPTH) {
+        double mass = 0.0, momentX = 0.0, momentY = 0.0;
+        for (const std::uint32_t* body = first; body != last; ++body) {
+            mass += system.mass[*body];
+            momentX += system.mass[*body] * system.x[*body];
+            momentY += system.mass[*body] * system.y[*body];
+        }
+        TreeNode& leaf = m_nodes[nodeIndex];
+        leaf.firstChild = -1;
+        leaf.childCount = 0;
+        leaf.mass = mass;
+        leaf.massX = (mass > 0.0) ? momentX / mass : node.centerX;
+        leaf.massY = (mass > 0.0) ? momentY / mass : node.centerY;
+        return;
+    }
+
+    //   :   y,     x
+    std::uint32_t* middleY = std::partition(first, last, [&](std::uint32_t body) { return system.y[body] < node.centerY; });
+    std::uint32_t* bounds[5] = {
+        first,
+        std::partition(first, middleY, [&](std::uint32_t body) { return system.x[body] < node.centerX; }),
+        middleY,
+        std::partition(middleY, last, [&](std::uint32_t body) { return system.x[body] < node.centerX; }),
+        last
+    };
+
+    const double quarter = 0.5 * node.halfSize;
+    const std::int32_t firstChild = static_cast<std::int32_t>(m_nodes.size());
+    for (int q = 0; q < 4; ++q) {
+        if (bounds[q] == bounds[q + 1]) continue;
+        TreeNode child{};
+        child.centerX = node.centerX + ((q & 1) ? quarter : -quarter);
+        child.centerY = node.centerY + ((q & 2) ? quarter : -quarter);
+        child.halfSize = quarter;
+        child.first = static_cast<std::uint32_t>(bounds[q] - m_order.data());
+        child.count = static_cast<std::uint32_t>(bounds[q + 1] - bounds[q]);
+        m_nodes.push_back(child);
+    }
+    const std::uint32_t childCount = static_cast<std::uint32_t>(m_nodes.size()) - static_cast<std::uint32_t>(firstChild);
+
+    double mass = 0.0, momentX = 0.0, momentY = 0.0;
+    for (std::uint32_t c = 0; c < childCount; ++c) {
+        const std::uint32_t childIndex = static_cast<std::uint32_t>(firstChild) + c;
+        buildNode(system, childIndex, depth + 1);
+        const TreeNode& child = m_nodes[childIndex];
+        mass += child.mass;
+        momentX += child.mass * child.massX;
+        momentY += child.mass * child.massY;
+    }
+    TreeNode& parent = m_nodes[nodeIndex];
+    parent.firstChild = firstChild;
+    parent.childCount = childCount;
+    parent.mass = mass;
+    parent.massX = (mass > 0.0) ? momentX / mass : node.centerX;
+    parent.massY = (mass > 0.0) ? momentY / mass : node.centerY;
+}
+
+void NBodySimulation::accumulateTreeForce(size_t sortedIndex, double G, double theta, double softeningSquared, double& ax, double& ay) const {
+    const double px = m_sortedX[sortedIndex];
+    const double py = m_sortedY[sortedIndex];
+    const double thetaSquared = theta * theta;
+    double sumX = 0.0;
+    double sumY = 0.0;
+
+    //     :         
+    std::uint32_t stack[4 * MAX_TREE_DEPTH + 4];
+    unsigned stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+        const TreeNode& node = m_nodes[stack[--stackSize]];
+        if (node.mass == 0.0) continue;
+
+        if (node.firstChild < 0) {
+            for (std::uint32_t k = node.first; k < node.first + node.count; ++k) {
+                if (k == sortedIndex) continue;
+                double dx = m_sortedX[k] - px;
+                double dy = m_sortedY[k] - py;
+                double inverse = 1.0 / (dx * dx + dy * dy + softeningSquared);
+                double factor = m_sortedMass[k] * inverse * std::sqrt(inverse);
+                sumX += factor * dx;
+                sumY += factor * dy;
+            }
+            continue;
+        }
+
+        //    ,            
+        double dx = node.massX - px;
+        double dy = node.massY - py;
+        double distanceSquared = dx * dx + dy * dy;
+        double size = 2.0 * node.halfSize;
+        bool inside = std::abs(px - node.centerX) <= node.halfSize && std::abs(py - node.centerY) <= node.halfSize;
+        if (!inside && size * size < thetaSquared * distanceSquared) {
+            double inverse = 1.0 / (distanceSquared + softeningSquared);
+            double factor = node.mass * inverse * std::sqrt(inverse);
+            sumX += factor * dx;
+            sumY += factor * dy;
+            continue;
+        }
+        for (std::uint32_t c = 0; c < node.childCount; ++c) {
+            stack[stackSize++] = static_cast<std::uint32_t>(node.firstChild) + c;
+        }
+    }
+    ax = G * sumX;
+    ay = G * sumY;
+}
+
+void NBodySimulation::addDebrisRing(NBodySystem& system, double G, size_t centralBody, size_t count,
+    double innerRadius, double outerRadius, double particleMass, std::uint32_t seed) {
+    const double centralMass = system.mass[centralBody];
+    const State center = system.getState(centralBody);
+    const double PI = std::acos(-1.0);
+
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    for (size_t i = 0; i < count; ++i) {
+        //   : r^2    inner^2  outer^2
+        double r = std::sqrt(innerRadius * innerRadius + uniform(generator) * (outerRadius * outerRadius - innerRadius * innerRadius));
+        double angle = 2.0 * PI * uniform(generator);
+        double speed = std::sqrt(G * centralMass / r); //      
+        double c = std::cos(angle);
+        double s = std::sin(angle);
+        system.addBody(particleMass, { center.x + r * c, center.y + r * s, center.vx - speed * s, center.vy + speed * c });
+    }
+}
+
+bool NBodySimulation::loadScenario(const std::string& path, NBodyParameters& params, NBodySystem& system) {
+    std::ifstream inFile(path);
+    if (!inFile.is_open()) {
+        std::cerr << "Error: Could not open N-body scenario '" << path << "'." << std::endl;
+        return false;
+    }
+
+    //      :        
+    struct Ring {
+        size_t count;
+        double innerRadius, outerRadius, mass;
+        std::uint32_t seed;
+    };
+    std::vector<Ring> rings;
+    params = NBodyParameters();
+    system = NBodySystem();
+
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(inFile, line)) {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r') line.pop_back(); // ,   Windows
+        size_t commentPos = line.find('#');
+        if (commentPos != std::string::npos) line.erase(commentPos);
+        size_t delimiterPos = line.find('=');
+        if (delimiterPos == std::string::npos) continue;
+
+        const std::string key = line.substr(0, delimiterPos);
+        std::istringstream value(line.substr(delimiterPos + 1));
+        value.imbue(std::locale::classic());
+        bool ok = true;
+        if (key == "G") ok = static_cast<bool>(value >> params.G);
+        else if (key == "dt") ok = static_cast<bool>(value >> params.DT);
+        else if (key == "steps") ok = static_cast<bool>(value >> params.STEPS);
+        else if (key == "output_every") ok = static_cast<bool>(value >> params.outputInterval);
+        else if (key == "theta") ok = static_cast<bool>(value >> params.theta);
+        else if (key == "softening") ok = static_cast<bool>(value >> params.softening);
+        else if (key == "direct_threshold") ok = static_cast<bool>(value >> params.directSumThreshold);
+        else if (key == "body") {
+            double bodyMass;
+            State state;
+            ok = static_cast<bool>(value >> bodyMass >> state.x >> state.y >> state.vx >> state.vy) && bodyMass >= 0.0;
+            if (ok) system.addBody(bodyMass, state);
+        }
+        else if (key == "ring") {
+            Ring ring{ 0, 0.0, 0.0, 0.0, 1 };
+            ok = static_cast<bool>(value >> ring.count >> ring.innerRadius >> ring.outerRadius >> ring.mass)
+                && ring.innerRadius > 0.0 && ring.outerRadius >= ring.innerRadius && ring.mass >= 0.0;
+            if (ok && !(value >> ring.seed)) ring.seed = static_cast<std::uint32_t>(rings.size() + 1);
+            if (ok) rings.push_back(ring);
+        }
+        else {
+            std::cerr << "Warning: unknown key '" << key << "' in '" << path << "', line " << lineNumber << "." << std::endl;
+        }
+        if (!ok) {
+            std::cerr << "Error: invalid value for '" << key << "' in '" << path << "', line " << lineNumber << "." << std::endl;
+            return false;
+        }
+    }
+
+    if (!rings.empty() && (system.size() == 0 || system.mass[0] <= 0.0)) {
+        std::cerr << "Error: 'ring' in '" << path << "' needs a massive first 'body' to orbit." << std::endl;
+        return false;
+    }
+    for (const Ring& ring : rings) {
+        addDebrisRing(system, params.G, 0, ring.count, ring.innerRadius, ring.outerRadius, ring.mass, ring.seed);
+    }
+    if (system.size() == 0) {
+        std::cerr << "Error: N-body scenario '" << path << "' has no bodies." << std::endl;
+        return false;
+    }
+    if (system.size() > UINT32_MAX) {
+        std::cerr << "Error: too many bodies in '" << path << "'." << std::endl;
+        return false;
+    }
+    return validate(params);
+}
@@ -0,0 +1,163 @@
+#include "../include/ParameterSweep.h"
+#include "../include/BatchIntegrator.h"
+
+#include <algorithm> //  std::min, std::max
+#include <cmath>     //  std::sqrt, std::fabs
+#include <map>       //    DT
+
+namespace {
+    // ,  TrajectoryBatch   ,  Calculations
+    bool isBatchable(const SimulationParameters& params) {
+        return params.integrator == IntegratorType::RK4 && !params.perturbations.hasAny();
+    }
+}
+
+// --- SummarySink ---
+void SummarySink::begin(const SimulationParameters& params) {
+    m_params = params;
+    m_summary = SweepRunSummary();
+    m_lastState = { params.initialState.x, params.initialState.y, params.initialState.vx, params.initialState.vy };
+    m_summary.initialEnergy = Calculations::specificEnergy(m_lastState, params);
+}
+
+void SummarySink::consume(size_t firstIndex, const State* states, size_t count) {
+    if (count == 0) return;
+    double minR2 = (firstIndex == 0) ? states[0].x * states[0].x + states[0].y * states[0].y : m_summary.minR * m_summary.minR;
+    double maxR2 = (firstIndex == 0) ? minR2 : m_summary.maxR * m_summary.maxR;
+    for (size_t i = 0; i < count; ++i) {
+        double r2 = states[i].x * states[i].x + states[i].y * states[i].y;
+        minR2 = std::min(minR2, r2);
+        maxR2 = std::max(maxR2, r2);
+    }
+    m_summary.minR = std::sqrt(minR2);
+    m_summary.maxR = std::sqrt(maxR2);
+    m_summary.pointCount = firstIndex + count;
+    m_lastState = states[count - 1];
+}
+
+void SummarySink::end() {
+    const State& s = m_lastState;
+    m_summary.finalR = std::sqrt(s.x * s.x + s.y * s.y);
+    if (m_summary.pointCount > 0 && m_summary.finalR < m_params.CENTRAL_BODY_RADIUS) {
+        m_summary.impactStep = static_cast<long long>(m_summary.pointCount) - 1;
+    }
+    m_summary.finalEnergy = Calculations::specificEnergy(s, m_params);
+    double e0 = std::fabs(m_summary.initialEnergy);
+    m_summary.energyDrift = std::fabs(m_summary.finalEnergy - m_summary.initialEnergy) / (e0 > 0.0 ? e0 : 1.0);
+}
+
+// --- ParameterSweep ---
+ParameterSweep::ParameterSweep(unsigned threadCount)
+    : m_pool(threadCount) {
+}
+
+std::vector<SweepRunSummary> ParameterSweep::run(const std::vector<SimulationParameters>& runs, SimulationControl* control) {
+    std::vector<SweepRunSummary> summaries(runs.size());
+    if (control) control->completedSteps.store(0, std::memory_order_relaxed);
+
+    m_pool.parallelFor(runs.size(), [&](size_t index, unsigned) {
+        summaries[index].runIndex = index;
+        if (control && control->cancelRequested.load(std::memory_order_relaxed)) return;
+
+        //     : Calculations   
+        Calculations calculator;
+        SummarySink summary;
+        calculator.runSimulation(runs[index], summary);
+        summaries[index] = summary.getSummary();
+        summaries[index].runIndex = index;
+
+        if (control) control->completedSteps.fetch_add(1, std::memory_order_relaxed);
+    });
+    return summaries;
+}
+
+std::vector<SweepRunSummary> ParameterSweep::runBatched(const std::vector<SimulationParameters>& runs, SimulationControl* control) {
+    std::vector<SweepRunSummary> summaries(runs.size());
+    if (control) control->completedSteps.store(0, std::memory_order_relaxed);
+
+    //  -   RK4-   DT,     
+    //    (      (F - k) * v)
+    std::map<double, std::vector<size_t>> rk4ByDT;
+    std::vector<std::vector<size_t>> tasks;
+    for (size_t i = 0; i < runs.size(); ++i) {
+        if (isBatchable(runs[i])) rk4ByDT[runs[i].DT].push_back(i);
+        else tasks.push_back({ i });
+    }
+    for (const auto& group : rk4ByDT) {
+        const std::vector<size_t>& indices = group.second;
+        for (size_t begin = 0; begin < indices.size(); begin += BATCH_LANES) {
+            size_t end = std::min(indices.size(), begin + BATCH_LANES);
+            tasks.emplace_back(indices.begin() + begin, indices.begin() + end);
+        }
+    }
+
+    m_pool.parallelFor(tasks.size(), [&](size_t taskIndex, unsigned) {
+        const std::vector<size_t>& indices = tasks[taskIndex];
+        if (control && control->cancelRequested.load(std::memory_order_relaxed)) return;
+
+        if (!isBatchable(runs[indices.front()])) {
+            Calculations calculator;
+            SummarySink summary;
+            calculator.runSimulation(runs[indices.front()], summary);
+            summaries[indices.front()] = summary.getSummary();
+            summaries[indices.front()].runIndex = indices.front();
+            if (control) control->completedSteps.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        std::vector<SimulationParameters> batchRuns;
+        batchRuns.reserve(indices.size());
+        long long maxSteps = 0;
+        for (size_t index : indices) {
+            batchRuns.push_back(runs[index]);
+            maxSteps = std::max<long long>(maxSteps, runs[index].STEPS);
+        }
+
+        TrajectoryBatch batch(batchRuns);
+        batch.advance(maxSteps);
+
+        for (size_t lane = 0; lane < indices.size(); ++lane) {
+            const SimulationParameters& params = batchRuns[lane];
+            State initial = { params.initialState.x, params.initialState.y, params.initialState.vx, params.initialState.vy };
+            State last = batch.getState(lane);
+
+            SweepRunSummary& summary = summaries[indices[lane]];
+            summary.runIndex = indices[lane];
+            summary.pointCount = static_cast<size_t>(batch.getStepsTaken(lane)) + 1;
+            summary.impactStep = batch.getImpactStep(lane);
+            summary.finalR = std::sqrt(last.x * last.x + last.y * last.y);
+            summary.minR = batch.getMinR(lane);
+            summary.maxR = batch.getMaxR(lane);
+            summary.initialEnergy = Calculations::specificEnergy(initial, params);
+            summary.finalEnergy = Calculations::specificEnergy(last, params);
+            double e0 = std::fabs(summary.initialEnergy);
+            summary.energyDrift = std::fabs(summary.finalEnergy - summary.initialEnergy) / (e0 > 0.0 ? e0 : 1.0);
+        }
+        if (control) control->completedSteps.fetch_add(static_cast<int>(indices.size()), std::memory_order_relaxed);
+    });
+    return summaries;
+}
+
+std::vector<SimulationParameters> ParameterSweep::makeGrid(const SimulationParameters& base,
+    const std::vector<double>& vyValues,
+    const std::vector<double>& dragValues,
+    const std::vector<double>& thrustValues) {
+    const std::vector<double> vys = vyValues.empty() ? std::vector<double>{ base.initialState.vy } : vyValues;
+    const std::vector<double> drags = dragValues.empty() ? std::vector<double>{ base.DRAG_COEFFICIENT } : dragValues;
+    const std::vector<double> thrusts = thrustValues.empty() ? std::vector<double>{ base.THRUST_COEFFICIENT } : thrustValues;
+
+    std::vector<SimulationParameters> grid;
+    grid.reserve(vys.size() * drags.size() * thrusts.size());
+    for (double vy : vys) {
+        for (double drag : drags) {
+            for (double thrust : thrusts) {
+                SimulationParameters params = base;
+                params.initialState.vy = vy;
+                params.DRAG_COEFFICIENT = drag;
+                params.THRUST_COEFFICIENT = thrust;
+                grid.push_back(params);
+            }
+        }
+    }
+    return grid;
+}
@@ -0,0 +1,310 @@
+#include "../include/SimulationCache.h"
+#include "../include/TrajectoryFile.h" //       *.trjb
+
+#include <algorithm>  //  std::sort
+#include <cstring>    //  std::memcpy
+#include <cstdio>     //  std::snprintf
+#include <filesystem>
+#include <iostream>
+#include <system_error>
+
+namespace {
+
+    constexpr std::uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    constexpr std::uint64_t FNV_PRIME = 1099511628211ULL;
+
+    void appendU64(std::vector<unsigned char>& out, std::uint64_t v) {
+        for (int i = 0; i < 8; ++i) out.push_back(static_cast<unsigned char>(v >> (8 * i)));
+    }
+
+    void appendF64(std::vector<unsigned char>& out, double v) {
+        if (v == 0.0) v = 0.0; // -0.0  0.0   
+        std::uint64_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        appendU64(out, bits);
+    }
+
+    size_t getStatesBytes(const std::vector<State>& states) {
+        return states.size() * sizeof(State);
+    }
+
+    //      *.trjb;    
+    bool writeTrajectoryFile(const std::string& path, const SimulationParameters& params, const State* states, size_t count) {
+        BinaryTrajectorySink file(path);
+        file.begin(params);
+        file.consume(0, states, count);
+        file.end();
+        if (!file.hasFailed()) return true;
+        std::error_code error;
+        std::filesystem::remove(std::filesystem::u8path(path), error);
+        return false;
+    }
+
+} // namespace
+
+SimulationCache::SimulationCache(const std::string& diskDirectory, size_t memoryLimitBytes, std::uintmax_t diskLimitBytes)
+    : m_diskDirectory(diskDirectory),
+    m_memoryLimitBytes(memoryLimitBytes),
+    m_diskLimitBytes(diskLimitBytes) {
+}
+
+std::vector<unsigned char> SimulationCache::serializeParameters(const SimulationParameters& params) {
+    std::vector<unsigned char> out;
+    out.reserve(24 * 8);
+    appendU64(out, INTEGRATOR_VERSION);
+    appendU64(out, sizeof(State));
+    appendU64(out, static_cast<std::uint64_t>(params.integrator));
+    appendU64(out, static_cast<std::uint64_t>(static_cast<std::int64_t>(params.STEPS)));
+
+    const double values[] = {
+        params.G, params.M, params.CENTRAL_BODY_RADIUS, params.DRAG_COEFFICIENT, params.THRUST_COEFFICIENT, params.DT,
+        params.initialState.x, params.initialState.y, params.initialState.vx, params.initialState.vy
+    };
+    for (double value : values) appendF64(out, value);
+
+    // RK4     :     
+    if (params.integrator == IntegratorType::DormandPrince45) {
+        const double adaptive[] = {
+            params.adaptive.rtol, params.adaptive.atol, params.adaptive.minStep, params.adaptive.maxStep, params.adaptive.initialStep
+        };
+        for (double value : adaptive) appendF64(out, value);
+    }
+    //     ,     :    
+    if (params.perturbations.hasAny()) {
+        const double perturbations[] = {
+            params.perturbations.J2, params.perturbations.atmosphereDrag, params.perturbations.atmosphereScaleHeight,
+            params.perturbations.thrustAcceleration, params.perturbations.thrustAngle
+        };
+        for (double value : perturbations) appendF64(out, value);
+    }
+    return out;
+}
+
+std::uint64_t SimulationCache::makeKey(const SimulationParameters& params) {
+    std::uint64_t hash = FNV_OFFSET_BASIS;
+    for (unsigned char byte : serializeParameters(params)) {
+        hash ^= byte;
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+bool SimulationCache::find(const SimulationParameters& params, StatesPtr& states) {
+    std::vector<unsigned char> canonical = serializeParameters(params);
+    std::uint64_t key = makeKey(params);
+
+    if (findInMemory(key, canonical, states) || loadFromDisk(key, canonical, states)) {
+        ++m_hits;
+        return true;
+    }
+    ++m_misses;
+    return false;
+}
+
+bool SimulationCache::findExtendable(const SimulationParameters& params, const std::string& prefixPath, SimulationCheckpoint& from) {
+    if (params.integrator != IntegratorType::RK4) return false;
+    auto isExtendable = [&params](const SimulationParameters& stored, size_t count) {
+        return stored.STEPS < params.STEPS && count == static_cast<size_t>(stored.STEPS) + 1
+            && Calculations::sameModel(stored, params);
+    };
+
+    const Entry* best = nullptr;
+    for (const Entry& entry : m_entries) {
+        if (isExtendable(entry.params, entry.states->size()) && (!best || entry.params.STEPS > best->params.STEPS)) best = &entry;
+    }
+    int bestSteps = best ? best->params.STEPS : -1;
+
+    //       ,    ;  
+    //   ,    
+    std::string bestPath;
+    if (!m_diskDirectory.empty()) {
+        std::error_code error;
+        for (std::filesystem::directory_iterator it(std::filesystem::u8path(m_diskDirectory), error), end; !error && it != end; it.increment(error)) {
+            const std::string path = it->path().u8string();
+            if (!TrajectoryFile::hasBinaryExtension(path)) continue;
+            MappedTrajectoryFile file;
+            if (!file.open(path)) continue;
+            if (isExtendable(file.getParameters(), file.size()) && file.getParameters().STEPS > bestSteps) {
+                bestSteps = file.getParameters().STEPS;
+                bestPath = path;
+            }
+        }
+    }
+
+    MappedTrajectoryFile file;
+    const State* states = nullptr;
+    size_t count = 0;
+    if (!bestPath.empty()) {
+        if (!file.open(bestPath)) return false;
+        states = file.data();
+        count = file.size();
+        std::error_code error;
+        std::filesystem::copy_file(std::filesystem::u8path(bestPath), std::filesystem::u8path(prefixPath),
+            std::filesystem::copy_options::overwrite_existing, error);
+        if (error) {
+            std::cerr << "SimulationCache: Could not copy '" << bestPath << "' to '" << prefixPath << "': " << error.message() << std::endl;
+            return false;
+        }
+    }
+    else if (best) {
+        states = best->states->data();
+        count = best->states->size();
+        if (!writeTrajectoryFile(prefixPath, best->params, states, count)) return false;
+    }
+    else {
+        return false;
+    }
+
+    from.params = params;
+    from.params.STEPS = static_cast<int>(count - 1);
+    from.stepIndex = count - 1;
+    from.state = states[count - 1];
+    return true;
+}
+
+void SimulationCache::store(const SimulationParameters& params, StatesPtr states) {
+    if (!states || states->empty()) return;
+    std::uint64_t key = makeKey(params);
+    storeOnDisk(key, params, *states);
+    storeInMemory(key, params, serializeParameters(params), std::move(states));
+}
+
+std::string SimulationCache::getTemporaryPath(const SimulationParameters& params) {
+    if (m_diskDirectory.empty()) return std::string();
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::u8path(m_diskDirectory), error);
+    if (error) {
+        std::cerr << "SimulationCache: Could not create directory '" << m_diskDirectory << "': " << error.message() << std::endl;
+        return std::string();
+    }
+    return getDiskPath(makeKey(params)) + ".tmp";
+}
+
+std::string SimulationCache::storeFile(const SimulationParameters& params, const std::string& temporaryPath) {
+    if (m_diskDirectory.empty()) return std::string();
+    return moveIntoCache(makeKey(params), temporaryPath);
+}
+
+void SimulationCache::clearMemory() {
+    m_entries.clear();
+    m_index.clear();
+    m_memoryBytes = 0;
+}
+
+std::string SimulationCache::getDiskPath(std::uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+    return (std::filesystem::u8path(m_diskDirectory) / (std::string(name) + TrajectoryFile::EXTENSION)).u8string();
+}
+
+bool SimulationCache::findInMemory(std::uint64_t key, const std::vector<unsigned char>& canonical, StatesPtr& states) {
+    auto found = m_index.find(key);
+    if (found == m_index.end() || found->second->canonical != canonical) return false;
+    m_entries.splice(m_entries.begin(), m_entries, found->second);
+    states = found->second->states;
+    return true;
+}
+
+bool SimulationCache::loadFromDisk(std::uint64_t key, const std::vector<unsigned char>& canonical, StatesPtr& states) {
+    if (m_diskDirectory.empty()) return false;
+    const std::string path = getDiskPath(key);
+    std::error_code error;
+    if (!std::filesystem::exists(std::filesystem::u8path(path), error)) return false;
+
+    SimulationParameters params;
+    {
+        MappedTrajectoryFile file;
+        if (!file.open(path)) return false;
+        if (serializeParameters(file.getParameters()) != canonical) return false; //  
+        states = std::make_shared<const std::vector<State>>(file.data(), file.data() + file.size());
+        params = file.getParameters();
+    }
+    //      
+    std::filesystem::last_write_time(std::filesystem::u8path(path), std::filesystem::file_time_type::clock::now(), error);
+
+    storeInMemory(key, params, canonical, states);
+    return true;
+}
+
+void SimulationCache::storeInMemory(std::uint64_t key, const SimulationParameters& params, std::vector<unsigned char> canonical, StatesPtr states) {
+    const size_t bytes = getStatesBytes(*states);
+    if (bytes > m_memoryLimitBytes) return; //       
+
+    auto found = m_index.find(key);
+    if (found != m_index.end()) {
+        m_memoryBytes -= getStatesBytes(*found->second->states);
+        m_entries.erase(found->second);
+        m_index.erase(found);
+    }
+    while (!m_entries.empty() && m_memoryBytes + bytes > m_memoryLimitBytes) {
+        m_memoryBytes -= getStatesBytes(*m_entries.back().states);
+        m_index.erase(m_entries.back().key);
+        m_entries.pop_back();
+    }
+
+    m_entries.emplace_front();
+    Entry& entry = m_entries.front();
+    entry.key = key;
+    entry.params = params;
+    entry.canonical = std::move(canonical);
+    entry.states = std::move(states);
+    m_index[key] = m_entries.begin();
+    m_memoryBytes += bytes;
+}
+
+void SimulationCache::storeOnDisk(std::uint64_t key, const SimulationParameters& params, const std::vector<State>& states) {
+    if (m_diskDirectory.empty()) return;
+    if (TrajectoryFile::HEADER_SIZE + getStatesBytes(states) > m_diskLimitBytes) return;
+
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::u8path(m_diskDirectory), error);
+    if (error) {
+        std::cerr << "SimulationCache: Could not create directory '" << m_diskDirectory << "': " << error.message() << std::endl;
+        return;
+    }
+
+    //      :      
+    const std::string temporaryPath = getDiskPath(key) + ".tmp";
+    if (writeTrajectoryFile(temporaryPath, params, states.data(), states.size())) moveIntoCache(key, temporaryPath);
+}
+
+std::string SimulationCache::moveIntoCache(std::uint64_t key, const std::string& temporaryPath) {
+    const std::string path = getDiskPath(key);
+    std::error_code error;
+    std::filesystem::rename(std::filesystem::u8path(temporaryPath), std::filesystem::u8path(path), error);
+    if (error) {
+        std::cerr << "SimulationCache: Could not store '" << path << "': " << error.message() << std::endl;
+        std::filesystem::remove(std::filesystem::u8path(temporaryPath), error);
+        return std::string();
+    }
+    evictDisk(path);
+    return path;
+}
+
+void SimulationCache::evictDisk(const std::string& keepPath) {
+    struct CachedFile {
+        std::filesystem::path path;
+        std::uintmax_t size;
+        std::filesystem::file_time_type lastUsed;
+    };
+    std::vector<CachedFile> files;
+    std::uintmax_t totalBytes = 0;
+    const std::filesystem::path keepName = std::filesystem::u8path(keepPath).filename();
+
+    std::error_code error;
+    for (std::filesystem::directory_iterator it(std::filesystem::u8path(m_diskDirectory), error), end; !error && it != end; it.increment(error)) {
+        std::error_code fileError;
+        if (!it->is_regular_file(fileError) || !TrajectoryFile::hasBinaryExtension(it->path().u8string())) continue;
+        CachedFile file{ it->path(), it->file_size(fileError), it->last_write_time(fileError) };
+        if (fileError) continue;
+        totalBytes += file.size;
+        if (it->path().filename() != keepName) files.push_back(file); //   , ,  
+    }
+    if (totalBytes <= m_diskLimitBytes) return;
+
+    std::sort(files.begin(), files.end(), [](const CachedFile& a, const CachedFile& b) { return a.lastUsed < b.lastUsed; });
+    for (const CachedFile& file : files) {
+        if (totalBytes <= m_diskLimitBytes) break;
+        if (std::filesystem::remove(file.path, error)) totalBytes -= file.size;
+    }
+}
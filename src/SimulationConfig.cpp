@@ -0,0 +1,338 @@
+#include "../include/SimulationConfig.h"
+
+#include <charconv>  //  std::from_chars (   )
+#include <climits>   //  INT_MAX
+#include <cmath>     //  std::pow, std::sqrt, std::acos
+#include <fstream>   //  std::ifstream, std::ofstream
+#include <sstream>   //  std::wstringstream
+#include <iostream>
+
+bool SimulationConfig::loadParameterFile(const std::string& path, ParameterStrings& values) {
+    std::ifstream inFile(path);
+    if (!inFile.is_open()) {
+        std::cerr << "Error: Could not open parameter file '" << path << "'." << std::endl;
+        return false;
+    }
+
+    std::string line, key, value;
+    while (std::getline(inFile, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back(); // ,   Windows
+        size_t delimiterPos = line.find('=');
+        if (delimiterPos != std::string::npos) {
+            key = line.substr(0, delimiterPos);
+            value = line.substr(delimiterPos + 1);
+
+            if (key == "m_satellite_kg") values.m_satellite_kg = value;
+            else if (key == "M_central_body_factor") values.M_central_body_factor = value;
+            else if (key == "V0_m_per_s") values.V0_m_per_s = value;
+            else if (key == "T_days") values.T_days = value;
+            else if (key == "k_coeff") values.k_coeff = value;
+            else if (key == "F_coeff") values.F_coeff = value;
+            else if (key == "integrator") values.integrator = value;
+            else if (key == "dt") values.dt = value;
+            else if (key == "j2") values.j2 = value;
+            else if (key == "atmosphere_drag") values.atmosphere_drag = value;
+            else if (key == "atmosphere_scale_height") values.atmosphere_scale_height = value;
+            else if (key == "thrust_accel") values.thrust_accel = value;
+            else if (key == "thrust_angle_deg") values.thrust_angle_deg = value;
+            else if (key == "mc_runs") values.mc_runs = value;
+            else if (key == "mc_seed") values.mc_seed = value;
+            else if (key == "mc_v0_sigma_m_per_s") values.mc_v0_sigma_m_per_s = value;
+            else if (key == "mc_position_sigma") values.mc_position_sigma = value;
+            else if (key == "mc_k_sigma") values.mc_k_sigma = value;
+        }
+    }
+    return true;
+}
+
+bool SimulationConfig::saveParameterFile(const std::string& path, const ParameterStrings& values) {
+    std::ofstream outFile(path);
+    if (!outFile.is_open()) {
+        std::cerr << "Error: Could not open file '" << path << "' for saving parameters." << std::endl;
+        return false;
+    }
+    outFile << "m_satellite_kg=" << values.m_satellite_kg << std::endl;
+    outFile << "M_central_body_factor=" << values.M_central_body_factor << std::endl;
+    outFile << "V0_m_per_s=" << values.V0_m_per_s << std::endl;
+    outFile << "T_days=" << values.T_days << std::endl;
+    outFile << "k_coeff=" << values.k_coeff << std::endl;
+    outFile << "F_coeff=" << values.F_coeff << std::endl;
+    if (!values.integrator.empty()) outFile << "integrator=" << values.integrator << std::endl;
+    if (!values.dt.empty()) outFile << "dt=" << values.dt << std::endl;
+    if (!values.j2.empty()) outFile << "j2=" << values.j2 << std::endl;
+    if (!values.atmosphere_drag.empty()) outFile << "atmosphere_drag=" << values.atmosphere_drag << std::endl;
+    if (!values.atmosphere_scale_height.empty()) outFile << "atmosphere_scale_height=" << values.atmosphere_scale_height << std::endl;
+    if (!values.thrust_accel.empty()) outFile << "thrust_accel=" << values.thrust_accel << std::endl;
+    if (!values.thrust_angle_deg.empty()) outFile << "thrust_angle_deg=" << values.thrust_angle_deg << std::endl;
+    if (!values.mc_runs.empty()) outFile << "mc_runs=" << values.mc_runs << std::endl;
+    if (!values.mc_seed.empty()) outFile << "mc_seed=" << values.mc_seed << std::endl;
+    if (!values.mc_v0_sigma_m_per_s.empty()) outFile << "mc_v0_sigma_m_per_s=" << values.mc_v0_sigma_m_per_s << std::endl;
+    if (!values.mc_position_sigma.empty()) outFile << "mc_position_sigma=" << values.mc_position_sigma << std::endl;
+    if (!values.mc_k_sigma.empty()) outFile << "mc_k_sigma=" << values.mc_k_sigma << std::endl;
+    outFile.close();
+    if (outFile.fail()) {
+        std::cerr << "Error: Failed to write or close parameter file '" << path << "'." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool SimulationConfig::parseDecimal(const std::string& text, double& value) {
+    size_t begin = text.find_first_not_of(" \t");
+    size_t end = text.find_last_not_of(" \t");
+    if (begin == std::string::npos) return false;
+
+    std::string number = text.substr(begin, end - begin + 1);
+    for (char& c : number) {
+        if (c == ',') c = '.';
+    }
+    const char* first = number.data();
+    const char* last = number.data() + number.size();
+    if (*first == '+') ++first; // from_chars    , std::stod 
+    auto result = std::from_chars(first, last, value);
+    return result.ec == std::errc() && result.ptr == last;
+}
+
+InputParameters SimulationConfig::validate(const ParameterStrings& values) {
+    InputParameters params;
+    std::wstringstream errorMessages;
+
+    if (parseDecimal(values.m_satellite_kg, params.m_satellite_kg)) {
+        if (params.m_satellite_kg < 0.1 || params.m_satellite_kg > 100000.0) {
+            params.isValid = false;
+            errorMessages << L"  (m)   [0.1, 100.000] .\n";
+        }
+    }
+    else {
+        params.isValid = false;
+        errorMessages << L"    (m).\n";
+    }
+
+    if (parseDecimal(values.M_central_body_factor, params.M_central_body_factor)) {
+        if (params.M_central_body_factor < 0.1 || params.M_central_body_factor > 1.0e5) {
+            params.isValid = false;
+            errorMessages << L" .  (M)   [0,1, 100.000].\n";
+        }
+    }
+    else {
+        params.isValid = false;
+        errorMessages << L"   .  (M).\n";
+    }
+
+    if (parseDecimal(values.V0_m_per_s, params.V0_m_per_s)) {
+        if (params.V0_m_per_s < 0.0 || params.V0_m_per_s > 1000) {
+            params.isValid = false;
+            errorMessages << L"  (V0)   [0, 1000] /.\n";
+        }
+    }
+    else {
+        params.isValid = false;
+        errorMessages << L"    (V0).\n";
+    }
+
+    if (parseDecimal(values.T_days, params.T_days)) {
+        if (params.T_days < 1 || params.T_days > 1.0e7) {
+            params.isValid = false;
+            errorMessages << L"  (T)   [1, 10.000.000] .\n";
+        }
+    }
+    else {
+        params.isValid = false;
+        errorMessages << L"    (T).\n";
+    }
+
+    if (parseDecimal(values.k_coeff, params.k_coeff)) {
+        if (params.k_coeff < 0.0 || params.k_coeff > 2.0) {
+            params.isValid = false;
+            errorMessages << L" k   [0.0, 2.0].\n";
+        }
+    }
+    else {
+        params.isValid = false;
+        errorMessages << L"   k.\n";
+    }
+
+    if (parseDecimal(values.F_coeff, params.F_coeff)) {
+        if (params.F_coeff < 0.0 || params.F_coeff > 2.0) {
+            params.isValid = false;
+            errorMessages << L" F   [0.0, 2.0].\n";
+        }
+    }
+    else {
+        params.isValid = false;
+        errorMessages << L"   F.\n";
+    }
+
+    const IntegratorType integrators[] = {
+        IntegratorType::RK4, IntegratorType::DormandPrince45, IntegratorType::VelocityVerlet, IntegratorType::Yoshida4
+    };
+    bool integratorFound = values.integrator.empty(); //   RK4
+    params.integrator = IntegratorType::RK4;
+    for (IntegratorType integrator : integrators) {
+        if (values.integrator == getIntegratorKey(integrator)) {
+            params.integrator = integrator;
+            integratorFound = true;
+        }
+    }
+    if (!integratorFound) {
+        params.isValid = false;
+        errorMessages << L"  (: rk4, dp45, verlet, yoshida4).\n";
+    }
+
+    if (!values.dt.empty()) {
+        if (!parseDecimal(values.dt, params.dt)) {
+            params.isValid = false;
+            errorMessages << L"   dt.\n";
+        }
+        else if (params.dt < MIN_DT || params.dt > MAX_DT) {
+            params.isValid = false;
+            errorMessages << L" dt   [0.00001, 0.1].\n";
+        }
+    }
+
+    //   :   -  0 ()
+    struct OptionalValue {
+        const std::string& text;
+        double& value;
+        double minValue;
+        double maxValue;
+        const wchar_t* name;
+    };
+    const OptionalValue perturbations[] = {
+        { values.j2, params.j2, 0.0, MAX_J2, L"j2" },
+        { values.atmosphere_drag, params.atmosphere_drag, 0.0, MAX_ATMOSPHERE_DRAG, L"atmosphere_drag" },
+        { values.atmosphere_scale_height, params.atmosphere_scale_height, 0.0, 10.0, L"atmosphere_scale_height" },
+        { values.thrust_accel, params.thrust_accel, 0.0, MAX_THRUST_ACCELERATION, L"thrust_accel" },
+        { values.thrust_angle_deg, params.thrust_angle_deg, -360.0, 360.0, L"thrust_angle_deg" },
+    };
+    auto parseOptional = [&](const OptionalValue& item) {
+        if (item.text.empty()) return;
+        if (!parseDecimal(item.text, item.value)) {
+            params.isValid = false;
+            errorMessages << L"  " << item.name << L".\n";
+        }
+        else if (item.value < item.minValue || item.value > item.maxValue) {
+            params.isValid = false;
+            errorMessages << item.name << L"   [" << item.minValue << L", " << item.maxValue << L"].\n";
+        }
+    };
+    for (const OptionalValue& item : perturbations) parseOptional(item);
+    if (params.atmosphere_drag > 0.0 && params.atmosphere_scale_height <= 0.0) {
+        params.isValid = false;
+        errorMessages << L" atmosphere_drag   atmosphere_scale_height.\n";
+    }
+
+    //    -:   -   
+    const OptionalValue ensemble[] = {
+        { values.mc_runs, params.mc_runs, 1.0, MAX_ENSEMBLE_RUNS, L"mc_runs" },
+        { values.mc_seed, params.mc_seed, 0.0, 4294967295.0, L"mc_seed" },
+        { values.mc_v0_sigma_m_per_s, params.mc_v0_sigma_m_per_s, 0.0, 1000.0, L"mc_v0_sigma_m_per_s" },
+        { values.mc_position_sigma, params.mc_position_sigma, 0.0, 1.0, L"mc_position_sigma" },
+        { values.mc_k_sigma, params.mc_k_sigma, 0.0, 2.0, L"mc_k_sigma" },
+    };
+    for (const OptionalValue& item : ensemble) parseOptional(item);
+    if (params.mc_runs != std::floor(params.mc_runs) || params.mc_seed != std::floor(params.mc_seed)) {
+        params.isValid = false;
+        errorMessages << L"mc_runs  mc_seed   .\n";
+    }
+
+    //      M, T  dt,  ,     
+    double lengthUnit = 0.0, timeUnit = 0.0;
+    if (params.isValid && getUnits(params, lengthUnit, timeUnit) && getStepCount(params, timeUnit) > INT_MAX) {
+        params.isValid = false;
+        errorMessages << L"   (T / dt  " << INT_MAX << L"):  dt   T.\n";
+    }
+
+    params.errorMessage = errorMessages.str();
+    return params;
+}
+
+const char* SimulationConfig::getIntegratorKey(IntegratorType integrator) {
+    switch (integrator) {
+    case IntegratorType::DormandPrince45: return "dp45";
+    case IntegratorType::VelocityVerlet: return "verlet";
+    case IntegratorType::Yoshida4: return "yoshida4";
+    default: return "rk4";
+    }
+}
+
+bool SimulationConfig::toSimulationParameters(const InputParameters& input, SimulationParameters& params, double& timeUnit) {
+    params = SimulationParameters(); //     Calculations.h
+
+    double length_unit = 0.0;
+    if (!getUnits(input, length_unit, timeUnit)) return false;
+    double M_central_body_physical_kg = input.M_central_body_factor * CENTRAL_MASS_MULTIPLIER;
+    double mass_unit_for_scaling = M_central_body_physical_kg;
+
+    params.G = 1.0;
+    params.M = (M_central_body_physical_kg + input.m_satellite_kg) / mass_unit_for_scaling;
+
+    params.DRAG_COEFFICIENT = input.k_coeff;
+    params.THRUST_COEFFICIENT = input.F_coeff;
+    params.integrator = input.integrator;
+    if (input.dt > 0.0) params.DT = input.dt;
+    params.perturbations.J2 = input.j2;
+    params.perturbations.atmosphereDrag = input.atmosphere_drag;
+    params.perturbations.atmosphereScaleHeight = input.atmosphere_scale_height;
+    params.perturbations.thrustAcceleration = input.thrust_accel;
+    params.perturbations.thrustAngle = input.thrust_angle_deg * std::acos(-1.0) / 180.0;
+
+    if (params.DT > 1e-9) {
+        const double steps = getStepCount(input, timeUnit);
+        if (steps > INT_MAX) {
+            std::cerr << "Error: T / DT = " << steps << " steps does not fit into int; increase dt or decrease T." << std::endl;
+            return false;
+        }
+        params.STEPS = static_cast<int>(steps);
+    }
+    else {
+        params.STEPS = 1000;
+        std::cerr << "Warning: DT is too small or zero. Using default STEPS." << std::endl;
+    }
+    if (params.STEPS <= 0) params.STEPS = 1;
+
+    double characteristic_velocity = length_unit / timeUnit;
+    if (std::abs(characteristic_velocity) > 1e-9) {
+        params.initialState.vy = input.V0_m_per_s / characteristic_velocity;
+    }
+    else {
+        params.initialState.vy = 0.0;
+        std::cerr << "Warning: Characteristic velocity (length_unit/time_unit) is near zero. Setting vy_dimless to 0." << std::endl;
+    }
+    return true;
+}
+
+bool SimulationConfig::getUnits(const InputParameters& input, double& lengthUnit, double& timeUnit) {
+    //    M_central   
+    double mass_unit_for_scaling = input.M_central_body_factor * CENTRAL_MASS_MULTIPLIER;
+    lengthUnit = REFERENCE_PHYSICAL_LENGTH_FOR_X_1_5 / SimulationParameters().initialState.x;
+
+    if (mass_unit_for_scaling <= 1e-9) {
+        std::cerr << "Error: Scaling mass unit (M_central_body_physical_kg) must be significantly positive." << std::endl;
+        return false;
+    }
+    timeUnit = std::sqrt(std::pow(lengthUnit, 3) / (G_SI * mass_unit_for_scaling));
+    return true;
+}
+
+double SimulationConfig::getStepCount(const InputParameters& input, double timeUnit) {
+    const double dt = (input.dt > 0.0) ? input.dt : SimulationParameters().DT;
+    const double T_total_dimensionless = input.T_days * SECONDS_PER_DAY / timeUnit;
+    return std::floor(T_total_dimensionless / dt);
+}
+
+bool SimulationConfig::toEnsembleSettings(const InputParameters& input, EnsembleDispersion& dispersion, EnsembleSettings& settings) {
+    double length_unit = 0.0;
+    double time_unit = 0.0;
+    if (!getUnits(input, length_unit, time_unit)) return false;
+
+    settings = EnsembleSettings();
+    settings.runs = (input.mc_runs > 0.0) ? static_cast<size_t>(input.mc_runs) : DEFAULT_ENSEMBLE_RUNS;
+    settings.seed = static_cast<std::uint64_t>(input.mc_seed);
+
+    double v0_sigma_m_per_s = (input.mc_v0_sigma_m_per_s >= 0.0) ? input.mc_v0_sigma_m_per_s : DEFAULT_V0_SIGMA_M_PER_S;
+    dispersion.velocitySigma = v0_sigma_m_per_s / (length_unit / time_unit);
+    dispersion.positionSigma = (input.mc_position_sigma >= 0.0) ? input.mc_position_sigma : DEFAULT_POSITION_SIGMA;
+    dispersion.dragSigma = (input.mc_k_sigma >= 0.0) ? input.mc_k_sigma : DEFAULT_K_SIGMA;
+    return true;
+}
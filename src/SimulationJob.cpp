@@ -0,0 +1,75 @@
+#include "../include/SimulationJob.h"
+
+#include <algorithm> //  std::min, std::max
+
+SimulationJob::SimulationJob()
+    : m_status(Status::Idle) {
+}
+
+SimulationJob::~SimulationJob() {
+    cancelAndJoin();
+}
+
+void SimulationJob::start(const SimulationParameters& params, std::vector<std::shared_ptr<TrajectorySink>> sinks) {
+    cancelAndJoin(); //     
+    m_resume = false;
+    launch(params, std::move(sinks));
+}
+
+void SimulationJob::resume(const SimulationParameters& params, const SimulationCheckpoint& from, std::vector<std::shared_ptr<TrajectorySink>> sinks) {
+    cancelAndJoin();
+    m_resume = true;
+    m_resumeFrom = from;
+    launch(params, std::move(sinks));
+}
+
+void SimulationJob::launch(const SimulationParameters& params, std::vector<std::shared_ptr<TrajectorySink>> sinks) {
+    m_params = params;
+    m_sinks = FanOutSink(std::move(sinks));
+    m_control.cancelRequested.store(false, std::memory_order_relaxed);
+    //       
+    m_control.completedSteps.store(m_resume ? static_cast<int>(m_resumeFrom.stepIndex) : 0, std::memory_order_relaxed);
+    m_status.store(Status::Running, std::memory_order_release);
+    m_worker = std::thread(&SimulationJob::workerMain, this);
+}
+
+void SimulationJob::cancel() {
+    cancelAndJoin();
+}
+
+void SimulationJob::cancelAndJoin() {
+    if (m_worker.joinable()) {
+        m_control.cancelRequested.store(true, std::memory_order_relaxed);
+        m_worker.join();
+    }
+    if (getStatus() == Status::Running) {
+        m_status.store(Status::Cancelled, std::memory_order_release);
+    }
+}
+
+double SimulationJob::getProgress() const {
+    if (m_params.STEPS <= 0) return 0.0;
+    double done = static_cast<double>(m_control.completedSteps.load(std::memory_order_relaxed));
+    return std::min(1.0, std::max(0.0, done / m_params.STEPS));
+}
+
+bool SimulationJob::acknowledgeFinished() {
+    if (getStatus() != Status::Finished) return false;
+    if (m_worker.joinable()) m_worker.join(); //    , join   
+
+    m_sinks = FanOutSink(); //    
+    m_status.store(Status::Idle, std::memory_order_release);
+    return true;
+}
+
+void SimulationJob::workerMain() {
+    Calculations calculator;
+    if (m_resume) calculator.resumeSimulation(m_params, m_resumeFrom, m_sinks, &m_control);
+    else calculator.runSimulation(m_params, m_sinks, &m_control);
+
+    if (m_control.cancelRequested.load(std::memory_order_relaxed)) {
+        m_status.store(Status::Cancelled, std::memory_order_release);
+        return;
+    }
+    m_status.store(Status::Finished, std::memory_order_release);
+}
@@ -0,0 +1,586 @@
+#include "../include/TrajectoryFile.h"
+#include "../include/SimulationConfig.h" //  SimulationConfig::parseDecimal
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm> //  std::reverse, std::transform, std::max
+#include <cctype>    //  std::tolower
+#include <cerrno>    //  errno (EINTR)
+#include <cstring>   //  std::memcpy
+#include <filesystem> //  std::filesystem::u8path
+#include <iostream>
+#include <limits>    //  std::numeric_limits
+#include <memory>
+
+namespace {
+
+    bool isLittleEndianHost() {
+        const std::uint16_t probe = 1;
+        unsigned char firstByte;
+        std::memcpy(&firstByte, &probe, 1);
+        return firstByte == 1;
+    }
+
+    //       little-endian   
+    void putU32(unsigned char* p, std::uint32_t v) {
+        for (int i = 0; i < 4; ++i) p[i] = static_cast<unsigned char>(v >> (8 * i));
+    }
+    void putU64(unsigned char* p, std::uint64_t v) {
+        for (int i = 0; i < 8; ++i) p[i] = static_cast<unsigned char>(v >> (8 * i));
+    }
+    void putF64(unsigned char* p, double v) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        putU64(p, bits);
+    }
+    std::uint32_t getU32(const unsigned char* p) {
+        std::uint32_t v = 0;
+        for (int i = 0; i < 4; ++i) v |= static_cast<std::uint32_t>(p[i]) << (8 * i);
+        return v;
+    }
+    std::uint64_t getU64(const unsigned char* p) {
+        std::uint64_t v = 0;
+        for (int i = 0; i < 8; ++i) v |= static_cast<std::uint64_t>(p[i]) << (8 * i);
+        return v;
+    }
+    double getF64(const unsigned char* p) {
+        std::uint64_t bits = getU64(p);
+        double v;
+        std::memcpy(&v, &bits, sizeof(v));
+        return v;
+    }
+
+    //   
+    constexpr size_t OFFSET_VERSION = 8;
+    constexpr size_t OFFSET_HEADER_SIZE = 12;
+    constexpr size_t OFFSET_COUNT = 16;
+    constexpr size_t OFFSET_DT = 24;
+    constexpr size_t OFFSET_TIME_UNIT = 32;
+    constexpr size_t OFFSET_PARAMS = 40; // G, M, , k, F, x0, y0, vx0, vy0
+    constexpr size_t OFFSET_STEPS = 112;
+    constexpr size_t OFFSET_INTEGRATOR = 116;
+    constexpr size_t OFFSET_ADAPTIVE = 120; // rtol, atol, minStep, maxStep, initialStep
+    // J2, atmosphereDrag, atmosphereScaleHeight, thrustAcceleration, thrustAngle;  ,
+    //    ,   -     
+    constexpr size_t OFFSET_PERTURBATIONS = 160;
+
+    void encodeHeader(unsigned char* header, const SimulationParameters& params, double timeUnitSeconds, std::uint64_t count) {
+        std::memset(header, 0, TrajectoryFile::HEADER_SIZE);
+        std::memcpy(header, TrajectoryFile::MAGIC, sizeof(TrajectoryFile::MAGIC));
+        putU32(header + OFFSET_VERSION, TrajectoryFile::VERSION);
+        putU32(header + OFFSET_HEADER_SIZE, static_cast<std::uint32_t>(TrajectoryFile::HEADER_SIZE));
+        putU64(header + OFFSET_COUNT, count);
+        putF64(header + OFFSET_DT, params.DT);
+        putF64(header + OFFSET_TIME_UNIT, timeUnitSeconds);
+
+        const double values[] = {
+            params.G, params.M, params.CENTRAL_BODY_RADIUS, params.DRAG_COEFFICIENT, params.THRUST_COEFFICIENT,
+            params.initialState.x, params.initialState.y, params.initialState.vx, params.initialState.vy
+        };
+        for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i) putF64(header + OFFSET_PARAMS + 8 * i, values[i]);
+        putU32(header + OFFSET_STEPS, static_cast<std::uint32_t>(params.STEPS));
+        putU32(header + OFFSET_INTEGRATOR, static_cast<std::uint32_t>(params.integrator));
+
+        const double adaptive[] = {
+            params.adaptive.rtol, params.adaptive.atol, params.adaptive.minStep, params.adaptive.maxStep, params.adaptive.initialStep
+        };
+        for (size_t i = 0; i < sizeof(adaptive) / sizeof(adaptive[0]); ++i) putF64(header + OFFSET_ADAPTIVE + 8 * i, adaptive[i]);
+
+        const double perturbations[] = {
+            params.perturbations.J2, params.perturbations.atmosphereDrag, params.perturbations.atmosphereScaleHeight,
+            params.perturbations.thrustAcceleration, params.perturbations.thrustAngle
+        };
+        for (size_t i = 0; i < sizeof(perturbations) / sizeof(perturbations[0]); ++i) putF64(header + OFFSET_PERTURBATIONS + 8 * i, perturbations[i]);
+    }
+
+    //  false,       int    
+    bool decodeHeader(const unsigned char* header, SimulationParameters& params, double& timeUnitSeconds) {
+        const std::uint32_t steps = getU32(header + OFFSET_STEPS);
+        const std::uint32_t integrator = getU32(header + OFFSET_INTEGRATOR);
+        if (steps > static_cast<std::uint32_t>(std::numeric_limits<int>::max())
+            || integrator > static_cast<std::uint32_t>(IntegratorType::Yoshida4)) return false;
+
+        params.DT = getF64(header + OFFSET_DT);
+        timeUnitSeconds = getF64(header + OFFSET_TIME_UNIT);
+
+        double* targets[] = {
+            &params.G, &params.M, &params.CENTRAL_BODY_RADIUS, &params.DRAG_COEFFICIENT, &params.THRUST_COEFFICIENT,
+            &params.initialState.x, &params.initialState.y, &params.initialState.vx, &params.initialState.vy
+        };
+        for (size_t i = 0; i < sizeof(targets) / sizeof(targets[0]); ++i) *targets[i] = getF64(header + OFFSET_PARAMS + 8 * i);
+        params.STEPS = static_cast<int>(steps);
+        params.integrator = static_cast<IntegratorType>(integrator);
+
+        double* adaptive[] = {
+            &params.adaptive.rtol, &params.adaptive.atol, &params.adaptive.minStep, &params.adaptive.maxStep, &params.adaptive.initialStep
+        };
+        for (size_t i = 0; i < sizeof(adaptive) / sizeof(adaptive[0]); ++i) *adaptive[i] = getF64(header + OFFSET_ADAPTIVE + 8 * i);
+
+        double* perturbations[] = {
+            &params.perturbations.J2, &params.perturbations.atmosphereDrag, &params.perturbations.atmosphereScaleHeight,
+            &params.perturbations.thrustAcceleration, &params.perturbations.thrustAngle
+        };
+        for (size_t i = 0; i < sizeof(perturbations) / sizeof(perturbations[0]); ++i) *perturbations[i] = getF64(header + OFFSET_PERTURBATIONS + 8 * i);
+        return true;
+    }
+
+    void byteSwapDoubles(double* values, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            unsigned char* bytes = reinterpret_cast<unsigned char*>(&values[i]);
+            std::reverse(bytes, bytes + sizeof(double));
+        }
+    }
+
+    //    ,      (fsync / FlushFileBuffers):
+    //       ,   - 
+    bool writeFileDurably(const std::filesystem::path& path, const unsigned char* data, size_t size) {
+#ifdef _WIN32
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        DWORD written = 0;
+        bool ok = WriteFile(file, data, static_cast<DWORD>(size), &written, nullptr) && written == size;
+        ok = FlushFileBuffers(file) && ok;
+        return CloseHandle(file) && ok;
+#else
+        int file = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (file < 0) return false;
+        bool ok = true;
+        while (ok && size > 0) {
+            const ssize_t written = ::write(file, data, size);
+            if (written < 0 && errno == EINTR) continue;
+            ok = written > 0;
+            if (ok) {
+                data += written;
+                size -= static_cast<size_t>(written);
+            }
+        }
+        ok = (::fsync(file) == 0) && ok;
+        return (::close(file) == 0) && ok;
+#endif
+    }
+
+    // ,         .     
+    //  ,     ( std::fstream   ).
+    bool syncFile(const std::filesystem::path& path) {
+#ifdef _WIN32
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        const bool ok = FlushFileBuffers(file) != 0;
+        return CloseHandle(file) && ok;
+#else
+        int file = ::open(path.c_str(), O_WRONLY);
+        if (file < 0) return false;
+        const bool ok = ::fsync(file) == 0;
+        return (::close(file) == 0) && ok;
+#endif
+    }
+
+    // POSIX:          fsync 
+    void syncDirectory(const std::filesystem::path& directory) {
+#ifndef _WIN32
+        int handle = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY);
+        if (handle < 0) return;
+        ::fsync(handle);
+        ::close(handle);
+#else
+        (void)directory;
+#endif
+    }
+
+} // namespace
+
+bool TrajectoryFile::saveCheckpoint(const std::string& path, const SimulationCheckpoint& checkpoint) {
+    unsigned char bytes[HEADER_SIZE + sizeof(State)];
+    encodeHeader(bytes, checkpoint.params, 0.0, checkpoint.stepIndex);
+    std::memcpy(bytes, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    const double state[] = { checkpoint.state.x, checkpoint.state.y, checkpoint.state.vx, checkpoint.state.vy };
+    for (size_t i = 0; i < 4; ++i) putF64(bytes + HEADER_SIZE + 8 * i, state[i]);
+
+    const std::filesystem::path target = std::filesystem::u8path(path);
+    std::filesystem::path temporary = target;
+    temporary += ".tmp";
+    if (!writeFileDurably(temporary, bytes, sizeof(bytes))) {
+        std::cerr << "Checkpoint: Could not write '" << temporary.u8string() << "'." << std::endl;
+        return false;
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, target, error);
+    if (error) {
+        std::cerr << "Checkpoint: Could not replace '" << path << "': " << error.message() << std::endl;
+        return false;
+    }
+    syncDirectory(target.parent_path());
+    return true;
+}
+
+bool TrajectoryFile::loadCheckpoint(const std::string& path, SimulationCheckpoint& checkpoint) {
+    std::ifstream file(std::filesystem::u8path(path), std::ios::binary);
+    unsigned char bytes[HEADER_SIZE + sizeof(State)];
+    if (!file.read(reinterpret_cast<char*>(bytes), sizeof(bytes))) {
+        std::cerr << "Checkpoint: Could not read '" << path << "'." << std::endl;
+        return false;
+    }
+    if (std::memcmp(bytes, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0 || getU32(bytes + OFFSET_VERSION) != VERSION) {
+        std::cerr << "Checkpoint: '" << path << "' is not a checkpoint file of a supported version." << std::endl;
+        return false;
+    }
+    double timeUnitSeconds = 0.0;
+    if (!decodeHeader(bytes, checkpoint.params, timeUnitSeconds)) {
+        std::cerr << "Checkpoint: '" << path << "' has an unknown integrator or too many steps." << std::endl;
+        return false;
+    }
+    checkpoint.stepIndex = getU64(bytes + OFFSET_COUNT);
+    checkpoint.state = { getF64(bytes + HEADER_SIZE), getF64(bytes + HEADER_SIZE + 8),
+        getF64(bytes + HEADER_SIZE + 16), getF64(bytes + HEADER_SIZE + 24) };
+    return true;
+}
+
+bool TrajectoryFile::hasBinaryExtension(const std::string& path) {
+    const std::string extension = EXTENSION;
+    if (path.size() < extension.size()) return false;
+    std::string tail = path.substr(path.size() - extension.size());
+    std::transform(tail.begin(), tail.end(), tail.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return tail == extension;
+}
+
+// --- BinaryTrajectorySink ---
+BinaryTrajectorySink::BinaryTrajectorySink(const std::string& path, double timeUnitSeconds)
+    : m_path(std::filesystem::u8path(path)),
+    m_file(m_path, std::ios::out | std::ios::binary | std::ios::trunc),
+    m_timeUnitSeconds(timeUnitSeconds),
+    m_keepCount(0),
+    m_count(0),
+    m_failed(false) {
+    if (!m_file.is_open()) {
+        std::cerr << "BinaryTrajectorySink: Could not open file '" << path << "' for writing." << std::endl;
+        m_failed = true;
+    }
+}
+
+BinaryTrajectorySink::BinaryTrajectorySink(const std::string& path, double timeUnitSeconds, const SimulationCheckpoint& resumeFrom)
+    : m_path(std::filesystem::u8path(path)),
+    m_timeUnitSeconds(timeUnitSeconds),
+    m_keepCount(resumeFrom.stepIndex + 1),
+    m_count(0),
+    m_failed(true) {
+    const std::filesystem::path& filePath = m_path;
+    std::ifstream existing(filePath, std::ios::binary);
+    unsigned char header[TrajectoryFile::HEADER_SIZE];
+    if (!existing.read(reinterpret_cast<char*>(header), sizeof(header))
+        || std::memcmp(header, TrajectoryFile::MAGIC, sizeof(TrajectoryFile::MAGIC)) != 0
+        || getU32(header + OFFSET_VERSION) != TrajectoryFile::VERSION) {
+        std::cerr << "BinaryTrajectorySink: '" << path << "' is not a trajectory file to continue." << std::endl;
+        return;
+    }
+    SimulationParameters stored;
+    double storedTimeUnit = 0.0;
+    if (!decodeHeader(header, stored, storedTimeUnit) || !Calculations::sameModel(stored, resumeFrom.params)) {
+        std::cerr << "BinaryTrajectorySink: '" << path << "' was written for other parameters than the checkpoint." << std::endl;
+        return;
+    }
+
+    //        ,      
+    const std::uintmax_t headerSize = getU32(header + OFFSET_HEADER_SIZE);
+    const std::uintmax_t keptSize = headerSize + m_keepCount * sizeof(State);
+    std::error_code error;
+    const std::uintmax_t size = std::filesystem::file_size(filePath, error);
+    if (error || headerSize < TrajectoryFile::HEADER_SIZE || resumeFrom.stepIndex >= size / sizeof(State) || size < keptSize) {
+        std::cerr << "BinaryTrajectorySink: '" << path << "' holds fewer than " << m_keepCount << " points." << std::endl;
+        return;
+    }
+    unsigned char pointBytes[sizeof(State)];
+    existing.seekg(static_cast<std::streamoff>(keptSize - sizeof(State)));
+    if (!existing.read(reinterpret_cast<char*>(pointBytes), sizeof(pointBytes))) {
+        std::cerr << "BinaryTrajectorySink: Could not read '" << path << "'." << std::endl;
+        return;
+    }
+    const State point = { getF64(pointBytes), getF64(pointBytes + 8), getF64(pointBytes + 16), getF64(pointBytes + 24) };
+    if (std::memcmp(&point, &resumeFrom.state, sizeof(State)) != 0) {
+        std::cerr << "BinaryTrajectorySink: Point " << resumeFrom.stepIndex << " of '" << path << "' differs from the checkpoint." << std::endl;
+        return;
+    }
+    existing.close();
+
+    std::filesystem::resize_file(filePath, keptSize, error);
+    if (!error) m_file.open(filePath, std::ios::in | std::ios::out | std::ios::binary);
+    if (error || !m_file.is_open()) {
+        std::cerr << "BinaryTrajectorySink: Could not open file '" << path << "' for appending." << std::endl;
+        return;
+    }
+    m_failed = false;
+}
+
+bool BinaryTrajectorySink::flush() {
+    if (!m_file.is_open()) return !m_failed; //  end()    
+    if (!m_file.flush() || !syncFile(m_path)) {
+        std::cerr << "BinaryTrajectorySink: Could not flush '" << m_path.u8string() << "' to disk." << std::endl;
+        m_failed = true;
+        return false;
+    }
+    return true;
+}
+
+void BinaryTrajectorySink::begin(const SimulationParameters& params) {
+    m_count = m_keepCount;
+    if (!m_file.is_open()) return;
+    unsigned char header[TrajectoryFile::HEADER_SIZE];
+    encodeHeader(header, params, m_timeUnitSeconds, 0); //     end()
+    m_file.seekp(0);
+    m_file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    m_file.seekp(0, std::ios::end); //       
+}
+
+void BinaryTrajectorySink::consume(size_t firstIndex, const State* states, size_t count) {
+    (void)firstIndex;
+    if (!m_file.is_open() || count == 0) return;
+    if (isLittleEndianHost()) {
+        m_file.write(reinterpret_cast<const char*>(states), static_cast<std::streamsize>(count * sizeof(State)));
+    }
+    else {
+        m_swapBuffer.assign(reinterpret_cast<const double*>(states), reinterpret_cast<const double*>(states) + 4 * count);
+        byteSwapDoubles(m_swapBuffer.data(), m_swapBuffer.size());
+        m_file.write(reinterpret_cast<const char*>(m_swapBuffer.data()), static_cast<std::streamsize>(m_swapBuffer.size() * sizeof(double)));
+    }
+    m_count += count;
+}
+
+void BinaryTrajectorySink::end() {
+    if (!m_file.is_open()) return;
+    unsigned char countBytes[8];
+    putU64(countBytes, m_count);
+    m_file.seekp(static_cast<std::streamoff>(OFFSET_COUNT));
+    m_file.write(reinterpret_cast<const char*>(countBytes), sizeof(countBytes));
+    m_file.close();
+    if (m_file.fail() || !syncFile(m_path)) {
+        std::cerr << "BinaryTrajectorySink: Failed to write or close the trajectory file." << std::endl;
+        m_failed = true;
+    }
+}
+
+// --- CheckpointSink ---
+CheckpointSink::CheckpointSink(const std::string& path, size_t intervalPoints, BinaryTrajectorySink* dataFile)
+    : m_path(path),
+    m_intervalPoints(std::max<size_t>(intervalPoints, 1)),
+    m_dataFile(dataFile) {
+}
+
+void CheckpointSink::begin(const SimulationParameters& params) {
+    m_checkpoint.params = params;
+    m_hasState = false;
+    m_writtenCount = 0;
+}
+
+void CheckpointSink::consume(size_t firstIndex, const State* states, size_t count) {
+    if (count == 0) return;
+    if (!m_hasState) m_nextWriteIndex = firstIndex + m_intervalPoints; //        
+    m_checkpoint.stepIndex = firstIndex + count - 1;
+    m_checkpoint.state = states[count - 1];
+    m_hasState = true;
+    if (m_checkpoint.stepIndex >= m_nextWriteIndex) {
+        write();
+        m_nextWriteIndex = m_checkpoint.stepIndex + m_intervalPoints;
+    }
+}
+
+void CheckpointSink::end() {
+    if (m_hasState) write();
+}
+
+void CheckpointSink::write() {
+    if (m_dataFile && !m_dataFile->flush()) { //        
+        m_failed = true;
+        return;
+    }
+    if (TrajectoryFile::saveCheckpoint(m_path, m_checkpoint)) ++m_writtenCount;
+    else m_failed = true;
+}
+
+// --- MappedTrajectoryFile ---
+MappedTrajectoryFile::~MappedTrajectoryFile() {
+    close();
+}
+
+bool MappedTrajectoryFile::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    int wideLength = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+    std::wstring widePath(wideLength > 0 ? wideLength - 1 : 0, L'\0');
+    if (wideLength > 1) MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &widePath[0], wideLength);
+
+    HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "MappedTrajectoryFile: Could not open '" << path << "'." << std::endl;
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(TrajectoryFile::HEADER_SIZE)) {
+        std::cerr << "MappedTrajectoryFile: '" << path << "' is too small for a trajectory header." << std::endl;
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        std::cerr << "MappedTrajectoryFile: Could not map '" << path << "' into memory." << std::endl;
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    m_mapping = view;
+    m_mappingSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "MappedTrajectoryFile: Could not open '" << path << "'." << std::endl;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(TrajectoryFile::HEADER_SIZE)) {
+        std::cerr << "MappedTrajectoryFile: '" << path << "' is too small for a trajectory header." << std::endl;
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); //      
+    if (view == MAP_FAILED) {
+        std::cerr << "MappedTrajectoryFile: Could not map '" << path << "' into memory." << std::endl;
+        return false;
+    }
+    madvise(view, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+    m_mapping = view;
+    m_mappingSize = static_cast<size_t>(info.st_size);
+#endif
+    m_open = true;
+
+    const unsigned char* header = static_cast<const unsigned char*>(m_mapping);
+    if (std::memcmp(header, TrajectoryFile::MAGIC, sizeof(TrajectoryFile::MAGIC)) != 0) {
+        std::cerr << "MappedTrajectoryFile: '" << path << "' is not a binary trajectory file." << std::endl;
+        close();
+        return false;
+    }
+    std::uint32_t version = getU32(header + OFFSET_VERSION);
+    std::uint64_t headerSize = getU32(header + OFFSET_HEADER_SIZE);
+    std::uint64_t count = getU64(header + OFFSET_COUNT);
+    if (version != TrajectoryFile::VERSION || headerSize < TrajectoryFile::HEADER_SIZE || headerSize % alignof(State) != 0) {
+        std::cerr << "MappedTrajectoryFile: Unsupported format version " << version << " in '" << path << "'." << std::endl;
+        close();
+        return false;
+    }
+    if (headerSize > m_mappingSize || count > (m_mappingSize - headerSize) / sizeof(State)) {
+        std::cerr << "MappedTrajectoryFile: '" << path << "' is truncated (" << count << " points declared)." << std::endl;
+        close();
+        return false;
+    }
+
+    if (!decodeHeader(header, m_params, m_timeUnitSeconds)) {
+        std::cerr << "MappedTrajectoryFile: '" << path << "' has an unknown integrator or too many steps." << std::endl;
+        close();
+        return false;
+    }
+    m_count = static_cast<size_t>(count);
+    const State* mapped = reinterpret_cast<const State*>(header + headerSize);
+    if (isLittleEndianHost()) {
+        m_states = mapped; //  
+    }
+    else {
+        m_swappedStates.assign(mapped, mapped + m_count);
+        byteSwapDoubles(reinterpret_cast<double*>(m_swappedStates.data()), 4 * m_count);
+        m_states = m_swappedStates.data();
+    }
+    return true;
+}
+
+void MappedTrajectoryFile::close() {
+#ifdef _WIN32
+    if (m_mapping) UnmapViewOfFile(m_mapping);
+    if (m_mappingHandle) CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+    if (m_fileHandle) CloseHandle(static_cast<HANDLE>(m_fileHandle));
+    m_mappingHandle = nullptr;
+    m_fileHandle = nullptr;
+#else
+    if (m_mapping) munmap(m_mapping, m_mappingSize);
+#endif
+    m_mapping = nullptr;
+    m_mappingSize = 0;
+    m_states = nullptr;
+    m_count = 0;
+    m_swappedStates.clear();
+    m_open = false;
+}
+
+// --- TrajectoryFileConverter ---
+bool TrajectoryFileConverter::binaryToCsv(const std::string& binaryPath, const std::string& csvPath) {
+    MappedTrajectoryFile input;
+    if (!input.open(binaryPath)) return false;
+
+    CsvTrajectorySink csv(csvPath);
+    if (csv.hasFailed()) return false;
+    csv.begin(input.getParameters());
+    csv.consume(0, input.data(), input.size());
+    csv.end();
+    return !csv.hasFailed();
+}
+
+bool TrajectoryFileConverter::csvToBinary(const std::string& csvPath, const std::string& binaryPath) {
+    std::ifstream inFile(std::filesystem::u8path(csvPath));
+    if (!inFile.is_open()) {
+        std::cerr << "TrajectoryFileConverter: Could not open '" << csvPath << "'." << std::endl;
+        return false;
+    }
+
+    std::vector<State> states;
+    std::vector<double> times;
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(inFile, line)) {
+        ++lineNumber;
+        if (lineNumber == 1) continue; //  
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+        double fields[6];
+        size_t fieldCount = 0;
+        size_t start = 0;
+        while (fieldCount < 6) {
+            size_t comma = line.find(',', start);
+            std::string field = line.substr(start, comma == std::string::npos ? std::string::npos : comma - start);
+            if (!field.empty() && field.back() == '\r') field.pop_back();
+            if (!SimulationConfig::parseDecimal(field, fields[fieldCount])) break;
+            ++fieldCount;
+            if (comma == std::string::npos) break;
+            start = comma + 1;
+        }
+        if (fieldCount != 6) {
+            std::cerr << "TrajectoryFileConverter: Malformed row " << lineNumber << " in '" << csvPath << "'." << std::endl;
+            return false;
+        }
+        times.push_back(fields[1]);
+        states.push_back({ fields[2], fields[3], fields[4], fields[5] });
+    }
+
+    SimulationParameters params;
+    if (times.size() >= 2 && times.back() > times.front()) {
+        params.DT = (times.back() - times.front()) / static_cast<double>(times.size() - 1);
+    }
+    if (!states.empty()) {
+        params.initialState = { states.front().x, states.front().y, states.front().vx, states.front().vy };
+        params.STEPS = static_cast<int>(states.size() - 1);
+    }
+
+    BinaryTrajectorySink output(binaryPath);
+    if (output.hasFailed()) return false;
+    output.begin(params);
+    output.consume(0, states.data(), states.size());
+    output.end();
+    return !output.hasFailed();
+}
@@ -0,0 +1,107 @@
+#include "../include/TrajectoryLod.h"
+
+#include <algorithm> //  std::max, std::min
+#include <cmath>     //  std::hypot, std::sqrt
+
+namespace {
+    //         ( )
+    constexpr size_t MAX_SEGMENT_SPAN = 64;
+
+    //     p   [a, b]
+    double squaredDistanceToSegment(const WorldTrajectoryPoint& p, const WorldTrajectoryPoint& a, const WorldTrajectoryPoint& b) {
+        double dx = b.first - a.first;
+        double dy = b.second - a.second;
+        double px = p.first - a.first;
+        double py = p.second - a.second;
+        double lengthSquared = dx * dx + dy * dy;
+        double t = (lengthSquared > 0.0) ? (px * dx + py * dy) / lengthSquared : 0.0;
+        t = std::min(1.0, std::max(0.0, t));
+        double ex = px - t * dx;
+        double ey = py - t * dy;
+        return ex * ex + ey * ey;
+    }
+
+    //       first + 1 .. last - 1  
+    // [first, last].    ,     
+    //   .
+    double spanSquaredError(const WorldTrajectoryData& points, size_t first, size_t last, double limitSquared) {
+        double error = 0.0;
+        for (size_t i = first + 1; i < last; ++i) {
+            error = std::max(error, squaredDistanceToSegment(points[i], points[first], points[last]));
+            if (error > limitSquared) break; //     
+        }
+        return error;
+    }
+
+    //  :        
+    //  ,          tolerance.
+    //     ,     .
+    // source -     ( );   .
+    double decimateByChord(const WorldTrajectoryData& points, const std::vector<size_t>& source,
+        double tolerance, std::vector<size_t>& result) {
+        result.clear();
+        if (source.empty()) return 0.0;
+
+        const double toleranceSquared = tolerance * tolerance;
+        double maxSquaredError = 0.0;
+        size_t anchor = 0;
+        result.push_back(source[0]);
+        while (anchor + 1 < source.size()) {
+            size_t end = anchor + 1;
+            double endError = spanSquaredError(points, source[anchor], source[end], toleranceSquared);
+            size_t limit = std::min(source.size() - 1, anchor + MAX_SEGMENT_SPAN);
+            while (end < limit) {
+                double error = spanSquaredError(points, source[anchor], source[end + 1], toleranceSquared);
+                if (error > toleranceSquared) break;
+                ++end;
+                endError = error;
+            }
+            maxSquaredError = std::max(maxSquaredError, endError);
+            result.push_back(source[end]);
+            anchor = end;
+        }
+        return std::sqrt(maxSquaredError);
+    }
+}
+
+void TrajectoryLodPyramid::build(const WorldTrajectoryData& points) {
+    m_levels.clear();
+    if (points.size() <= MIN_LEVEL_POINTS) return;
+
+    //   -    ;     ERROR_GROWTH   
+    double length = 0.0;
+    for (size_t i = 1; i < points.size(); ++i) {
+        length += std::hypot(points[i].first - points[i - 1].first, points[i].second - points[i - 1].second);
+    }
+    double tolerance = 1e-3 * length / static_cast<double>(points.size() - 1);
+    if (!(tolerance > 0.0)) return; //       NaN
+
+    std::vector<size_t> source(points.size());
+    for (size_t i = 0; i < source.size(); ++i) source[i] = i;
+
+    //      ,     
+    Level next;
+    for (size_t attempt = 0; attempt < 4 * MAX_LEVELS && m_levels.size() < MAX_LEVELS; ++attempt) {
+        double error = decimateByChord(points, source, tolerance, next.indices);
+        tolerance *= ERROR_GROWTH;
+
+        // ,     ,  :   
+        if (next.indices.size() * 8 > source.size() * 7) continue;
+
+        double previousError = m_levels.empty() ? 0.0 : m_levels.back().maxError;
+        next.maxError = std::max(previousError, error);
+        source = next.indices;
+        m_levels.push_back(std::move(next));
+        next = Level();
+        if (source.size() <= MIN_LEVEL_POINTS) break;
+    }
+}
+
+size_t TrajectoryLodPyramid::selectLevel(double maxWorldError) const {
+    size_t selected = 0;
+    for (size_t i = 0; i < m_levels.size(); ++i) {
+        if (m_levels[i].maxError > maxWorldError) break; // maxError     
+        selected = i + 1;
+    }
+    return selected;
+}
@@ -0,0 +1,163 @@
+#include "../include/TrajectorySink.h"
+
+#include <iostream>  //  std::cerr
+#include <algorithm> //  std::max
+#include <cmath>     //  std::fabs
+
+// --- TrajectoryChunkBuffer ---
+TrajectoryChunkBuffer::TrajectoryChunkBuffer(TrajectorySink& sink, size_t firstIndex)
+    : m_sink(sink),
+    m_buffer(CHUNK_SIZE),
+    m_count(0),
+    m_firstIndex(firstIndex) {
+}
+
+void TrajectoryChunkBuffer::flush() {
+    if (m_count == 0) return;
+    m_sink.consume(m_firstIndex, m_buffer.data(), m_count);
+    m_firstIndex += m_count;
+    m_count = 0;
+}
+
+// --- CollectingSink ---
+void CollectingSink::begin(const SimulationParameters& params) {
+    (void)params;
+    m_states.clear(); //    :      
+}
+
+void CollectingSink::consume(size_t firstIndex, const State* states, size_t count) {
+    (void)firstIndex;
+    m_states.insert(m_states.end(), states, states + count);
+}
+
+// --- ConservationSink ---
+void ConservationSink::begin(const SimulationParameters& params) {
+    m_params = params;
+    m_report = ConservationReport();
+}
+
+void ConservationSink::consume(size_t firstIndex, const State* states, size_t count) {
+    (void)firstIndex;
+    if (count == 0) return;
+    if (m_report.points == 0) {
+        m_report.initialEnergy = Calculations::specificEnergy(states[0], m_params);
+        m_report.initialAngularMomentum = Calculations::specificAngularMomentum(states[0]);
+    }
+    const double energyScale = std::max(std::fabs(m_report.initialEnergy), 1e-300);
+    const double momentumScale = std::max(std::fabs(m_report.initialAngularMomentum), 1e-300);
+    for (size_t i = 0; i < count; ++i) {
+        double energyDrift = std::fabs(Calculations::specificEnergy(states[i], m_params) - m_report.initialEnergy) / energyScale;
+        double momentumDrift = std::fabs(Calculations::specificAngularMomentum(states[i]) - m_report.initialAngularMomentum) / momentumScale;
+        m_report.maxEnergyDrift = std::max(m_report.maxEnergyDrift, energyDrift);
+        m_report.maxAngularMomentumDrift = std::max(m_report.maxAngularMomentumDrift, momentumDrift);
+        m_report.finalEnergyDrift = energyDrift;
+        m_report.finalAngularMomentumDrift = momentumDrift;
+    }
+    m_report.points += count;
+}
+
+// --- LivePreviewSink ---
+LivePreviewSink::LivePreviewSink(size_t maxPoints)
+    : m_maxPoints(std::max<size_t>(maxPoints, 2)),
+    m_stride(1),
+    m_ring(RING_CAPACITY),
+    m_finished(false),
+    m_dropped(0) {
+}
+
+void LivePreviewSink::begin(const SimulationParameters& params) {
+    //   CanvasVertexSink:   m_maxPoints    
+    size_t expected = static_cast<size_t>(std::max(params.STEPS, 0)) + 1;
+    m_stride = std::max<size_t>(1, (expected + m_maxPoints - 2) / (m_maxPoints - 1));
+    m_finished.store(false, std::memory_order_relaxed);
+    m_dropped.store(0, std::memory_order_relaxed);
+}
+
+void LivePreviewSink::consume(size_t firstIndex, const State* states, size_t count) {
+    constexpr size_t BATCH_SIZE = 64;
+    IndexedState batch[BATCH_SIZE];
+    size_t batchCount = 0;
+    size_t dropped = 0;
+
+    size_t offset = (m_stride - firstIndex % m_stride) % m_stride;
+    for (size_t i = offset; i < count; i += m_stride) {
+        batch[batchCount++] = { firstIndex + i, states[i] };
+        if (batchCount == BATCH_SIZE) {
+            dropped += batchCount - m_ring.push(batch, batchCount);
+            batchCount = 0;
+        }
+    }
+    if (batchCount > 0) dropped += batchCount - m_ring.push(batch, batchCount);
+    if (dropped > 0) m_dropped.fetch_add(dropped, std::memory_order_relaxed);
+}
+
+void LivePreviewSink::end() {
+    m_finished.store(true, std::memory_order_release);
+}
+
+// --- CsvTrajectorySink ---
+CsvTrajectorySink::CsvTrajectorySink(const std::string& path)
+    : m_file(path, std::ios::binary),
+    m_out(nullptr),
+    m_dt(0.0),
+    m_failed(false) {
+    if (!m_file.is_open()) {
+        std::cerr << "CsvTrajectorySink: Could not open file '" << path << "' for writing." << std::endl;
+        m_failed = true;
+    }
+    else {
+        m_out = &m_file;
+    }
+}
+
+CsvTrajectorySink::CsvTrajectorySink(std::ostream& out)
+    : m_out(&out),
+    m_dt(0.0),
+    m_failed(false) {
+}
+
+void CsvTrajectorySink::begin(const SimulationParameters& params) {
+    m_dt = params.DT;
+    if (!m_out) return;
+    m_writer = std::make_unique<CsvTrajectoryWriter>(*m_out);
+    m_writer->writeHeader();
+}
+
+void CsvTrajectorySink::consume(size_t firstIndex, const State* states, size_t count) {
+    if (!m_writer) return;
+    m_writer->writeRows(firstIndex, states, count, m_dt);
+}
+
+void CsvTrajectorySink::end() {
+    if (!m_out) return;
+    if (m_writer) m_writer->flush();
+    m_writer.reset();
+    if (m_out == &m_file) m_file.close();
+    else m_out->flush();
+    if (m_out->fail()) {
+        std::cerr << "CsvTrajectorySink: Failed to write or close the trajectory file." << std::endl;
+        m_failed = true;
+    }
+    m_out = nullptr;
+}
+
+// --- FanOutSink ---
+FanOutSink::FanOutSink(std::vector<std::shared_ptr<TrajectorySink>> sinks)
+    : m_sinks(std::move(sinks)) {
+}
+
+void FanOutSink::add(std::shared_ptr<TrajectorySink> sink) {
+    if (sink) m_sinks.push_back(std::move(sink));
+}
+
+void FanOutSink::begin(const SimulationParameters& params) {
+    for (auto& sink : m_sinks) sink->begin(params);
+}
+
+void FanOutSink::consume(size_t firstIndex, const State* states, size_t count) {
+    for (auto& sink : m_sinks) sink->consume(firstIndex, states, count);
+}
+
+void FanOutSink::end() {
+    for (auto& sink : m_sinks) sink->end();
+}
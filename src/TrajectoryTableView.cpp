@@ -0,0 +1,167 @@
+#include "../include/TrajectoryTableView.h"
+#include "../include/SimulationConfig.h" //  SECONDS_PER_DAY
+
+#include <algorithm> //  std::min
+#include <charconv>  //  std::to_chars
+#include <climits>   //  UINT_MAX
+#include <cmath>     //  std::ceil, std::floor, std::lround
+#include <iterator>  //  std::prev
+#include <string>
+
+void TrajectoryTableView::create(const tgui::Panel::Ptr& parent, const tgui::Layout2d& position, const tgui::Layout2d& rowsAreaSize, float scrollbarWidth) {
+    m_rowsPanel = tgui::Panel::create();
+    m_rowsPanel->setPosition(position);
+    m_rowsPanel->setSize(rowsAreaSize);
+    m_rowsPanel->getRenderer()->setBackgroundColor(tgui::Color(245, 245, 245));
+    parent->add(m_rowsPanel);
+
+    //     ,    :      float
+    m_scrollbar = tgui::Scrollbar::create();
+    m_scrollbar->setPosition({ tgui::bindRight(m_rowsPanel), tgui::bindTop(m_rowsPanel) });
+    m_scrollbar->setSize({ scrollbarWidth, tgui::bindHeight(m_rowsPanel) });
+    m_scrollbar->setAutoHide(false);
+    m_scrollbar->setScrollAmount(WHEEL_SCROLL_ROWS);
+    m_scrollbar->setMaximum(0);
+    m_scrollbar->onValueChange.connect([this](unsigned int value) {
+        m_firstRow = value;
+        refreshVisibleRows();
+    });
+    parent->add(m_scrollbar);
+
+    m_emptyLabel = tgui::Label::create(L"   ");
+    m_emptyLabel->setHorizontalAlignment(tgui::Label::HorizontalAlignment::Center);
+    m_emptyLabel->setVerticalAlignment(tgui::Label::VerticalAlignment::Center);
+    m_emptyLabel->setSize({ "100%", ROW_HEIGHT });
+    m_rowsPanel->add(m_emptyLabel);
+
+    //       TGUI;      
+    m_rowsPanel->onSizeChange.connect([this]() { updateRowPool(); });
+    updateRowPool();
+}
+
+void TrajectoryTableView::setTrajectory(const State* states, size_t count, double dt, double timeUnitSeconds) {
+    m_states = (count > 0) ? states : nullptr;
+    m_count = (m_states != nullptr) ? count : 0;
+    m_dt = dt;
+    m_timeUnitSeconds = timeUnitSeconds;
+    m_firstRow = 0;
+    m_rowCache.clear();
+    m_rowCacheIndex.clear();
+    for (auto& row : m_rows) row.shownIndex = NO_ROW;
+    if (m_scrollbar) {
+        m_scrollbar->setMaximum(static_cast<unsigned int>(std::min<size_t>(m_count, UINT_MAX)));
+        m_scrollbar->setValue(0);
+    }
+    refreshVisibleRows();
+}
+
+bool TrajectoryTableView::handleMouseWheel(const sf::Event& event) {
+    if (event.type != sf::Event::MouseWheelScrolled || event.mouseWheelScroll.wheel != sf::Mouse::VerticalWheel) return false;
+    if (!m_rowsPanel || !m_scrollbar || m_count == 0) return false;
+
+    tgui::Vector2f topLeft = m_rowsPanel->getAbsolutePosition();
+    tgui::Vector2f size = m_rowsPanel->getSize();
+    float x = static_cast<float>(event.mouseWheelScroll.x);
+    float y = static_cast<float>(event.mouseWheelScroll.y);
+    if (x < topLeft.x || y < topLeft.y || x >= topLeft.x + size.x || y >= topLeft.y + size.y) return false;
+
+    long long rows = std::lround(event.mouseWheelScroll.delta * static_cast<float>(WHEEL_SCROLL_ROWS));
+    long long value = static_cast<long long>(m_scrollbar->getValue()) - rows;
+    m_scrollbar->setValue(static_cast<unsigned int>(std::max(0LL, value))); //     
+    return true;
+}
+
+void TrajectoryTableView::updateRowPool() {
+    float height = m_rowsPanel->getSize().y;
+    size_t neededRows = (height > 0.f) ? static_cast<size_t>(std::ceil(height / ROW_HEIGHT)) : 0;
+
+    const tgui::String columnWidth = tgui::String::fromNumber(100.f / COLUMN_COUNT) + "%";
+    while (m_rows.size() < neededRows) {
+        const float top = static_cast<float>(m_rows.size()) * ROW_HEIGHT;
+        RowWidgets row;
+        for (size_t j = 0; j < COLUMN_COUNT; ++j) {
+            auto cellLabel = tgui::Label::create();
+            cellLabel->getRenderer()->setTextColor(tgui::Color::Black);
+            cellLabel->setHorizontalAlignment(tgui::Label::HorizontalAlignment::Center);
+            cellLabel->setVerticalAlignment(tgui::Label::VerticalAlignment::Center);
+            cellLabel->setSize({ columnWidth, ROW_HEIGHT });
+            cellLabel->setPosition({ tgui::String::fromNumber(100.f * j / COLUMN_COUNT) + "%", top });
+
+            float rightBorder = (j < COLUMN_COUNT - 1) ? 1.f : 0.f;
+            cellLabel->getRenderer()->setBorders({ 0, 0, rightBorder, 0 });
+            cellLabel->getRenderer()->setBorderColor(tgui::Color(200, 200, 200));
+            m_rowsPanel->add(cellLabel);
+            row.cells[j] = cellLabel;
+        }
+        m_rows.push_back(row);
+    }
+    while (m_rows.size() > neededRows) {
+        for (auto& cellLabel : m_rows.back().cells) m_rowsPanel->remove(cellLabel);
+        m_rows.pop_back();
+    }
+
+    //   : ,  ,    
+    unsigned int fullRows = static_cast<unsigned int>(std::floor(height / ROW_HEIGHT));
+    m_scrollbar->setViewportSize(std::max(1u, fullRows));
+    m_firstRow = m_scrollbar->getValue();
+    refreshVisibleRows();
+}
+
+void TrajectoryTableView::refreshVisibleRows() {
+    if (m_emptyLabel) m_emptyLabel->setVisible(m_count == 0);
+    for (size_t r = 0; r < m_rows.size(); ++r) {
+        size_t index = m_firstRow + r;
+        bool visible = index < m_count;
+        if (visible) fillRow(m_rows[r], index);
+        else m_rows[r].shownIndex = NO_ROW;
+        for (auto& cellLabel : m_rows[r].cells) cellLabel->setVisible(visible);
+    }
+}
+
+void TrajectoryTableView::fillRow(RowWidgets& row, size_t index) {
+    if (row.shownIndex == index) return;
+    const FormattedRow& cells = getFormattedRow(index);
+    for (size_t j = 0; j < COLUMN_COUNT; ++j) row.cells[j]->setText(cells[j]);
+    row.shownIndex = index;
+}
+
+const TrajectoryTableView::FormattedRow& TrajectoryTableView::getFormattedRow(size_t index) {
+    auto found = m_rowCacheIndex.find(index);
+    if (found != m_rowCacheIndex.end()) {
+        m_rowCache.splice(m_rowCache.begin(), m_rowCache, found->second);
+        return found->second->second;
+    }
+
+    //        
+    if (m_rowCache.size() >= ROW_CACHE_CAPACITY) {
+        m_rowCacheIndex.erase(m_rowCache.back().first);
+        m_rowCache.splice(m_rowCache.begin(), m_rowCache, std::prev(m_rowCache.end()));
+    }
+    else {
+        m_rowCache.emplace_front();
+    }
+    auto& entry = m_rowCache.front();
+    entry.first = index;
+    formatRow(index, entry.second);
+    m_rowCacheIndex[index] = m_rowCache.begin();
+    return entry.second;
+}
+
+void TrajectoryTableView::formatRow(size_t index, FormattedRow& cells) {
+    //    (  CSV):   
+    const double timeUnit = (m_timeUnitSeconds > 0.0) ? m_timeUnitSeconds : SimulationConfig::SECONDS_PER_DAY;
+
+    const State& state = m_states[index];
+    const double values[COLUMN_COUNT] = {
+        static_cast<double>(index) * m_dt * timeUnit / SimulationConfig::SECONDS_PER_DAY,
+        state.x, state.y, state.vx, state.vy
+    };
+    char* first = m_formatBuffer.data();
+    char* last = first + m_formatBuffer.size();
+    for (size_t j = 0; j < COLUMN_COUNT; ++j) {
+        //   ,   std::fixed << std::setprecision(2),     
+        auto result = std::to_chars(first, last, values[j], std::chars_format::fixed, CELL_PRECISION);
+        if (result.ec != std::errc()) cells[j] = "?";
+        else cells[j] = tgui::String(std::string(first, result.ptr));
+    }
+}
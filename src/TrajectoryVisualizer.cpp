@@ -2,8 +2,16 @@
 
 TrajectoryVisualizer::TrajectoryVisualizer(unsigned int width, unsigned int height, const std::wstring& windowTitle)
     : m_window(sf::VideoMode(width, height), windowTitle, sf::Style::Default), //  L""    ,  
+    m_bodyLines(sf::Lines),
+    m_bodyLinesFrames(0),
+    m_bodyPoints(sf::Points),
+    m_useVertexBuffers(sf::VertexBuffer::isAvailable()),
+    m_drawnLodLevel(0),
+    m_drawnVertexCount(0),
+    m_rebasedChunkCount(0),
     m_scale(DEFAULT_SCALE),
-    m_offset(0.f, 0.f),
+    m_viewCenterX(0.0),
+    m_viewCenterY(0.0),
     m_screenCenter(static_cast<float>(width) / 2.f, static_cast<float>(height) / 2.f),
     m_currentPointIndex(0),
     m_pointsPerFrame(DEFAULT_POINTS_PER_FRAME),
@@ -16,15 +24,34 @@ TrajectoryVisualizer::TrajectoryVisualizer(unsigned int width, unsigned int heig
 
 void TrajectoryVisualizer::setData(const WorldTrajectoryData& data) {
     m_worldTrajectoryData = data;
+    if (m_liveSource) m_lodPyramid = TrajectoryLodPyramid(); //    
+    else m_lodPyramid.build(m_worldTrajectoryData);
+    std::cout << "TrajectoryVisualizer: " << m_worldTrajectoryData.size() << " ,  : "
+        << m_lodPyramid.getLevelCount() << "\n";
+    uploadTrajectoryVertices();
     resetViewAndAnimation();
 }
 
+void TrajectoryVisualizer::setBodyTracks(std::vector<WorldTrajectoryData>&& tracks) {
+    m_bodyTracks.clear();
+    m_bodyLines.clear();
+    m_bodyLinesFrames = 0;
+    if (tracks.empty()) {
+        setData(WorldTrajectoryData());
+        return;
+    }
+    m_bodyTracks.assign(std::make_move_iterator(tracks.begin() + 1), std::make_move_iterator(tracks.end()));
+    m_bodyPoints.resize(m_bodyTracks.size());
+    setData(tracks[0]);
+}
+
 void TrajectoryVisualizer::run() {
     if (m_worldTrajectoryData.empty()) {
-        std::cerr << "TrajectoryVisualizer:    .  .\n";
+        if (!m_liveSource) std::cerr << "TrajectoryVisualizer:    .  .\n";
         
         bool dataNotLoaded = true;
         while (m_window.isOpen() && dataNotLoaded) {
+            pollLiveSource();
             sf::Event event{};
             while (m_window.pollEvent(event)) {
                 if (event.type == sf::Event::Closed) m_window.close();
@@ -37,7 +64,7 @@ void TrajectoryVisualizer::run() {
             m_window.draw(m_infoText); //  - (   )
             m_window.display();
             
-            if (!m_worldTrajectoryData.empty()) dataNotLoaded = false; //      /
+            if (!m_worldTrajectoryData.empty()) dataNotLoaded = false; //      
         }
         if (!m_window.isOpen()) return; //    
     }
@@ -48,6 +75,7 @@ void TrajectoryVisualizer::run() {
             handleEvent(event);
         }
         
+        pollLiveSource();
         updateAnimation();
         updateInfoText();
         draw();
@@ -56,46 +84,251 @@ void TrajectoryVisualizer::run() {
 
 void TrajectoryVisualizer::resetViewAndAnimation() {
     m_scale = DEFAULT_SCALE;
-    m_offset = { 0.f, 0.f };
+    m_viewCenterX = 0.0;
+    m_viewCenterY = 0.0;
     m_isPaused = false;
     m_showAllPointsImmediately = false;
     m_pointsPerFrame = DEFAULT_POINTS_PER_FRAME;
     m_currentPointIndex = m_worldTrajectoryData.empty() ? 0 : 1;
-    recalculateScreenTrajectory();
 }
 
 sf::Vector2f TrajectoryVisualizer::toScreenCoords(double worldX, double worldY) const {
+    //    double,  float    
     return {
-        m_screenCenter.x + m_offset.x + static_cast<float>(worldX) * m_scale,
-        m_screenCenter.y + m_offset.y - static_cast<float>(worldY) * m_scale
+        static_cast<float>(m_screenCenter.x + (worldX - m_viewCenterX) * m_scale),
+        static_cast<float>(m_screenCenter.y - (worldY - m_viewCenterY) * m_scale)
     };
 }
 
-sf::Vector2f TrajectoryVisualizer::toWorldCoords(sf::Vector2f screenPos) const {
+WorldTrajectoryPoint TrajectoryVisualizer::toWorldCoords(sf::Vector2f screenPos) const {
     return {
-        (screenPos.x - m_screenCenter.x - m_offset.x) / m_scale,
-       -(screenPos.y - m_screenCenter.y - m_offset.y) / m_scale
+        m_viewCenterX + (screenPos.x - m_screenCenter.x) / m_scale,
+        m_viewCenterY - (screenPos.y - m_screenCenter.y) / m_scale
     };
 }
 
-void TrajectoryVisualizer::recalculateScreenTrajectory() {
-    m_screenTrajectory.clear();
+sf::Transform TrajectoryVisualizer::getWorldToScreenTransform(double originX, double originY) const {
+    sf::Transform transform;
+    transform.translate(toScreenCoords(originX, originY));
+    transform.scale(static_cast<float>(m_scale), static_cast<float>(-m_scale)); //  Y   
+    return transform;
+}
+
+const WorldTrajectoryPoint& TrajectoryVisualizer::getLevelPoint(size_t level, size_t vertex) const {
+    if (level == 0) return m_worldTrajectoryData[vertex];
+    return m_worldTrajectoryData[m_lodPyramid.getLevel(level).indices[vertex]];
+}
+
+void TrajectoryVisualizer::uploadTrajectoryVertices() {
+    m_levelChunks.clear();
     if (m_worldTrajectoryData.empty()) return;
 
-    m_screenTrajectory.reserve(m_worldTrajectoryData.size());
-    for (const auto& world_point : m_worldTrajectoryData) {
-        m_screenTrajectory.emplace_back(toScreenCoords(world_point.first, world_point.second), sf::Color::White);
+    m_levelChunks.resize(m_lodPyramid.getLevelCount());
+    for (size_t level = 0; level < m_levelChunks.size(); ++level) {
+        const size_t levelVertexCount = (level == 0) ? m_worldTrajectoryData.size() : m_lodPyramid.getLevel(level).indices.size();
+        if (!extendLevelChunks(level, levelVertexCount)) {
+            std::cerr << "TrajectoryVisualizer:      sf::VertexBuffer,   .\n";
+            m_useVertexBuffers = false;
+            uploadTrajectoryVertices();
+            return;
+        }
+    }
+}
+
+//     levelVertexCount :    ,
+//      .     .
+bool TrajectoryVisualizer::extendLevelChunks(size_t level, size_t levelVertexCount) {
+    std::vector<TrajectoryChunk>& chunks = m_levelChunks[level];
+    if (levelVertexCount == 0) return true;
+
+    if (!chunks.empty()) {
+        TrajectoryChunk& last = chunks.back();
+        const size_t newCount = std::min(CHUNK_VERTICES + 1, levelVertexCount - last.firstVertex);
+        if (newCount > last.vertexCount) {
+            for (size_t v = last.firstVertex + last.vertexCount; v < last.firstVertex + newCount; ++v) {
+                const WorldTrajectoryPoint& point = getLevelPoint(level, v);
+                last.minX = std::min(last.minX, point.first);
+                last.maxX = std::max(last.maxX, point.first);
+                last.minY = std::min(last.minY, point.second);
+                last.maxY = std::max(last.maxY, point.second);
+            }
+            last.vertexCount = newCount;
+            if (!fillChunk(level, last)) return false;
+        }
+    }
+
+    size_t first = chunks.empty() ? 0 : chunks.back().firstVertex + CHUNK_VERTICES;
+    while (first + 1 < levelVertexCount || chunks.empty()) {
+        TrajectoryChunk chunk;
+        chunk.firstVertex = first;
+        chunk.vertexCount = std::min(CHUNK_VERTICES + 1, levelVertexCount - first); // +1:     
+        const WorldTrajectoryPoint& firstPoint = getLevelPoint(level, first);
+        chunk.originX = firstPoint.first;
+        chunk.originY = firstPoint.second;
+        chunk.minX = chunk.maxX = firstPoint.first;
+        chunk.minY = chunk.maxY = firstPoint.second;
+        for (size_t v = first; v < first + chunk.vertexCount; ++v) {
+            const WorldTrajectoryPoint& point = getLevelPoint(level, v);
+            chunk.minX = std::min(chunk.minX, point.first);
+            chunk.maxX = std::max(chunk.maxX, point.first);
+            chunk.minY = std::min(chunk.minY, point.second);
+            chunk.maxY = std::max(chunk.maxY, point.second);
+        }
+        if (m_useVertexBuffers) {
+            chunk.buffer.setPrimitiveType(sf::LineStrip);
+            chunk.buffer.setUsage(sf::VertexBuffer::Dynamic); //     
+        }
+        if (!fillChunk(level, chunk)) return false;
+        chunks.push_back(std::move(chunk));
+        first += CHUNK_VERTICES;
     }
+    return true;
+}
 
-    if (!m_showAllPointsImmediately) {
-        m_currentPointIndex = std::min(m_currentPointIndex, m_screenTrajectory.size());
-        if (m_currentPointIndex == 0 && !m_screenTrajectory.empty()) {
-            m_currentPointIndex = 1;
+//          (   ).
+//     ,   .
+void TrajectoryVisualizer::pollLiveSource() {
+    if (!m_liveSource) return;
+
+    const size_t oldSize = m_worldTrajectoryData.size();
+    const bool running = m_liveSource(m_worldTrajectoryData);
+    if (!running) {
+        m_liveSource = nullptr;
+        //      :     
+        if (oldSize > 0 && m_worldTrajectoryData.size() != oldSize) {
+            m_currentPointIndex = static_cast<size_t>(static_cast<double>(m_currentPointIndex) * m_worldTrajectoryData.size() / oldSize);
         }
+        m_lodPyramid.build(m_worldTrajectoryData);
+        uploadTrajectoryVertices();
+        std::cout << "TrajectoryVisualizer:  , " << m_worldTrajectoryData.size() << " ,  : "
+            << m_lodPyramid.getLevelCount() << "\n";
+        return;
     }
-    else {
-        m_currentPointIndex = m_screenTrajectory.size();
+    if (m_worldTrajectoryData.size() == oldSize) return;
+
+    if (m_levelChunks.empty()) m_levelChunks.resize(1);
+    if (!extendLevelChunks(0, m_worldTrajectoryData.size())) {
+        std::cerr << "TrajectoryVisualizer:      sf::VertexBuffer,   .\n";
+        m_useVertexBuffers = false;
+        uploadTrajectoryVertices();
     }
+    if (oldSize == 0) m_currentPointIndex = 1; //      
+}
+
+bool TrajectoryVisualizer::fillChunk(size_t level, TrajectoryChunk& chunk) {
+    std::vector<sf::Vertex>& vertices = chunk.vertices;
+    vertices.clear();
+    vertices.reserve(chunk.vertexCount);
+    for (size_t v = chunk.firstVertex; v < chunk.firstVertex + chunk.vertexCount; ++v) {
+        const WorldTrajectoryPoint& point = getLevelPoint(level, v);
+        vertices.emplace_back(sf::Vector2f(static_cast<float>(point.first - chunk.originX),
+            static_cast<float>(point.second - chunk.originY)), sf::Color::White);
+    }
+    if (!m_useVertexBuffers) return true;
+
+    bool uploaded = (chunk.buffer.getVertexCount() == vertices.size() || chunk.buffer.create(vertices.size()))
+        && chunk.buffer.update(vertices.data());
+    std::vector<sf::Vertex>().swap(vertices); //     ,    
+    return uploaded;
+}
+
+void TrajectoryVisualizer::drawTrajectory(size_t pointsToDraw) {
+    //   ,            
+    m_drawnLodLevel = m_lodPyramid.selectLevel(LOD_MAX_PIXEL_ERROR / m_scale);
+
+    //      
+    size_t vertexCount = pointsToDraw;
+    size_t lastDrawnIndex = pointsToDraw - 1;
+    if (m_drawnLodLevel > 0) {
+        const std::vector<size_t>& indices = m_lodPyramid.getLevel(m_drawnLodLevel).indices;
+        vertexCount = static_cast<size_t>(std::lower_bound(indices.begin(), indices.end(), pointsToDraw) - indices.begin());
+        lastDrawnIndex = indices[vertexCount - 1]; // indices[0] == 0,  vertexCount >= 1
+    }
+
+    //     
+    const sf::Vector2u windowSize = m_window.getSize();
+    const WorldTrajectoryPoint viewMin = toWorldCoords({ 0.f, static_cast<float>(windowSize.y) });
+    const WorldTrajectoryPoint viewMax = toWorldCoords({ static_cast<float>(windowSize.x), 0.f });
+
+    m_drawnVertexCount = 0;
+    for (TrajectoryChunk& chunk : m_levelChunks[m_drawnLodLevel]) {
+        if (chunk.firstVertex >= vertexCount) break;
+        if (chunk.maxX < viewMin.first || chunk.minX > viewMax.first ||
+            chunk.maxY < viewMin.second || chunk.minY > viewMax.second) {
+            continue; //    
+        }
+
+        //      : float-    
+        double originDistance = std::max(std::abs(chunk.originX - m_viewCenterX), std::abs(chunk.originY - m_viewCenterY));
+        if (originDistance * m_scale > REBASE_PIXEL_DISTANCE) {
+            chunk.originX = m_viewCenterX;
+            chunk.originY = m_viewCenterY;
+            fillChunk(m_drawnLodLevel, chunk);
+            ++m_rebasedChunkCount;
+        }
+
+        size_t count = std::min(chunk.vertexCount, vertexCount - chunk.firstVertex);
+        sf::RenderStates states(getWorldToScreenTransform(chunk.originX, chunk.originY));
+        if (m_useVertexBuffers) {
+            m_window.draw(chunk.buffer, 0, count, states);
+        }
+        else {
+            m_window.draw(chunk.vertices.data(), count, sf::LineStrip, states);
+        }
+        m_drawnVertexCount += count;
+    }
+
+    //          (  )
+    if (lastDrawnIndex != pointsToDraw - 1) {
+        const auto& from = m_worldTrajectoryData[lastDrawnIndex];
+        const auto& to = m_worldTrajectoryData[pointsToDraw - 1];
+        sf::Vertex headSegment[2] = {
+            sf::Vertex(sf::Vector2f(static_cast<float>(from.first - m_viewCenterX), static_cast<float>(from.second - m_viewCenterY)), sf::Color::White),
+            sf::Vertex(sf::Vector2f(static_cast<float>(to.first - m_viewCenterX), static_cast<float>(to.second - m_viewCenterY)), sf::Color::White)
+        };
+        m_window.draw(headSegment, 2, sf::Lines, sf::RenderStates(getWorldToScreenTransform(m_viewCenterX, m_viewCenterY)));
+        ++m_drawnVertexCount;
+    }
+}
+
+void TrajectoryVisualizer::drawBodies(size_t framesToDraw) {
+    const size_t lineBodies = std::min(m_bodyTracks.size(), MAX_BODY_POLYLINES);
+
+    //    (R, F):   ,     
+    if (framesToDraw < m_bodyLinesFrames) {
+        m_bodyLines.clear();
+        m_bodyLinesFrames = 0;
+    }
+    const size_t builtFrames = std::max<size_t>(m_bodyLinesFrames, 1);
+    for (size_t frame = builtFrames; frame < framesToDraw; ++frame) {
+        for (size_t body = 0; body < lineBodies; ++body) {
+            const WorldTrajectoryPoint& from = m_bodyTracks[body][frame - 1];
+            const WorldTrajectoryPoint& to = m_bodyTracks[body][frame];
+            const sf::Color color = getBodyColor(body + 1);
+            m_bodyLines.append(sf::Vertex(sf::Vector2f(static_cast<float>(from.first), static_cast<float>(from.second)), color));
+            m_bodyLines.append(sf::Vertex(sf::Vector2f(static_cast<float>(to.first), static_cast<float>(to.second)), color));
+        }
+    }
+    m_bodyLinesFrames = std::max(builtFrames, framesToDraw);
+
+    for (size_t body = 0; body < m_bodyTracks.size(); ++body) {
+        const WorldTrajectoryPoint& point = m_bodyTracks[body][framesToDraw - 1];
+        m_bodyPoints[body] = sf::Vertex(sf::Vector2f(static_cast<float>(point.first), static_cast<float>(point.second)), getBodyColor(body + 1));
+    }
+
+    const sf::RenderStates states(getWorldToScreenTransform(0.0, 0.0));
+    m_window.draw(m_bodyLines, states);
+    m_window.draw(m_bodyPoints, states);
+}
+
+//     ;  0 ,   
+sf::Color TrajectoryVisualizer::getBodyColor(size_t body) {
+    static const sf::Color PALETTE[] = {
+        sf::Color(255, 99, 71), sf::Color(100, 181, 246), sf::Color(129, 199, 132), sf::Color(255, 213, 79),
+        sf::Color(186, 104, 200), sf::Color(77, 208, 225), sf::Color(255, 138, 101), sf::Color(174, 213, 129)
+    };
+    if (body == 0) return sf::Color::White;
+    return PALETTE[(body - 1) % (sizeof(PALETTE) / sizeof(PALETTE[0]))];
 }
 
 void TrajectoryVisualizer::setupInfoText() {
@@ -112,8 +345,15 @@ void TrajectoryVisualizer::updateInfoText() {
     std::wostringstream oss;
     oss << std::fixed << std::setprecision(2);
     oss << L": " << m_scale << "\n";
-    oss << L": (" << m_offset.x << ", " << m_offset.y << ")\n";
-    oss << L" : " << m_currentPointIndex << "/" << m_worldTrajectoryData.size() << "\n";
+    oss << L" : (" << std::setprecision(9) << m_viewCenterX << ", " << m_viewCenterY << ")\n" << std::setprecision(2);
+    oss << L" : " << m_currentPointIndex << "/" << m_worldTrajectoryData.size()
+        << (m_liveSource ? L" ( )" : L"") << "\n";
+    if (!m_bodyTracks.empty()) {
+        oss << L": " << (m_bodyTracks.size() + 1) << L" (  : "
+            << (std::min(m_bodyTracks.size(), MAX_BODY_POLYLINES) + 1) << ")\n";
+    }
+    oss << L":  " << m_drawnLodLevel << L"  " << (m_lodPyramid.getLevelCount() - 1)
+        << " (" << m_drawnVertexCount << L" ,  : " << m_rebasedChunkCount << ")\n";
     oss << L": " << (m_isPaused ? L"" : L"")
         << " (" << m_pointsPerFrame << L" /)\n";
     oss << L":\n";
@@ -138,7 +378,6 @@ void TrajectoryVisualizer::handleEvent(const sf::Event& event) {
         sf::FloatRect visibleArea(0, 0, static_cast<float>(event.size.width), static_cast<float>(event.size.height));
         m_window.setView(sf::View(visibleArea));
         m_screenCenter = { event.size.width / 2.f, event.size.height / 2.f };
-        recalculateScreenTrajectory();
     }
     break;
     case sf::Event::KeyPressed:
@@ -146,13 +385,13 @@ void TrajectoryVisualizer::handleEvent(const sf::Event& event) {
         break;
     case sf::Event::MouseWheelScrolled:
         if (event.mouseWheelScroll.wheel == sf::Mouse::VerticalWheel && event.mouseWheelScroll.delta != 0) { //   
-            sf::Vector2f worldPosBeforeZoom = toWorldCoords(static_cast<sf::Vector2f>(sf::Mouse::getPosition(m_window)));
-            float zoomFactor = (event.mouseWheelScroll.delta > 0) ? ZOOM_FACTOR_STEP : 1.0f / ZOOM_FACTOR_STEP;
+            //       
+            sf::Vector2f mousePos = static_cast<sf::Vector2f>(sf::Mouse::getPosition(m_window));
+            WorldTrajectoryPoint worldPosBeforeZoom = toWorldCoords(mousePos);
+            double zoomFactor = (event.mouseWheelScroll.delta > 0) ? ZOOM_FACTOR_STEP : 1.0 / ZOOM_FACTOR_STEP;
             m_scale *= zoomFactor;
-            sf::Vector2f worldPosAfterZoom = toWorldCoords(static_cast<sf::Vector2f>(sf::Mouse::getPosition(m_window)));
-            m_offset.x += (worldPosAfterZoom.x - worldPosBeforeZoom.x) * m_scale;
-            m_offset.y += (worldPosAfterZoom.y - worldPosBeforeZoom.y) * m_scale;
-            recalculateScreenTrajectory();
+            m_viewCenterX = worldPosBeforeZoom.first - (mousePos.x - m_screenCenter.x) / m_scale;
+            m_viewCenterY = worldPosBeforeZoom.second + (mousePos.y - m_screenCenter.y) / m_scale;
         }
         break;
     case sf::Event::MouseButtonPressed:
@@ -170,9 +409,9 @@ void TrajectoryVisualizer::handleEvent(const sf::Event& event) {
         if (m_isDragging) {
             sf::Vector2i newMousePos = sf::Mouse::getPosition(m_window);
             sf::Vector2f delta = static_cast<sf::Vector2f>(newMousePos - m_lastMousePos);
-            m_offset += delta;
+            m_viewCenterX -= delta.x / m_scale;
+            m_viewCenterY += delta.y / m_scale;
             m_lastMousePos = newMousePos;
-            recalculateScreenTrajectory();
         }
         break;
     default:
@@ -186,10 +425,10 @@ void TrajectoryVisualizer::handleKeyPress(const sf::Event::KeyEvent& keyEvent) {
     if (keyEvent.code == sf::Keyboard::F) {
         m_showAllPointsImmediately = !m_showAllPointsImmediately;
         if (m_showAllPointsImmediately) {
-            m_currentPointIndex = m_screenTrajectory.size();
+            m_currentPointIndex = m_worldTrajectoryData.size();
         }
         else {
-            m_currentPointIndex = m_screenTrajectory.empty() ? 0 : 1;
+            m_currentPointIndex = m_worldTrajectoryData.empty() ? 0 : 1;
         }
     }
     if (keyEvent.code == sf::Keyboard::Add || keyEvent.code == sf::Keyboard::Equal) { // Equal  +   
@@ -202,32 +441,36 @@ void TrajectoryVisualizer::handleKeyPress(const sf::Event::KeyEvent& keyEvent) {
 }
 
 void TrajectoryVisualizer::updateAnimation() {
-    if (!m_isPaused && !m_showAllPointsImmediately && m_currentPointIndex < m_screenTrajectory.size()) {
-        m_currentPointIndex = std::min(m_screenTrajectory.size(), m_currentPointIndex + m_pointsPerFrame);
+    if (!m_isPaused && !m_showAllPointsImmediately && m_currentPointIndex < m_worldTrajectoryData.size()) {
+        m_currentPointIndex = std::min(m_worldTrajectoryData.size(), m_currentPointIndex + m_pointsPerFrame);
     }
 }
 
 void TrajectoryVisualizer::draw() {
     m_window.clear(sf::Color::Black);
 
-    sf::CircleShape centerMassShape(CENTER_POINT_RADIUS);
-    centerMassShape.setFillColor(sf::Color::Red);
-    centerMassShape.setOrigin(CENTER_POINT_RADIUS, CENTER_POINT_RADIUS);
-    centerMassShape.setPosition(toScreenCoords(0, 0));
-    m_window.draw(centerMassShape);
+    //   N     :      
+    if (m_bodyTracks.empty()) {
+        sf::CircleShape centerMassShape(CENTER_POINT_RADIUS);
+        centerMassShape.setFillColor(sf::Color::Red);
+        centerMassShape.setOrigin(CENTER_POINT_RADIUS, CENTER_POINT_RADIUS);
+        centerMassShape.setPosition(toScreenCoords(0, 0));
+        m_window.draw(centerMassShape);
+    }
 
-    if (!m_screenTrajectory.empty()) {
-        size_t pointsToDraw = std::min(m_currentPointIndex, m_screenTrajectory.size());
-        if (pointsToDraw >= 2) {
-            m_window.draw(&m_screenTrajectory[0], pointsToDraw, sf::LineStrip);
-        }
-        else if (pointsToDraw == 1) {
-            sf::CircleShape firstPointShape(TRAJECTORY_START_POINT_RADIUS);
-            firstPointShape.setFillColor(sf::Color::White);
-            firstPointShape.setOrigin(TRAJECTORY_START_POINT_RADIUS, TRAJECTORY_START_POINT_RADIUS);
-            firstPointShape.setPosition(m_screenTrajectory[0].position);
-            m_window.draw(firstPointShape);
-        }
+    size_t pointsToDraw = std::min(m_currentPointIndex, m_worldTrajectoryData.size());
+    if (pointsToDraw >= 1 && !m_bodyTracks.empty()) {
+        drawBodies(pointsToDraw);
+    }
+    if (pointsToDraw >= 2) {
+        drawTrajectory(pointsToDraw);
+    }
+    else if (pointsToDraw == 1) {
+        sf::CircleShape firstPointShape(TRAJECTORY_START_POINT_RADIUS);
+        firstPointShape.setFillColor(sf::Color::White);
+        firstPointShape.setOrigin(TRAJECTORY_START_POINT_RADIUS, TRAJECTORY_START_POINT_RADIUS);
+        firstPointShape.setPosition(toScreenCoords(m_worldTrajectoryData[0].first, m_worldTrajectoryData[0].second));
+        m_window.draw(firstPointShape);
     }
 
     m_window.draw(m_infoText);
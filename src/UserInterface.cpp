@@ -24,6 +24,35 @@
 #include <string>       //  std::string, std::stod, substr, find
 #include <locale>       //  std::locale, std::codecvt
 #include <codecvt>      //  std::wstring_convert
+#include <climits>      //  INT_MAX
+#include <cstdio>       //  std::snprintf
+#include <ctime>        //  std::clock
+
+//      (  )
+static double getProcessCpuSeconds() {
+#ifdef _WIN32
+    //  MSVC std::clock   ,      
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime)) return 0.0;
+    auto toTicks = [](const FILETIME& t) {
+        return (static_cast<unsigned long long>(t.dwHighDateTime) << 32) | t.dwLowDateTime;
+    };
+    return static_cast<double>(toTicks(kernelTime) + toTicks(userTime)) * 1e-7; //  FILETIME - 100 
+#else
+    return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+}
+
+//       
+static bool sameParameterStrings(const ParameterStrings& a, const ParameterStrings& b) {
+    return a.m_satellite_kg == b.m_satellite_kg && a.M_central_body_factor == b.M_central_body_factor
+        && a.V0_m_per_s == b.V0_m_per_s && a.T_days == b.T_days && a.k_coeff == b.k_coeff
+        && a.F_coeff == b.F_coeff && a.integrator == b.integrator && a.dt == b.dt
+        && a.j2 == b.j2 && a.atmosphere_drag == b.atmosphere_drag && a.atmosphere_scale_height == b.atmosphere_scale_height
+        && a.thrust_accel == b.thrust_accel && a.thrust_angle_deg == b.thrust_angle_deg
+        && a.mc_runs == b.mc_runs && a.mc_seed == b.mc_seed && a.mc_v0_sigma_m_per_s == b.mc_v0_sigma_m_per_s
+        && a.mc_position_sigma == b.mc_position_sigma && a.mc_k_sigma == b.mc_k_sigma;
+}
 
 // ---       ---
 static std::pair<tgui::Label::Ptr, tgui::EditBox::Ptr> createInputRowControls(const sf::String& labelText, float editBoxWidth, float rowHeight) {
@@ -43,6 +72,69 @@ static std::pair<tgui::Label::Ptr, tgui::EditBox::Ptr> createInputRowControls(co
     return { label, editBox };
 }
 
+// --- CanvasVertexSink ---
+CanvasVertexSink::CanvasVertexSink(size_t maxVertices, sf::Color color)
+    : m_maxVertices(std::max<size_t>(maxVertices, 2)),
+    m_stride(1),
+    m_color(color),
+    m_hasLast(false),
+    m_lastIndex(0),
+    m_lastState{ 0.0, 0.0, 0.0, 0.0 },
+    m_hasBounds(false),
+    m_minX(0.f), m_maxX(0.f), m_minY(0.f), m_maxY(0.f) {
+}
+
+void CanvasVertexSink::begin(const SimulationParameters& params) {
+    size_t expected = static_cast<size_t>(std::max(params.STEPS, 0)) + 1;
+    m_stride = std::max<size_t>(1, (expected + m_maxVertices - 2) / (m_maxVertices - 1));
+    m_hasLast = false;
+    m_hasBounds = false;
+    m_vertices.clear();
+    m_vertices.reserve(std::min(expected, m_maxVertices) + 1);
+}
+
+void CanvasVertexSink::consume(size_t firstIndex, const State* states, size_t count) {
+    size_t offset = (m_stride - firstIndex % m_stride) % m_stride;
+    for (size_t i = offset; i < count; i += m_stride) {
+        m_vertices.emplace_back(
+            sf::Vector2f(static_cast<float>(states[i].x), static_cast<float>(-states[i].y)), // Y   
+            m_color);
+    }
+    if (count > 0) {
+        m_hasLast = true;
+        m_lastIndex = firstIndex + count - 1;
+        m_lastState = states[count - 1];
+    }
+
+    //     ,       
+    for (size_t i = 0; i < count; ++i) {
+        float x = static_cast<float>(states[i].x);
+        float y = static_cast<float>(-states[i].y);
+        if (!m_hasBounds) {
+            m_minX = m_maxX = x;
+            m_minY = m_maxY = y;
+            m_hasBounds = true;
+        }
+        m_minX = std::min(m_minX, x);
+        m_maxX = std::max(m_maxX, x);
+        m_minY = std::min(m_minY, y);
+        m_maxY = std::max(m_maxY, y);
+    }
+}
+
+sf::FloatRect CanvasVertexSink::getBounds() const {
+    if (!m_hasBounds) return sf::FloatRect();
+    return sf::FloatRect(m_minX, m_minY, m_maxX - m_minX, m_maxY - m_minY);
+}
+
+void CanvasVertexSink::end() {
+    //       
+    if (m_hasLast && (m_lastIndex % m_stride) != 0) {
+        m_vertices.emplace_back(
+            sf::Vector2f(static_cast<float>(m_lastState.x), static_cast<float>(-m_lastState.y)), m_color);
+    }
+}
+
 // ---    ---
 UserInterface::UserInterface()
     : m_window({ 1200, 800 }, L"   "),
@@ -63,7 +155,7 @@ void UserInterface::initializeGui() {
     loadWidgets();
     setupLayout(); //  setupLayout  loadWidgets
     connectSignals();
-    populateTable({}); //    
+    refreshTable(); //    
 }
 
 void UserInterface::loadMenuBar() {
@@ -82,9 +174,16 @@ void UserInterface::loadMenuBar() {
     m_menuBar->addMenu(L"");
     m_menuBar->addMenuItem(L"", L"  ...");
     m_menuBar->addMenuItem(L"", L"   ...");
+    m_menuBar->addMenuItem(L"", L"  (*.trjb)...");
+    m_menuBar->addMenuItem(L"", L"  N ...");
     m_menuBar->addMenuItem(L"", L"   ");
     m_menuBar->addMenuItem(L"", L"");
 
+    // ---  "" ---
+    m_menuBar->addMenu(L"");
+    m_menuBar->addMenuItem(L"", L" -");
+    m_menuBar->addMenuItem(L"", L" ");
+
     // ---  "" ---
     m_menuBar->addMenu(L"");
     m_menuBar->addMenuItem(L"", L" ");
@@ -104,6 +203,12 @@ void UserInterface::loadMenuBar() {
             else if (itemName == L"   ...") {
                 onSaveTrajectoryDataAsMenuItemClicked();
             }
+            else if (itemName == L"  (*.trjb)...") {
+                onOpenTrajectoryFileMenuItemClicked();
+            }
+            else if (itemName == L"  N ...") {
+                onOpenNBodyScenarioMenuItemClicked();
+            }
             else if (itemName == L"   ") {
                 onOpenDataFolderMenuItemClicked();
             }
@@ -111,6 +216,14 @@ void UserInterface::loadMenuBar() {
                 m_window.close();
             }
         }
+        else if (menuName == L"") {
+            if (itemName == L" -") {
+                onEnsembleMenuItemClicked();
+            }
+            else if (itemName == L" ") {
+                clearEnsembleOverlay();
+            }
+        }
         else if (menuName == L"") {
             if (itemName == L" ") {
                 onShowHelpMenuItemClicked();
@@ -255,10 +368,20 @@ void UserInterface::loadLeftPanelWidgets() {
     m_errorMessagesLabel->setVerticalAlignment(tgui::Label::VerticalAlignment::Top);
     m_errorMessagesLabel->setTextSize(14);
     m_errorMessagesLabel->setPosition({ PANEL_PADDING, tgui::bindBottom(m_loadTestDataButton) + WIDGET_SPACING });
-    // :        
+    // :        
     m_errorMessagesLabel->setSize({ "100% - " + tgui::String::fromNumber(2 * PANEL_PADDING),
-                                   "100% - top - " + tgui::String::fromNumber(PANEL_PADDING) });
+                                   "100% - top - " + tgui::String::fromNumber(2 * PANEL_PADDING + FRAME_STATS_HEIGHT) });
     m_leftPanel->add(m_errorMessagesLabel);
+
+    // 7.      (  updateFrameStats)
+    m_frameStatsLabel = tgui::Label::create();
+    if (!m_frameStatsLabel) { std::cerr << "Error: Failed to create m_frameStatsLabel" << std::endl; return; }
+
+    m_frameStatsLabel->getRenderer()->setTextColor(tgui::Color(110, 110, 110));
+    m_frameStatsLabel->setTextSize(11);
+    m_frameStatsLabel->setSize({ "100% - " + tgui::String::fromNumber(2 * PANEL_PADDING), FRAME_STATS_HEIGHT });
+    m_frameStatsLabel->setPosition({ PANEL_PADDING, "100% - " + tgui::String::fromNumber(PANEL_PADDING + FRAME_STATS_HEIGHT) });
+    m_leftPanel->add(m_frameStatsLabel);
 }
 
 void UserInterface::loadRightPanelWidgets() {
@@ -333,18 +456,10 @@ void UserInterface::loadTableWidgets(tgui::Panel::Ptr parentPanel) {
     }
     m_tableContainerPanel->add(m_tableHeaderGrid);
 
-    m_tableDataPanel = tgui::ScrollablePanel::create();
-    if (!m_tableDataPanel) { std::cerr << "Error: Failed to create m_tableDataPanel" << std::endl; return; }
-    m_tableDataPanel->setSize({ "100%", "100% - " + tgui::String::fromNumber(TITLE_HEIGHT + HEADER_HEIGHT) });
-    m_tableDataPanel->setPosition({ 0, tgui::bindBottom(m_tableHeaderGrid) });
-    m_tableDataPanel->getRenderer()->setBackgroundColor(tgui::Color(245, 245, 245));
-    m_tableContainerPanel->add(m_tableDataPanel);
-
-    m_tableDataGrid = tgui::Grid::create();
-    if (!m_tableDataGrid) { std::cerr << "Error: Failed to create m_tableDataGrid for data" << std::endl; return; }
-
-    m_tableDataGrid->setSize({ "100% - " + tgui::String::fromNumber(SCROLLBAR_WIDTH_ESTIMATE), 0 });
-    m_tableDataPanel->add(m_tableDataGrid);
+    //       
+    m_tableView.create(m_tableContainerPanel, { 0, tgui::bindBottom(m_tableHeaderGrid) },
+        { "100% - " + tgui::String::fromNumber(SCROLLBAR_WIDTH_ESTIMATE), "100% - " + tgui::String::fromNumber(TITLE_HEIGHT + HEADER_HEIGHT) },
+        SCROLLBAR_WIDTH_ESTIMATE);
 }
 
 // ---  ---
@@ -424,76 +539,72 @@ void UserInterface::onCalculateButtonPressed() {
     if (m_errorMessagesLabel) m_errorMessagesLabel->setText(""); //   /
     if (m_inputTitleLabel) m_inputTitleLabel->setText(L" "); //  
 
-    // 1.      EditBox
-    std::string m_str = m_edit_m ? m_edit_m->getText().toStdString() : "0";
-    std::string M_str = m_edit_M ? m_edit_M->getText().toStdString() : "0";
-    std::string V0_str = m_edit_V0 ? m_edit_V0->getText().toStdString() : "0";
-    std::string T_str = m_edit_T ? m_edit_T->getText().toStdString() : "0";
-    std::string k_str = m_edit_k ? m_edit_k->getText().toStdString() : "0";
-    std::string F_str = m_edit_F ? m_edit_F->getText().toStdString() : "0";
-
-    // 2.     
-    std::ofstream outFile(PARAMS_FILENAME);
-    if (!outFile.is_open()) {
-        std::cerr << "Error: Could not open file '" << PARAMS_FILENAME << "' for saving parameters." << std::endl;
-        if (m_inputTitleLabel) m_inputTitleLabel->setText(L" .  !");
-        return;
+    //     ,   
+    if (m_simulationJob.isRunning()) {
+        std::cout << "Cancelling simulation already in progress." << std::endl;
+        m_simulationJob.cancel();
     }
-    outFile << "m_satellite_kg=" << m_str << std::endl;
-    outFile << "M_central_body_factor=" << M_str << std::endl;
-    outFile << "V0_m_per_s=" << V0_str << std::endl;
-    outFile << "T_days=" << T_str << std::endl;
-    outFile << "k_coeff=" << k_str << std::endl;
-    outFile << "F_coeff=" << F_str << std::endl;
-    outFile.close();
-    if (outFile.fail()) {
-        std::cerr << "Error: Failed to write or close parameter file '" << PARAMS_FILENAME << "' before calculation." << std::endl;
-        if (m_inputTitleLabel) m_inputTitleLabel->setText(L"   !");
-        return;
-    }
-    std::cout << "Parameters from UI fields saved to '" << PARAMS_FILENAME << "'." << std::endl;
+    cancelCsvExport(); //   ,    
+    clearEnsembleOverlay(); //     
 
-    // 3.    
-    std::ifstream inFile(PARAMS_FILENAME);
-    if (!inFile.is_open()) {
-        std::cerr << "Error: Could not re-open file '" << PARAMS_FILENAME << "' for loading parameters." << std::endl;
-        if (m_inputTitleLabel) m_inputTitleLabel->setText(L"  !");
-        return;
+    // 1.      EditBox
+    ParameterStrings uiValues;
+    uiValues.m_satellite_kg = m_edit_m ? m_edit_m->getText().toStdString() : "0";
+    uiValues.M_central_body_factor = m_edit_M ? m_edit_M->getText().toStdString() : "0";
+    uiValues.V0_m_per_s = m_edit_V0 ? m_edit_V0->getText().toStdString() : "0";
+    uiValues.T_days = m_edit_T ? m_edit_T->getText().toStdString() : "0";
+    uiValues.k_coeff = m_edit_k ? m_edit_k->getText().toStdString() : "0";
+    uiValues.F_coeff = m_edit_F ? m_edit_F->getText().toStdString() : "0";
+
+    // , ,        :  ,    
+    ParameterStrings previousValues;
+    bool hasPreviousValues = std::ifstream(PARAMS_FILENAME).good() && SimulationConfig::loadParameterFile(PARAMS_FILENAME, previousValues);
+    if (hasPreviousValues) {
+        uiValues.integrator = previousValues.integrator;
+        uiValues.dt = previousValues.dt;
+        uiValues.j2 = previousValues.j2;
+        uiValues.atmosphere_drag = previousValues.atmosphere_drag;
+        uiValues.atmosphere_scale_height = previousValues.atmosphere_scale_height;
+        uiValues.thrust_accel = previousValues.thrust_accel;
+        uiValues.thrust_angle_deg = previousValues.thrust_angle_deg;
+        uiValues.mc_runs = previousValues.mc_runs;
+        uiValues.mc_seed = previousValues.mc_seed;
+        uiValues.mc_v0_sigma_m_per_s = previousValues.mc_v0_sigma_m_per_s;
+        uiValues.mc_position_sigma = previousValues.mc_position_sigma;
+        uiValues.mc_k_sigma = previousValues.mc_k_sigma;
+    }
+
+    ParameterStrings loadedValues;
+    if (hasPreviousValues && sameParameterStrings(uiValues, previousValues)) {
+        //   :     ,     
+        loadedValues = previousValues;
     }
+    else {
+        // 2.     
+        if (!SimulationConfig::saveParameterFile(PARAMS_FILENAME, uiValues)) {
+            if (m_inputTitleLabel) m_inputTitleLabel->setText(L" .  !");
+            return;
+        }
+        std::cout << "Parameters from UI fields saved to '" << PARAMS_FILENAME << "'." << std::endl;
 
-    std::string line, key, value;
-    //       
-    std::string loaded_m_str, loaded_M_str, loaded_V0_str, loaded_T_str, loaded_k_str, loaded_F_str;
-
-    while (std::getline(inFile, line)) {
-        size_t delimiterPos = line.find('=');
-        if (delimiterPos != std::string::npos) {
-            key = line.substr(0, delimiterPos);
-            value = line.substr(delimiterPos + 1);
-
-            if (key == "m_satellite_kg") loaded_m_str = value;
-            else if (key == "M_central_body_factor") loaded_M_str = value;
-            else if (key == "V0_m_per_s") loaded_V0_str = value;
-            else if (key == "T_days") loaded_T_str = value;
-            else if (key == "k_coeff") loaded_k_str = value;
-            else if (key == "F_coeff") loaded_F_str = value;
+        // 3.    
+        if (!SimulationConfig::loadParameterFile(PARAMS_FILENAME, loadedValues)) {
+            if (m_inputTitleLabel) m_inputTitleLabel->setText(L"  !");
+            return;
         }
+        std::cout << "Parameters re-loaded from '" << PARAMS_FILENAME << "' for validation." << std::endl;
     }
-    inFile.close();
-    std::cout << "Parameters re-loaded from '" << PARAMS_FILENAME << "' for validation." << std::endl;
 
     // 4.   EditBox    
-    if (m_edit_m) m_edit_m->setText(loaded_m_str);
-    if (m_edit_M) m_edit_M->setText(loaded_M_str);
-    if (m_edit_V0) m_edit_V0->setText(loaded_V0_str);
-    if (m_edit_T) m_edit_T->setText(loaded_T_str);
-    if (m_edit_k) m_edit_k->setText(loaded_k_str);
-    if (m_edit_F) m_edit_F->setText(loaded_F_str);
+    if (m_edit_m) m_edit_m->setText(loadedValues.m_satellite_kg);
+    if (m_edit_M) m_edit_M->setText(loadedValues.M_central_body_factor);
+    if (m_edit_V0) m_edit_V0->setText(loadedValues.V0_m_per_s);
+    if (m_edit_T) m_edit_T->setText(loadedValues.T_days);
+    if (m_edit_k) m_edit_k->setText(loadedValues.k_coeff);
+    if (m_edit_F) m_edit_F->setText(loadedValues.F_coeff);
 
     // 5.    
-    InputParameters validatedParams = validateAndParseParameters(
-        loaded_m_str, loaded_M_str, loaded_V0_str, loaded_T_str, loaded_k_str, loaded_F_str
-    );
+    InputParameters validatedParams = SimulationConfig::validate(loadedValues);
 
     if (!validatedParams.isValid) {
         std::wcerr << L"Error: Parameter validation failed after loading from file.\n" << validatedParams.errorMessage << std::endl;
@@ -502,9 +613,10 @@ void UserInterface::onCalculateButtonPressed() {
             m_errorMessagesLabel->setText(tgui::String(validatedParams.errorMessage)); // validatedParams.errorMessage  std::wstring
         }
         m_trajectoryAvailable = false;
-        m_calculatedStates.clear();
+        m_calculatedStates.reset();
+        m_openedTrajectoryFile.close();
         prepareTrajectoryForDisplay();
-        populateTable({});
+        refreshTable();
         return;
     }
     if (m_errorMessagesLabel) {
@@ -513,95 +625,154 @@ void UserInterface::onCalculateButtonPressed() {
     }
     if (m_inputTitleLabel) m_inputTitleLabel->setText(L" ");
 
-    const double G_SI = 6.67430e-11;
-    const double REFERENCE_PHYSICAL_LENGTH_FOR_X_1_5 = 1.495978707e11;
-    const double SECONDS_PER_DAY = 24.0 * 60.0 * 60.0;
-
-    SimulationParameters paramsForCalc; //      Calculations.h
-
-    //   
-    double m_satellite_ui_kg_val = validatedParams.m_satellite_kg;
-    double M_ui_val_from_editbox_val = validatedParams.M_central_body_factor;
-    double V0_ui_si_val = validatedParams.V0_m_per_s;
-    double T_total_ui_days_val = validatedParams.T_days;
-    double k_val_input_val = validatedParams.k_coeff;
-    double F_val_input_val = validatedParams.F_coeff;
+    // 6.     
+    SimulationParameters paramsForCalc;
+    double time_unit = 1.0;
+    if (!SimulationConfig::toSimulationParameters(validatedParams, paramsForCalc, time_unit)) {
+        if (m_inputTitleLabel) m_inputTitleLabel->setText(L" .  > 0!");
+        m_trajectoryAvailable = false; m_calculatedStates.reset(); m_openedTrajectoryFile.close();
+        prepareTrajectoryForDisplay(); refreshTable();
+        return;
+    }
+    m_lastCalculationDT = paramsForCalc.DT;
+    m_lastTimeUnit = time_unit;
+    m_lastSimulationParams = paramsForCalc;
 
-    // 1.    M_central   
-    double M_central_body_physical_kg = M_ui_val_from_editbox_val * 1.0e25;
-    double mass_unit_for_scaling = M_central_body_physical_kg;
-    double length_unit = REFERENCE_PHYSICAL_LENGTH_FOR_X_1_5 / paramsForCalc.initialState.x;
+    //     :       
+    SimulationCache::StatesPtr cachedStates;
+    if (m_simulationCache.find(paramsForCalc, cachedStates)) {
+        showCachedTrajectory(std::move(cachedStates));
+        return;
+    }
 
-    if (mass_unit_for_scaling <= 1e-9) {
-        std::cerr << "Error: Scaling mass unit (M_central_body_physical_kg) must be significantly positive." << std::endl;
-        if (m_inputTitleLabel) m_inputTitleLabel->setText(L" .  > 0!");
-        m_trajectoryAvailable = false; m_calculatedStates.clear();
-        prepareTrajectoryForDisplay(); populateTable({});
+    //     ;    update() -> onSimulationFinished().
+    //         ,        
+    //    ,    *.trjb:       .
+    discardJobFile(); //   
+    m_jobFilePath = m_simulationCache.getTemporaryPath(paramsForCalc);
+    SimulationCheckpoint from;
+    //     ,   ( T):     ,
+    //        
+    const bool extending = !m_jobFilePath.empty() && m_simulationCache.findExtendable(paramsForCalc, m_jobFilePath, from);
+    //      ;      m_jobCanvasSink
+    m_jobPreviewSink = std::make_shared<LivePreviewSink>(MAX_CANVAS_VERTICES);
+    m_previewWorldPoints.clear();
+    if (extending) {
+        std::cout << "Extending cached trajectory from step " << from.stepIndex << " to " << paramsForCalc.STEPS << "." << std::endl;
+        //    ;     ,   LivePreviewSink.
+        //    ,     .
+        MappedTrajectoryFile prefix;
+        if (prefix.open(m_jobFilePath)) {
+            CanvasVertexSink prefixSink(MAX_CANVAS_VERTICES);
+            prefixSink.begin(paramsForCalc);
+            prefixSink.consume(0, prefix.data(), prefix.size());
+            setTrajectoryDisplayPoints(std::move(prefixSink.getVertices()), prefixSink.getBounds());
+            for (const auto& vertex : m_trajectoryDisplayPoints) m_previewWorldPoints.emplace_back(vertex.position.x, -vertex.position.y);
+        }
+        prefix.close();
+        m_jobFileSink = std::make_shared<BinaryTrajectorySink>(m_jobFilePath, time_unit, from);
+        m_jobCanvasSink.reset(); //       
+    }
+    else if (!m_jobFilePath.empty()) {
+        m_jobFileSink = std::make_shared<BinaryTrajectorySink>(m_jobFilePath, time_unit);
+        m_jobCanvasSink = std::make_shared<CanvasVertexSink>(MAX_CANVAS_VERTICES);
+        setTrajectoryDisplayPoints({}, sf::FloatRect());
+    }
+    if (!m_jobFileSink || m_jobFileSink->hasFailed()) {
+        discardJobFile();
+        m_jobCanvasSink.reset();
+        m_jobPreviewSink.reset();
+        WorldTrajectoryData().swap(m_previewWorldPoints);
+        m_trajectoryAvailable = false; m_calculatedStates.reset(); m_openedTrajectoryFile.close();
+        prepareTrajectoryForDisplay(); refreshTable();
+        if (m_inputTitleLabel) m_inputTitleLabel->setText(L" ");
+        if (m_errorMessagesLabel) {
+            m_errorMessagesLabel->getRenderer()->setTextColor(tgui::Color::Red);
+            m_errorMessagesLabel->setText(L"      " + tgui::String(SIMULATION_CACHE_DIR) + L".");
+        }
         return;
     }
-    double time_unit = std::sqrt(std::pow(length_unit, 3) / (G_SI * mass_unit_for_scaling));
 
-    paramsForCalc.G = 1.0;
-    paramsForCalc.M = (M_central_body_physical_kg + m_satellite_ui_kg_val) / mass_unit_for_scaling;
+    if (extending) m_simulationJob.resume(paramsForCalc, from, { m_jobFileSink, m_jobPreviewSink });
+    else m_simulationJob.start(paramsForCalc, { m_jobFileSink, m_jobCanvasSink, m_jobPreviewSink });
+    m_lastShownProgressPercent = -1;
+    if (m_inputTitleLabel) m_inputTitleLabel->setText(extending ? L" ..." : L" ...");
+    updateSimulationProgress();
+}
 
-    paramsForCalc.DRAG_COEFFICIENT = k_val_input_val;
-    paramsForCalc.THRUST_COEFFICIENT = F_val_input_val;
+void UserInterface::updateSimulationProgress() {
+    if (!m_simulationJob.isRunning()) return;
 
-    double T_total_ui_sec = T_total_ui_days_val * SECONDS_PER_DAY;
-    double T_total_dimensionless = T_total_ui_sec / time_unit;
+    int percent = static_cast<int>(m_simulationJob.getProgress() * 100.0);
+    if (percent == m_lastShownProgressPercent) return; //   Label  
+    m_lastShownProgressPercent = percent;
 
-    if (paramsForCalc.DT > 1e-9) {
-        paramsForCalc.STEPS = static_cast<int>(T_total_dimensionless / paramsForCalc.DT);
-        m_lastCalculationDT = paramsForCalc.DT; // <---  DT
-    }
-    else {
-        paramsForCalc.STEPS = 1000;
-        m_lastCalculationDT = paramsForCalc.DT;
-        std::cerr << "Warning: DT is too small or zero. Using default STEPS." << std::endl;
+    if (m_errorMessagesLabel) {
+        m_errorMessagesLabel->getRenderer()->setTextColor(tgui::Color(0, 0, 160));
+        m_errorMessagesLabel->setText(L" : " + tgui::String::fromNumber(percent) + L"%\n"
+            + L"     .");
+        m_windowDirty = true;
     }
-    if (paramsForCalc.STEPS <= 0) paramsForCalc.STEPS = 1;
+}
 
-    double characteristic_velocity = length_unit / time_unit;
-    if (std::abs(characteristic_velocity) > 1e-9) {
-        paramsForCalc.initialState.vy = V0_ui_si_val / characteristic_velocity;
+//  ,  LivePreviewSink   ,     
+void UserInterface::drainLivePreview() {
+    if (!m_jobPreviewSink) return;
+
+    IndexedState batch[1024];
+    size_t received = 0;
+    size_t count;
+    //      ,    
+    while (received < LivePreviewSink::RING_CAPACITY && (count = m_jobPreviewSink->poll(batch, 1024)) > 0) {
+        for (size_t i = 0; i < count; ++i) {
+            const State& state = batch[i].state;
+            sf::Vector2f position(static_cast<float>(state.x), static_cast<float>(-state.y)); // Y   
+            if (m_trajectoryDisplayPoints.empty()) {
+                m_trajectoryBounds = sf::FloatRect(position, sf::Vector2f(0.f, 0.f));
+            }
+            float right = std::max(m_trajectoryBounds.left + m_trajectoryBounds.width, position.x);
+            float bottom = std::max(m_trajectoryBounds.top + m_trajectoryBounds.height, position.y);
+            m_trajectoryBounds.left = std::min(m_trajectoryBounds.left, position.x);
+            m_trajectoryBounds.top = std::min(m_trajectoryBounds.top, position.y);
+            m_trajectoryBounds.width = right - m_trajectoryBounds.left;
+            m_trajectoryBounds.height = bottom - m_trajectoryBounds.top;
+
+            m_trajectoryDisplayPoints.emplace_back(position, sf::Color::Blue);
+            m_previewWorldPoints.emplace_back(state.x, state.y);
+        }
+        received += count;
     }
-    else {
-        paramsForCalc.initialState.vy = 0.0;
-        std::cerr << "Warning: Characteristic velocity (length_unit/time_unit) is near zero. Setting vy_dimless to 0." << std::endl;
+    if (received > 0) {
+        m_canvasViewDirty = true;
+        m_canvasDirty = true;
     }
+}
 
-    Calculations calculator;
-    m_calculatedStates = calculator.runSimulation(paramsForCalc);
+void UserInterface::onSimulationFinished() {
+    if (!m_simulationJob.acknowledgeFinished()) return;
+    if (!m_jobFileSink) return; //    :  , ,  
 
-    m_currentTableData.clear();
-    if (!m_calculatedStates.empty()) {
-        m_trajectoryAvailable = true;
-        const size_t maxTableEntries = 100;
-        size_t step_size_for_table = 1;
-        
-        if (m_calculatedStates.size() > maxTableEntries) {
-            step_size_for_table = m_calculatedStates.size() / maxTableEntries;
-            if (step_size_for_table == 0) step_size_for_table = 1;
-        }
-        
-        for (size_t i = 0; i < m_calculatedStates.size(); i += step_size_for_table) {
-            const auto& state = m_calculatedStates[i];
-            double current_dimensionless_time = i * paramsForCalc.DT;
-            double current_physical_time_sec = current_dimensionless_time * time_unit;
-            double current_physical_time_days = current_physical_time_sec / SECONDS_PER_DAY;
-            m_currentTableData.push_back({
-                static_cast<float>(current_physical_time_days),
-                static_cast<float>(state.x), static_cast<float>(state.y),
-                static_cast<float>(state.vx), static_cast<float>(state.vy)
-            });
-        }
-    }
-    else {
-        m_trajectoryAvailable = false;
+    //    end();        
+    const bool written = !m_jobFileSink->hasFailed();
+    m_jobFileSink.reset();
+    m_openedTrajectoryFile.close(); //     
+    m_calculatedStates.reset();
+    const std::string path = written ? m_simulationCache.storeFile(m_simulationJob.getParameters(), m_jobFilePath) : std::string();
+    if (path.empty()) discardJobFile();
+    m_jobFilePath.clear();
+    m_trajectoryAvailable = !path.empty() && m_openedTrajectoryFile.open(path) && m_openedTrajectoryFile.size() > 0;
+    if (!m_trajectoryAvailable) setTrajectoryDisplayPoints({}, sf::FloatRect());
+    else if (m_jobCanvasSink) setTrajectoryDisplayPoints(std::move(m_jobCanvasSink->getVertices()), m_jobCanvasSink->getBounds());
+    else showCalculatedStatesOnCanvas(m_simulationJob.getParameters());
+
+    if (m_jobPreviewSink && m_jobPreviewSink->getDroppedCount() > 0) {
+        std::cout << "Live preview skipped " << m_jobPreviewSink->getDroppedCount() << " points (window was busy)." << std::endl;
     }
+    m_jobCanvasSink.reset();
+    m_jobPreviewSink.reset();
+    WorldTrajectoryData().swap(m_previewWorldPoints);
 
-    prepareTrajectoryForDisplay();
-    populateTable(m_currentTableData);
+    refreshTable();
 
     if (m_inputTitleLabel) { //      
         if (m_trajectoryAvailable) m_inputTitleLabel->setText(L" ");
@@ -615,6 +786,94 @@ void UserInterface::onCalculateButtonPressed() {
     }
 }
 
+//  ,   ,  ,    
+void UserInterface::showCachedTrajectory(SimulationCache::StatesPtr states) {
+    discardJobFile(); //     
+    m_jobCanvasSink.reset();
+    m_jobPreviewSink.reset();
+    WorldTrajectoryData().swap(m_previewWorldPoints);
+
+    m_openedTrajectoryFile.close();
+    m_calculatedStates = std::move(states);
+    m_trajectoryAvailable = true;
+    showCalculatedStatesOnCanvas(m_lastSimulationParams);
+    refreshTable();
+
+    std::cout << "Trajectory taken from cache (" << m_simulationCache.getHitCount() << " hits, "
+        << m_simulationCache.getMissCount() << " misses)." << std::endl;
+    if (m_inputTitleLabel) m_inputTitleLabel->setText(L" ");
+    if (m_errorMessagesLabel) {
+        m_errorMessagesLabel->getRenderer()->setTextColor(tgui::Color(0, 128, 0));
+        m_errorMessagesLabel->setText(L"   \n    .");
+    }
+}
+
+//        ,    
+void UserInterface::showCalculatedStatesOnCanvas(const SimulationParameters& params) {
+    CanvasVertexSink canvasSink(MAX_CANVAS_VERTICES);
+    canvasSink.begin(params);
+    canvasSink.consume(0, getTrajectoryData(), getTrajectorySize());
+    canvasSink.end();
+    setTrajectoryDisplayPoints(std::move(canvasSink.getVertices()), canvasSink.getBounds());
+}
+
+//    ,      (,    ).
+// ,      .
+void UserInterface::discardJobFile() {
+    m_jobFileSink.reset();
+    if (m_jobFilePath.empty()) return;
+    std::error_code error;
+    std::filesystem::remove(std::filesystem::u8path(m_jobFilePath), error);
+    m_jobFilePath.clear();
+}
+
+const State* UserInterface::getTrajectoryData() const {
+    if (m_openedTrajectoryFile.isOpen()) return m_openedTrajectoryFile.data();
+    return m_calculatedStates ? m_calculatedStates->data() : nullptr;
+}
+
+size_t UserInterface::getTrajectorySize() const {
+    if (m_openedTrajectoryFile.isOpen()) return m_openedTrajectoryFile.size();
+    return m_calculatedStates ? m_calculatedStates->size() : 0;
+}
+
+void UserInterface::updateCsvExportProgress() {
+    if (!m_csvExportJob.isRunning()) return;
+
+    int percent = static_cast<int>(m_csvExportJob.getProgress() * 100.0);
+    if (percent == m_lastShownExportPercent) return;
+    m_lastShownExportPercent = percent;
+
+    if (m_errorMessagesLabel) {
+        m_errorMessagesLabel->getRenderer()->setTextColor(tgui::Color(0, 0, 160));
+        m_errorMessagesLabel->setText(L" '" + m_csvExportFilename + L"': " + tgui::String::fromNumber(percent) + L"%");
+        m_windowDirty = true;
+    }
+}
+
+void UserInterface::cancelCsvExport() {
+    if (!m_csvExportJob.isRunning()) return;
+    std::cout << "Cancelling CSV export in progress: '" << m_csvExportJob.getPath() << "' will be incomplete." << std::endl;
+    m_csvExportJob.cancel();
+}
+
+void UserInterface::onCsvExportFinished() {
+    bool succeeded = false;
+    if (!m_csvExportJob.acknowledgeFinished(succeeded)) return;
+
+    if (!m_errorMessagesLabel) return;
+    if (succeeded) {
+        m_errorMessagesLabel->getRenderer()->setTextColor(tgui::Color(0, 128, 0));
+        m_errorMessagesLabel->setText(L"  (" + tgui::String::fromNumber(m_csvExportJob.getRowCount())
+            + L" )\n  '" + m_csvExportFilename + L"'.");
+    }
+    else {
+        m_errorMessagesLabel->getRenderer()->setTextColor(tgui::Color::Red);
+        m_errorMessagesLabel->setText(L"    \n'" + m_csvExportFilename
+            + L"'.     .");
+    }
+}
+
 void UserInterface::onSaveParamsAsMenuItemClicked() {
     if (m_errorMessagesLabel) m_errorMessagesLabel->setText(L"");
 
@@ -717,7 +976,7 @@ void UserInterface::onSaveParamsAsMenuItemClicked() {
 void UserInterface::onSaveTrajectoryDataAsMenuItemClicked() {
     if (m_errorMessagesLabel) m_errorMessagesLabel->setText(L"");
 
-    if (!m_trajectoryAvailable || m_calculatedStates.empty()) {
+    if (!m_trajectoryAvailable || getTrajectorySize() == 0) {
         std::cerr << "Save Trajectory Data: No trajectory data available to save." << std::endl;
         if (m_errorMessagesLabel) {
             m_errorMessagesLabel->getRenderer()->setTextColor(tgui::Color::Red);
@@ -727,9 +986,10 @@ void UserInterface::onSaveTrajectoryDataAsMenuItemClicked() {
     }
 
     const tgui::String expectedFilename = L"__.txt"; //   
+    const tgui::String expectedBinaryFilename = L"__.trjb"; //     
 
     auto dialog = tgui::FileDialog::create(L"   ...", L"");
-    dialog->setFileTypeFilters({ {L"  (*.txt)", {L"*.txt"}}, {L"CSV  (*.csv)", {L"*.csv"}}, {L"  (*.*)", {L"*.*"}} });
+    dialog->setFileTypeFilters({ {L"  (*.txt)", {L"*.txt"}}, {L"CSV  (*.csv)", {L"*.csv"}}, {L"  (*.trjb)", {L"*.trjb"}}, {L"  (*.*)", {L"*.*"}} });
     dialog->getRenderer()->setTitleBarHeight(30);
 
     tgui::Filesystem::Path defaultSavePath(USER_SAVES_DIR);
@@ -744,7 +1004,7 @@ void UserInterface::onSaveTrajectoryDataAsMenuItemClicked() {
     dialog->setFilename(expectedFilename);
     dialog->setPosition("(&.size - size) / 2"); //  
 
-    dialog->onFileSelect.connect([this, expectedFilename](const std::vector<tgui::Filesystem::Path>& paths) {
+    dialog->onFileSelect.connect([this, expectedFilename, expectedBinaryFilename](const std::vector<tgui::Filesystem::Path>& paths) {
         if (paths.empty()) {
             std::cout << "Save Trajectory Data: Dialog closed without selection." << std::endl;
             if (m_errorMessagesLabel) m_errorMessagesLabel->setText(L"  .");
@@ -754,74 +1014,387 @@ void UserInterface::onSaveTrajectoryDataAsMenuItemClicked() {
         const tgui::Filesystem::Path& fsPath = paths[0];
         tgui::String selectedFilename = fsPath.getFilename();
 
-        if (selectedFilename != expectedFilename) {
+        if (selectedFilename != expectedFilename && selectedFilename != expectedBinaryFilename) {
             std::cerr << "Error: Incorrect filename for trajectory. Expected: "
                 << expectedFilename.toStdString() << ", Got: " << selectedFilename.toStdString() << std::endl;
             if (m_errorMessagesLabel) {
                 m_errorMessagesLabel->getRenderer()->setTextColor(tgui::Color::Red);
-                m_errorMessagesLabel->setText(L": ,  \n  '" + expectedFilename + L"'.");
+                m_errorMessagesLabel->setText(L": ,  \n  '" + expectedFilename
+                    + L"'\n '" + expectedBinaryFilename + L"'.");
             }
             return;
         }
 
-        auto nativePathForStream = fsPath.asNativeString();
-        std::string pathStringToOpen;
-
-#ifdef TGUI_SYSTEM_WINDOWS
-        std::ofstream outFile(nativePathForStream, std::ios::binary);
-#else
-        std::ofstream outFile(nativePathForStream, std::ios::binary);
-#endif
-
-        if (!outFile.is_open()) {
-            std::cerr << "Error: Could not open/create trajectory file via ofstream." << std::endl;
+        //  :      ,  
+        if (selectedFilename == expectedBinaryFilename) {
+            BinaryTrajectorySink binaryFile(fsPath.asString().toStdString(), m_lastTimeUnit);
+            if (!binaryFile.hasFailed()) {
+                binaryFile.begin(m_lastSimulationParams);
+                binaryFile.consume(0, getTrajectoryData(), getTrajectorySize());
+                binaryFile.end();
+            }
             if (m_errorMessagesLabel) {
-                m_errorMessagesLabel->getRenderer()->setTextColor(tgui::Color::Red);
-                m_errorMessagesLabel->setText(L":   /   \n'" + selectedFilename + L"'.     .");
+                if (binaryFile.hasFailed()) {
+                    m_errorMessagesLabel->getRenderer()->setTextColor(tgui::Color::Red);
+                    m_errorMessagesLabel->setText(L"    \n'" + selectedFilename + L"'.");
+                }
+                else {
+                    m_errorMessagesLabel->getRenderer()->setTextColor(tgui::Color(0, 128, 0));
+                    m_errorMessagesLabel->setText(L"  (" + tgui::String::fromNumber(getTrajectorySize())
+                        + L" )\n  '" + selectedFilename + L"'.");
+                }
             }
             return;
         }
 
-        outFile << std::fixed << std::setprecision(5);
-        outFile << "Step_Index, Time_dimless(approx), x_dimless, y_dimless, vx_dimless, vy_dimless\n";
+        // CSV    ;      update()
+        m_csvExportFilename = selectedFilename;
+        m_lastShownExportPercent = -1;
+        m_csvExportJob.start(fsPath.asString().toStdString(), getTrajectoryData(), getTrajectorySize(), m_lastCalculationDT);
+        updateCsvExportProgress();
+    });
+    m_gui.add(dialog);
+}
 
-        for (size_t i = 0; i < m_calculatedStates.size(); ++i) {
-            const auto& state = m_calculatedStates[i];
-            double dimensionless_time_approx = static_cast<double>(i) * m_lastCalculationDT;
+#ifdef _WIN32
+std::wstring getExecutablePath_Windows() {
+    wchar_t path[MAX_PATH] = { 0 };
+    GetModuleFileNameW(NULL, path, MAX_PATH);
+    return std::wstring(path);
+}
+#endif
 
-            outFile << i << ",  "
-                << dimensionless_time_approx << ",  "
-                << state.x << ",  " << state.y << ",  "
-                << state.vx << ",  " << state.vy << "\n";
+void UserInterface::onOpenTrajectoryFileMenuItemClicked() {
+    if (m_errorMessagesLabel) m_errorMessagesLabel->setText(L"");
+
+    if (m_simulationJob.isRunning()) {
+        if (m_errorMessagesLabel) {
+            m_errorMessagesLabel->getRenderer()->setTextColor(tgui::Color::Red);
+            m_errorMessagesLabel->setText(L"  .");
         }
-        outFile.close();
+        return;
+    }
 
-        if (outFile.fail()) {
-            // ... (  ) ...
-            if (m_errorMessagesLabel) {
+    auto dialog = tgui::FileDialog::create(L" ", L"");
+    dialog->setFileTypeFilters({ {L"  (*.trjb)", {L"*.trjb"}}, {L"  (*.*)", {L"*.*"}} });
+    dialog->getRenderer()->setTitleBarHeight(30);
+    tgui::Filesystem::Path defaultPath(USER_SAVES_DIR);
+    if (tgui::Filesystem::directoryExists(defaultPath)) {
+        dialog->setPath(defaultPath);
+    }
+    dialog->setPosition("(&.size - size) / 2");
+
+    dialog->onFileSelect.connect([this](const std::vector<tgui::Filesystem::Path>& paths) {
+        if (paths.empty()) return;
+        const tgui::Filesystem::Path& fsPath = paths[0];
+        bool opened = openTrajectoryFile(fsPath.asString().toStdString());
+        if (m_errorMessagesLabel) {
+            if (opened) {
+                m_errorMessagesLabel->getRenderer()->setTextColor(tgui::Color(0, 128, 0));
+                m_errorMessagesLabel->setText(L"  (" + tgui::String::fromNumber(getTrajectorySize())
+                    + L" )\n '" + fsPath.getFilename() + L"'.");
+            }
+            else {
                 m_errorMessagesLabel->getRenderer()->setTextColor(tgui::Color::Red);
-                m_errorMessagesLabel->setText(L"    \n'" + selectedFilename + L"'.");
+                m_errorMessagesLabel->setText(L":   \n'" + fsPath.getFilename() + L"'.");
             }
         }
-        else {
-            // ... (  ) ...
-            if (m_errorMessagesLabel) {
-                m_errorMessagesLabel->getRenderer()->setTextColor(tgui::Color(0, 128, 0));
-                m_errorMessagesLabel->setText(L"  (" + tgui::String::fromNumber(m_calculatedStates.size())
-                    + L" )\n  '" + selectedFilename + L"'.");
-            }
+    });
+    m_gui.add(dialog);
+}
+
+void UserInterface::onOpenNBodyScenarioMenuItemClicked() {
+    if (m_errorMessagesLabel) m_errorMessagesLabel->setText(L"");
+
+    if (m_nbodyResult.valid()) {
+        if (m_errorMessagesLabel) {
+            m_errorMessagesLabel->getRenderer()->setTextColor(tgui::Color::Red);
+            m_errorMessagesLabel->setText(L"   N .");
         }
+        return;
+    }
+
+    auto dialog = tgui::FileDialog::create(L"  N ", L"");
+    dialog->setFileTypeFilters({ {L" (*.txt)", {L"*.txt"}}, {L"  (*.*)", {L"*.*"}} });
+    dialog->getRenderer()->setTitleBarHeight(30);
+    tgui::Filesystem::Path defaultPath("data/");
+    if (tgui::Filesystem::directoryExists(defaultPath)) {
+        dialog->setPath(defaultPath);
+    }
+    dialog->setPosition("(&.size - size) / 2");
+
+    dialog->onFileSelect.connect([this](const std::vector<tgui::Filesystem::Path>& paths) {
+        if (paths.empty()) return;
+        startNBodySimulation(paths[0].asString().toStdString());
     });
     m_gui.add(dialog);
 }
 
-#ifdef _WIN32
-std::wstring getExecutablePath_Windows() {
-    wchar_t path[MAX_PATH] = { 0 };
-    GetModuleFileNameW(NULL, path, MAX_PATH);
-    return std::wstring(path);
+void UserInterface::startNBodySimulation(const std::string& path) {
+    NBodyParameters params;
+    NBodySystem system;
+    if (!NBodySimulation::loadScenario(path, params, system)) {
+        if (m_errorMessagesLabel) {
+            m_errorMessagesLabel->getRenderer()->setTextColor(tgui::Color::Red);
+            m_errorMessagesLabel->setText(L"   N \n(  ).");
+        }
+        return;
+    }
+
+    m_nbodyControl.cancelRequested = false;
+    m_nbodyControl.completedSteps = 0;
+    m_nbodySteps = params.STEPS;
+    m_lastShownNBodyPercent = -1;
+    m_nbodyTracks = std::make_shared<NBodyTrackSink>();
+    std::cout << "UserInterface: N-body scenario '" << path << "': " << system.size() << " bodies, "
+        << params.STEPS << " steps." << std::endl;
+
+    std::shared_ptr<NBodyTrackSink> tracks = m_nbodyTracks;
+    m_nbodyResult = std::async(std::launch::async, [this, params, system, tracks]() mutable {
+        NBodySimulation simulation;
+        return simulation.run(params, system, *tracks, &m_nbodyControl);
+    });
+}
+
+void UserInterface::updateNBodySimulation() {
+    if (!m_nbodyResult.valid()) return;
+
+    if (m_nbodyResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        int percent = (m_nbodySteps > 0) ? static_cast<int>(100.0 * m_nbodyControl.completedSteps.load() / m_nbodySteps) : 0;
+        if (percent == m_lastShownNBodyPercent) return;
+        m_lastShownNBodyPercent = percent;
+        if (m_errorMessagesLabel) {
+            m_errorMessagesLabel->getRenderer()->setTextColor(tgui::Color(0, 0, 160));
+            m_errorMessagesLabel->setText(L" N : " + tgui::String::fromNumber(percent) + L"%");
+            m_windowDirty = true;
+        }
+        return;
+    }
+
+    const bool finished = m_nbodyResult.get();
+    std::shared_ptr<NBodyTrackSink> tracks = std::move(m_nbodyTracks);
+    m_windowDirty = true;
+    if (!finished || tracks->getFrameCount() == 0) {
+        if (m_errorMessagesLabel) {
+            m_errorMessagesLabel->getRenderer()->setTextColor(tgui::Color::Red);
+            m_errorMessagesLabel->setText(L":  N   .");
+        }
+        return;
+    }
+
+    const size_t bodyCount = tracks->getTracks().size();
+    const size_t frameCount = tracks->getFrameCount();
+    if (m_errorMessagesLabel) {
+        m_errorMessagesLabel->getRenderer()->setTextColor(tgui::Color(0, 128, 0));
+        m_errorMessagesLabel->setText(L" N  : " + tgui::String::fromNumber(bodyCount) + L" , "
+            + tgui::String::fromNumber(frameCount) + L" .");
+    }
+    try {
+        TrajectoryVisualizer visualizer(1000, 800, L"2D-: N ");
+        visualizer.setBodyTracks(std::move(tracks->getTracks()));
+        visualizer.run();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "UserInterface: Exception while running TrajectoryVisualizer: " << e.what() << std::endl;
+    }
+}
+
+void UserInterface::onEnsembleMenuItemClicked() {
+    if (m_errorMessagesLabel) m_errorMessagesLabel->setText(L"");
+    auto showError = [this](const tgui::String& text) {
+        if (!m_errorMessagesLabel) return;
+        m_errorMessagesLabel->getRenderer()->setTextColor(tgui::Color::Red);
+        m_errorMessagesLabel->setText(text);
+    };
+
+    if (m_ensembleResult.valid()) {
+        showError(L"   .");
+        return;
+    }
+    //      ;     -  mc_*  
+    if (!m_trajectoryAvailable || m_simulationJob.isRunning()) {
+        showError(L"  !");
+        return;
+    }
+    ParameterStrings values;
+    if (!SimulationConfig::loadParameterFile(PARAMS_FILENAME, values)) {
+        showError(L"   .");
+        return;
+    }
+    InputParameters input = SimulationConfig::validate(values);
+    EnsembleDispersion dispersion;
+    EnsembleSettings settings;
+    if (!input.isValid) {
+        showError(tgui::String(input.errorMessage));
+        return;
+    }
+    if (!SimulationConfig::toEnsembleSettings(input, dispersion, settings)) {
+        showError(L" .  > 0!");
+        return;
+    }
+
+    clearEnsembleOverlay();
+    m_ensembleControl.cancelRequested = false;
+    m_ensembleControl.completedSteps = 0;
+    m_ensembleRuns = settings.runs;
+    m_ensembleTimeUnit = m_lastTimeUnit;
+    m_lastShownEnsemblePercent = -1;
+    std::cout << "UserInterface: Monte-Carlo ensemble of " << settings.runs << " runs started." << std::endl;
+
+    const SimulationParameters nominal = m_lastSimulationParams;
+    m_ensembleResult = std::async(std::launch::async, [this, nominal, dispersion, settings]() {
+        MonteCarloEnsemble ensemble;
+        return ensemble.run(nominal, dispersion, settings, &m_ensembleControl);
+    });
+}
+
+void UserInterface::updateEnsemble() {
+    if (!m_ensembleResult.valid()) return;
+
+    if (m_ensembleResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        int percent = (m_ensembleRuns > 0) ? static_cast<int>(100.0 * m_ensembleControl.completedSteps.load() / m_ensembleRuns) : 0;
+        if (percent == m_lastShownEnsemblePercent) return;
+        m_lastShownEnsemblePercent = percent;
+        if (m_errorMessagesLabel) {
+            m_errorMessagesLabel->getRenderer()->setTextColor(tgui::Color(0, 0, 160));
+            m_errorMessagesLabel->setText(L" -: " + tgui::String::fromNumber(percent) + L"%");
+            m_windowDirty = true;
+        }
+        return;
+    }
+
+    const EnsembleResult result = m_ensembleResult.get();
+    m_windowDirty = true;
+    buildEnsembleOverlay(result);
+
+    const double daysPerUnit = m_ensembleTimeUnit / SimulationConfig::SECONDS_PER_DAY;
+    std::wostringstream summary;
+    summary << std::setprecision(3) << L": " << result.runs << L" , \n "
+        << result.impactProbability;
+    if (result.impacts > 0) {
+        summary << L",   .\n" << result.meanImpactTime * daysPerUnit << L" +- " << result.impactTimeStdDev * daysPerUnit << L" .";
+    }
+    if (m_errorMessagesLabel) {
+        m_errorMessagesLabel->getRenderer()->setTextColor(tgui::Color(0, 128, 0));
+        m_errorMessagesLabel->setText(summary.str());
+    }
+    std::cout << "UserInterface: Monte-Carlo ensemble finished: " << result.runs << " runs, "
+        << result.impacts << " impacts." << std::endl;
+}
+
+void UserInterface::buildEnsembleOverlay(const EnsembleResult& result) {
+    clearEnsembleOverlay();
+    const sf::Color meanColor(255, 140, 0);
+    const sf::Color ellipseColor(0, 90, 220, 140);
+    const size_t ELLIPSE_COUNT = 20;
+    const size_t ELLIPSE_SEGMENTS = 48;
+    const double TWO_PI = 2.0 * std::acos(-1.0);
+
+    //   -  ,          
+    for (const EnsembleTimeSample& sample : result.samples) {
+        if (sample.count == 0) break;
+        m_ensembleMeanPath.emplace_back(sf::Vector2f(static_cast<float>(sample.meanX), static_cast<float>(-sample.meanY)), meanColor);
+    }
+
+    //  2 :  -     ,   2
+    const size_t stride = std::max<size_t>(result.samples.size() / ELLIPSE_COUNT, 1);
+    for (size_t k = 0; k < result.samples.size(); k += stride) {
+        const EnsembleTimeSample& sample = result.samples[k];
+        if (sample.count < 2) continue;
+        const double halfTrace = 0.5 * (sample.varianceX + sample.varianceY);
+        const double halfDifference = 0.5 * (sample.varianceX - sample.varianceY);
+        const double root = std::sqrt(halfDifference * halfDifference + sample.covarianceXY * sample.covarianceXY);
+        const double major = 2.0 * std::sqrt(std::max(halfTrace + root, 0.0));
+        const double minor = 2.0 * std::sqrt(std::max(halfTrace - root, 0.0));
+        const double angle = 0.5 * std::atan2(2.0 * sample.covarianceXY, sample.varianceX - sample.varianceY);
+        const double c = std::cos(angle), s = std::sin(angle);
+
+        auto pointAt = [&](size_t segment) {
+            const double t = TWO_PI * static_cast<double>(segment) / static_cast<double>(ELLIPSE_SEGMENTS);
+            const double u = major * std::cos(t), v = minor * std::sin(t);
+            const double x = sample.meanX + u * c - v * s;
+            const double y = sample.meanY + u * s + v * c;
+            return sf::Vertex(sf::Vector2f(static_cast<float>(x), static_cast<float>(-y)), ellipseColor);
+        };
+        for (size_t segment = 0; segment < ELLIPSE_SEGMENTS; ++segment) {
+            m_ensembleEllipses.push_back(pointAt(segment));
+            m_ensembleEllipses.push_back(pointAt(segment + 1));
+        }
+    }
+
+    if (result.impacts > 0) m_ensembleHistogram = result.impactTimeHistogram;
+    m_canvasDirty = true;
+}
+
+void UserInterface::clearEnsembleOverlay() {
+    if (m_ensembleMeanPath.empty() && m_ensembleEllipses.empty() && m_ensembleHistogram.empty()) return;
+    m_ensembleMeanPath.clear();
+    m_ensembleEllipses.clear();
+    m_ensembleHistogram.clear();
+    m_canvasDirty = true;
+}
+
+//          ( )
+void UserInterface::drawEnsembleHistogram(sf::RenderTarget& target) {
+    const float width = 220.f, height = 110.f, margin = 10.f, padding = 6.f, titleHeight = 18.f;
+    const sf::Vector2f size(static_cast<float>(target.getSize().x), static_cast<float>(target.getSize().y));
+    const sf::Vector2f origin(size.x - width - margin, size.y - height - margin);
+
+    sf::RectangleShape background({ width, height });
+    background.setPosition(origin);
+    background.setFillColor(sf::Color(255, 255, 255, 220));
+    background.setOutlineColor(sf::Color(160, 160, 160));
+    background.setOutlineThickness(1.f);
+    target.draw(background);
+
+    if (m_sfmlFont.hasGlyph(L'')) {
+        sf::Text title(L"  ", m_sfmlFont, 12);
+        title.setFillColor(sf::Color(60, 60, 60));
+        title.setPosition(origin.x + padding, origin.y + 2.f);
+        target.draw(title);
+    }
+
+    const size_t maxCount = *std::max_element(m_ensembleHistogram.begin(), m_ensembleHistogram.end());
+    if (maxCount == 0) return;
+    const float plotHeight = height - titleHeight - 2.f * padding;
+    const float barWidth = (width - 2.f * padding) / static_cast<float>(m_ensembleHistogram.size());
+    sf::RectangleShape bar;
+    bar.setFillColor(sf::Color(0, 90, 220));
+    for (size_t b = 0; b < m_ensembleHistogram.size(); ++b) {
+        if (m_ensembleHistogram[b] == 0) continue;
+        const float barHeight = plotHeight * static_cast<float>(m_ensembleHistogram[b]) / static_cast<float>(maxCount);
+        bar.setSize({ std::max(barWidth - 1.f, 1.f), barHeight });
+        bar.setPosition(origin.x + padding + barWidth * static_cast<float>(b), origin.y + height - padding - barHeight);
+        target.draw(bar);
+    }
+}
+
+//    ;       
+bool UserInterface::openTrajectoryFile(const std::string& path) {
+    cancelCsvExport(); //      
+    if (!m_openedTrajectoryFile.open(path)) return false;
+    clearEnsembleOverlay();
+
+    m_calculatedStates.reset();
+    m_lastSimulationParams = m_openedTrajectoryFile.getParameters();
+    m_lastCalculationDT = m_openedTrajectoryFile.getDT();
+    m_lastTimeUnit = m_openedTrajectoryFile.getTimeUnitSeconds();
+
+    CanvasVertexSink canvasSink(MAX_CANVAS_VERTICES);
+    SimulationParameters sizing = m_lastSimulationParams;
+    const size_t count = getTrajectorySize();
+    sizing.STEPS = (count > 0) ? static_cast<int>(std::min<size_t>(count - 1, INT_MAX)) : 0; //   
+    canvasSink.begin(sizing);
+    canvasSink.consume(0, getTrajectoryData(), count);
+    canvasSink.end();
+
+    m_trajectoryAvailable = count > 0;
+    setTrajectoryDisplayPoints(std::move(canvasSink.getVertices()), canvasSink.getBounds());
+    refreshTable();
+
+    std::cout << "Trajectory file '" << path << "' mapped: " << getTrajectorySize() << " points." << std::endl;
+    return true;
 }
-#endif
 
 void UserInterface::onOpenDataFolderMenuItemClicked() {
     std::cout << "Menu: Open Data Folder clicked" << std::endl;
@@ -1001,110 +1574,120 @@ void UserInterface::onShowAboutMenuItemClicked() {
 }
 
 void UserInterface::prepareTrajectoryForDisplay() {
-    m_trajectoryDisplayPoints.clear();
-    if (!m_trajectoryAvailable || m_calculatedStates.empty()) {
+    std::vector<sf::Vertex> points;
+    if (!m_trajectoryAvailable || getTrajectorySize() == 0) {
+        setTrajectoryDisplayPoints(std::move(points), sf::FloatRect());
         return;
     }
 
-    m_trajectoryDisplayPoints.reserve(m_calculatedStates.size());
-    for (const auto& state : m_calculatedStates) {
-        m_trajectoryDisplayPoints.emplace_back(
+    const State* states = getTrajectoryData();
+    points.reserve(getTrajectorySize());
+    for (size_t i = 0; i < getTrajectorySize(); ++i) {
+        const State& state = states[i];
+        points.emplace_back(
             sf::Vector2f(static_cast<float>(state.x), static_cast<float>(-state.y)), // Y   
             sf::Color::Blue //   
         );
     }
+
+    float min_x = points[0].position.x, max_x = min_x;
+    float min_y = points[0].position.y, max_y = min_y;
+    for (const auto& vertex : points) {
+        min_x = std::min(min_x, vertex.position.x);
+        max_x = std::max(max_x, vertex.position.x);
+        min_y = std::min(min_y, vertex.position.y);
+        max_y = std::max(max_y, vertex.position.y);
+    }
+    setTrajectoryDisplayPoints(std::move(points), sf::FloatRect(min_x, min_y, max_x - min_x, max_y - min_y));
 }
 
-void UserInterface::drawTrajectoryOnCanvas(sf::RenderTarget& canvasRenderTarget) {
-    sf::View originalView = canvasRenderTarget.getView();
-    sf::View fittedView;
-
-    if (m_trajectoryAvailable && !m_trajectoryDisplayPoints.empty()) {
-
-        // 1.    (bounding box)   
-        //    (  +   (0,0)   )
-        float min_x_content = m_trajectoryDisplayPoints[0].position.x;
-        float max_x_content = m_trajectoryDisplayPoints[0].position.x;
-        float min_y_content = m_trajectoryDisplayPoints[0].position.y; //  <= 0
-        float max_y_content = m_trajectoryDisplayPoints[0].position.y; //  >= min_y_content,   > 0    y_sim=0
-
-        for (const auto& vertex : m_trajectoryDisplayPoints) {
-            min_x_content = std::min(min_x_content, vertex.position.x);
-            max_x_content = std::max(max_x_content, vertex.position.x);
-            min_y_content = std::min(min_y_content, vertex.position.y);
-            max_y_content = std::max(max_y_content, vertex.position.y);
-        }
+void UserInterface::setTrajectoryDisplayPoints(std::vector<sf::Vertex>&& points, const sf::FloatRect& bounds) {
+    m_trajectoryDisplayPoints = std::move(points);
+    m_trajectoryBounds = bounds;
+    m_canvasViewDirty = true;
+    m_canvasDirty = true;
+}
 
-        // ,  (0,0)   bounding box
-        min_x_content = std::min(min_x_content, 0.0f);
-        max_x_content = std::max(max_x_content, 0.0f);
-        min_y_content = std::min(min_y_content, 0.0f); //   y < 0,  max_y_content  0.0f
-        max_y_content = std::max(max_y_content, 0.0f); //   y > 0 (    ), min_y_content  0.0f
-
-        //      
-        float content_width_no_padding = max_x_content - min_x_content;
-        float content_height_no_padding = max_y_content - min_y_content; //  
-
-        // 2.   (padding)
-        float paddingFactor = 0.1f; // 10% 
-
-        //      .
-        //     (),    .
-        const float MIN_DIM_FOR_PERCENT_PADDING = 0.1f; //    ,     
-        float base_width_for_padding = std::max(content_width_no_padding, MIN_DIM_FOR_PERCENT_PADDING);
-        float base_height_for_padding = std::max(content_height_no_padding, MIN_DIM_FOR_PERCENT_PADDING);
-
-        float padding_x = base_width_for_padding * paddingFactor;
-        float padding_y = base_height_for_padding * paddingFactor;
-
-        //   
-        float padded_min_x = min_x_content - padding_x;
-        float padded_max_x = max_x_content + padding_x;
-        float padded_min_y = min_y_content - padding_y; //    
-        float padded_max_y = max_y_content + padding_y; //     (   ,  max_y_content  <0)
-
-        //    
-        float actual_padded_content_width = padded_max_x - padded_min_x;
-        float actual_padded_content_height = padded_max_y - padded_min_y;
-
-        // 3.  ""     View.
-        //     ,          View.
-        const float MIN_EFFECTIVE_VIEW_DIMENSION = 0.02f; //    View    (   )
-        float effective_view_content_width = std::max(actual_padded_content_width, MIN_EFFECTIVE_VIEW_DIMENSION);
-        float effective_view_content_height = std::max(actual_padded_content_height, MIN_EFFECTIVE_VIEW_DIMENSION);
-
-        // 4.   sf::View,      
-        //      effective_view_content_width/height.
-        sf::Vector2u canvasSize = canvasRenderTarget.getSize();
-        if (canvasSize.x == 0 || canvasSize.y == 0) {
-            canvasRenderTarget.setView(originalView); //   ,   
-            return;
-        }
-        float canvasAspectRatio = static_cast<float>(canvasSize.x) / canvasSize.y;
-        float effectiveContentAspectRatio = effective_view_content_width / effective_view_content_height;
+void UserInterface::updateFittedCanvasView(sf::Vector2u canvasSize) {
+    m_fittedCanvasSize = canvasSize;
+    m_canvasViewDirty = false;
+    if (canvasSize.x == 0 || canvasSize.y == 0) return;
+
+    // 1.    ( )
+    //       (0,0)   
+    float min_x_content = std::min(m_trajectoryBounds.left, 0.0f);
+    float max_x_content = std::max(m_trajectoryBounds.left + m_trajectoryBounds.width, 0.0f);
+    float min_y_content = std::min(m_trajectoryBounds.top, 0.0f);
+    float max_y_content = std::max(m_trajectoryBounds.top + m_trajectoryBounds.height, 0.0f);
+    //      
+    float content_width_no_padding = max_x_content - min_x_content;
+    float content_height_no_padding = max_y_content - min_y_content; //  
+
+    // 2.   (padding)
+    float paddingFactor = 0.1f; // 10% 
+
+    //      .
+    //     (),    .
+    const float MIN_DIM_FOR_PERCENT_PADDING = 0.1f; //    ,     
+    float base_width_for_padding = std::max(content_width_no_padding, MIN_DIM_FOR_PERCENT_PADDING);
+    float base_height_for_padding = std::max(content_height_no_padding, MIN_DIM_FOR_PERCENT_PADDING);
+
+    float padding_x = base_width_for_padding * paddingFactor;
+    float padding_y = base_height_for_padding * paddingFactor;
+
+    //   
+    float padded_min_x = min_x_content - padding_x;
+    float padded_max_x = max_x_content + padding_x;
+    float padded_min_y = min_y_content - padding_y; //    
+    float padded_max_y = max_y_content + padding_y; //     (   ,  max_y_content  <0)
+
+    //    
+    float actual_padded_content_width = padded_max_x - padded_min_x;
+    float actual_padded_content_height = padded_max_y - padded_min_y;
+
+    // 3.  ""     View.
+    //     ,          View.
+    const float MIN_EFFECTIVE_VIEW_DIMENSION = 0.02f; //    View    (   )
+    float effective_view_content_width = std::max(actual_padded_content_width, MIN_EFFECTIVE_VIEW_DIMENSION);
+    float effective_view_content_height = std::max(actual_padded_content_height, MIN_EFFECTIVE_VIEW_DIMENSION);
+
+    // 4.   sf::View,      
+    //      effective_view_content_width/height.
+    float canvasAspectRatio = static_cast<float>(canvasSize.x) / canvasSize.y;
+    float effectiveContentAspectRatio = effective_view_content_width / effective_view_content_height;
+
+    float view_width_world;  //   View   
+    float view_height_world; //   View   
+
+    if (canvasAspectRatio > effectiveContentAspectRatio) {
+        view_height_world = effective_view_content_height;
+        view_width_world = view_height_world * canvasAspectRatio;
+    }
+    else {
+        view_width_world = effective_view_content_width;
+        view_height_world = view_width_world / canvasAspectRatio;
+    }
+    m_fittedCanvasView.setSize(view_width_world, view_height_world);
 
-        float view_width_world;  //   View   
-        float view_height_world; //   View   
+    // 5.  sf::View   **  .
+    //      .     actual_padded_*,   effective_*.
+    sf::Vector2f actual_padded_content_center(
+        padded_min_x + actual_padded_content_width / 2.0f,
+        padded_min_y + actual_padded_content_height / 2.0f
+    );
+    m_fittedCanvasView.setCenter(actual_padded_content_center);
+}
 
-        if (canvasAspectRatio > effectiveContentAspectRatio) {
-            view_height_world = effective_view_content_height;
-            view_width_world = view_height_world * canvasAspectRatio;
-        }
-        else {
-            view_width_world = effective_view_content_width;
-            view_height_world = view_width_world / canvasAspectRatio;
-        }
-        fittedView.setSize(view_width_world, view_height_world);
+void UserInterface::drawTrajectoryOnCanvas(sf::RenderTarget& canvasRenderTarget) {
+    sf::View originalView = canvasRenderTarget.getView();
 
-        // 5.  sf::View   **  .
-        //      .     actual_padded_*,   effective_*.
-        sf::Vector2f actual_padded_content_center(
-            padded_min_x + actual_padded_content_width / 2.0f,
-            padded_min_y + actual_padded_content_height / 2.0f
-        );
-        fittedView.setCenter(actual_padded_content_center);
+    if (!m_trajectoryDisplayPoints.empty()) { //      
+        sf::Vector2u canvasSize = canvasRenderTarget.getSize();
+        if (canvasSize.x == 0 || canvasSize.y == 0) return; //   ,   
 
-        canvasRenderTarget.setView(fittedView);
+        // View        
+        if (m_canvasViewDirty || canvasSize != m_fittedCanvasSize) updateFittedCanvasView(canvasSize);
+        canvasRenderTarget.setView(m_fittedCanvasView);
 
         // ---  ---
         const float actual_central_body_radius = 0.01f; //  
@@ -1116,6 +1699,13 @@ void UserInterface::drawTrajectoryOnCanvas(sf::RenderTarget& canvasRenderTarget)
 
         // m_trajectoryDisplayPoints    !empty()  
         canvasRenderTarget.draw(m_trajectoryDisplayPoints.data(), m_trajectoryDisplayPoints.size(), sf::LineStrip);
+
+        if (!m_ensembleEllipses.empty()) canvasRenderTarget.draw(m_ensembleEllipses.data(), m_ensembleEllipses.size(), sf::Lines);
+        if (!m_ensembleMeanPath.empty()) canvasRenderTarget.draw(m_ensembleMeanPath.data(), m_ensembleMeanPath.size(), sf::LineStrip);
+        if (!m_ensembleHistogram.empty()) {
+            canvasRenderTarget.setView(canvasRenderTarget.getDefaultView());
+            drawEnsembleHistogram(canvasRenderTarget);
+        }
     }
     else {
         canvasRenderTarget.setView(canvasRenderTarget.getDefaultView());
@@ -1139,13 +1729,55 @@ void UserInterface::drawTrajectoryOnCanvas(sf::RenderTarget& canvasRenderTarget)
     canvasRenderTarget.setView(originalView); //   View
 }
 
+//    (   )
+//  WorldTrajectoryData (std::vector<std::pair<double, double>>)
+WorldTrajectoryData UserInterface::buildWorldTrajectory() const {
+    WorldTrajectoryData trajectory;
+    const State* states = getTrajectoryData();
+    trajectory.reserve(getTrajectorySize());
+    for (size_t i = 0; i < getTrajectorySize(); ++i) {
+        trajectory.emplace_back(states[i].x, states[i].y);
+    }
+    return trajectory;
+}
+
 void UserInterface::onShowVisualizerButtonPressed() {
     std::cout << "Show Visualizer button pressed!" << std::endl;
 
     if (m_errorMessagesLabel) m_errorMessagesLabel->setText(L"");
     if (m_inputTitleLabel) m_inputTitleLabel->setText(L" ");
 
-    if (!m_trajectoryAvailable || m_calculatedStates.empty()) {
+    //          
+    if (m_simulationJob.isRunning()) {
+        drainLivePreview();
+        std::cout << "UserInterface: Launching TrajectoryVisualizer for the running simulation ("
+            << m_previewWorldPoints.size() << " points so far)." << std::endl;
+        try {
+            TrajectoryVisualizer visualizer(1000, 800);
+            visualizer.setLiveSource([this](WorldTrajectoryData& points) {
+                //    ,   ,    
+                if (m_simulationJob.isRunning()) {
+                    drainLivePreview();
+                    points.insert(points.end(), m_previewWorldPoints.begin() + points.size(), m_previewWorldPoints.end());
+                    return true;
+                }
+                if (m_simulationJob.getStatus() == SimulationJob::Status::Finished) {
+                    onSimulationFinished();
+                    if (m_trajectoryAvailable) points = buildWorldTrajectory(); //    
+                }
+                return false;
+            });
+            visualizer.setData(m_previewWorldPoints);
+            visualizer.run();
+        }
+        catch (const std::exception& e) {
+            std::cerr << "UserInterface: Exception while running TrajectoryVisualizer: " << e.what() << std::endl;
+        }
+        std::cout << "UserInterface: TrajectoryVisualizer window closed." << std::endl;
+        return;
+    }
+
+    if (!m_trajectoryAvailable || getTrajectorySize() == 0) {
         std::cerr << "UserInterface: No trajectory data to visualize. Please calculate first." << std::endl;
         if (m_errorMessagesLabel) {
             m_errorMessagesLabel->getRenderer()->setTextColor(tgui::Color::Red);
@@ -1154,13 +1786,7 @@ void UserInterface::onShowVisualizerButtonPressed() {
         return;
     }
 
-    //  m_calculatedStates (std::vector<State>) 
-    //  WorldTrajectoryData (std::vector<std::pair<double, double>>)
-    WorldTrajectoryData trajectoryForVisualizer;
-    trajectoryForVisualizer.reserve(m_calculatedStates.size());
-    for (const auto& state : m_calculatedStates) {
-        trajectoryForVisualizer.emplace_back(state.x, state.y);
-    }
+    WorldTrajectoryData trajectoryForVisualizer = buildWorldTrajectory();
 
     if (trajectoryForVisualizer.empty()) {
         std::cerr << "UserInterface: Conversion to WorldTrajectoryData resulted in empty data." << std::endl;
@@ -1201,34 +1827,20 @@ void UserInterface::onLoadTestDataButtonPressed() {
         return;
     }
 
-    std::string line, key, value;
-    std::string loaded_m_str, loaded_M_str, loaded_V0_str, loaded_T_str, loaded_k_str, loaded_F_str;
+    inFile.close();
 
     //     
-    while (std::getline(inFile, line)) {
-        size_t delimiterPos = line.find('=');
-        if (delimiterPos != std::string::npos) {
-            key = line.substr(0, delimiterPos);
-            value = line.substr(delimiterPos + 1);
-
-            if (key == "m_satellite_kg") loaded_m_str = value;
-            else if (key == "M_central_body_factor") loaded_M_str = value;
-            else if (key == "V0_m_per_s") loaded_V0_str = value;
-            else if (key == "T_days") loaded_T_str = value;
-            else if (key == "k_coeff") loaded_k_str = value;
-            else if (key == "F_coeff") loaded_F_str = value;
-        }
-    }
-    inFile.close();
+    ParameterStrings loadedValues;
+    SimulationConfig::loadParameterFile(TEST_DATA_FILENAME, loadedValues);
 
     //   EditBox  
     // ,    ,     ,     
-    if (m_edit_m && !loaded_m_str.empty()) m_edit_m->setText(loaded_m_str);
-    if (m_edit_M && !loaded_M_str.empty()) m_edit_M->setText(loaded_M_str);
-    if (m_edit_V0 && !loaded_V0_str.empty()) m_edit_V0->setText(loaded_V0_str);
-    if (m_edit_T && !loaded_T_str.empty()) m_edit_T->setText(loaded_T_str);
-    if (m_edit_k && !loaded_k_str.empty()) m_edit_k->setText(loaded_k_str);
-    if (m_edit_F && !loaded_F_str.empty()) m_edit_F->setText(loaded_F_str);
+    if (m_edit_m && !loadedValues.m_satellite_kg.empty()) m_edit_m->setText(loadedValues.m_satellite_kg);
+    if (m_edit_M && !loadedValues.M_central_body_factor.empty()) m_edit_M->setText(loadedValues.M_central_body_factor);
+    if (m_edit_V0 && !loadedValues.V0_m_per_s.empty()) m_edit_V0->setText(loadedValues.V0_m_per_s);
+    if (m_edit_T && !loadedValues.T_days.empty()) m_edit_T->setText(loadedValues.T_days);
+    if (m_edit_k && !loadedValues.k_coeff.empty()) m_edit_k->setText(loadedValues.k_coeff);
+    if (m_edit_F && !loadedValues.F_coeff.empty()) m_edit_F->setText(loadedValues.F_coeff);
 
     std::cout << "Test data loaded from '" << TEST_DATA_FILENAME << "' into UI fields." << std::endl;
     if (m_errorMessagesLabel) {
@@ -1237,210 +1849,134 @@ void UserInterface::onLoadTestDataButtonPressed() {
     }
 }
 
-void UserInterface::populateTable(const std::vector<TableRowData>& data) {
-    if (!m_tableDataGrid || !m_tableDataPanel) { return; }
-    m_tableDataGrid->removeAllWidgets();
-    
-    const float CELL_ROW_HEIGHT = 30.f;
-    std::vector<float> columnWidthPercentages = { 0.20f, 0.20f, 0.20f, 0.20f, 0.20f };
-    
-    if (data.empty()) {
-        auto emptyLabel = tgui::Label::create(L"   ");
-        if (emptyLabel) {
-            emptyLabel->setHorizontalAlignment(tgui::Label::HorizontalAlignment::Center);
-            emptyLabel->setSize({ "100%", CELL_ROW_HEIGHT }); //    ,  
-            m_tableDataGrid->addWidget(emptyLabel, 0, 0);
-        }
-        if (m_tableDataPanel) {
-            m_tableDataPanel->setContentSize(m_tableDataGrid->getSize());
-        }
+//     ;     
+void UserInterface::refreshTable() {
+    if (!m_trajectoryAvailable) {
+        m_tableView.clear();
         return;
     }
-
-    size_t step = 1;
-    unsigned int max_rows_to_display_limit = 100;
-    if (data.size() > max_rows_to_display_limit) { 
-        step = data.size() / max_rows_to_display_limit;
-    }
-    if (step == 0) step = 1;
-
-    unsigned int grid_row_index = 0;
-    unsigned int borderThicknessData = 1;
-    
-    float panelWidth = m_tableDataPanel->getSize().x;
-    float actualDataGridWidth = panelWidth - SCROLLBAR_WIDTH_ESTIMATE;
-
-    if (actualDataGridWidth < 1.0f) {
-        actualDataGridWidth = 400; //   
-        std::cout << "CRITICAL WARNING: Fallback actualDataGridWidth: " << actualDataGridWidth << std::endl;
-    }
-
-    for (size_t i = 0; i < data.size(); i += step) {
-        const auto& rowData = data[i];
-        std::vector<tgui::String> rowStrings;
-
-        std::stringstream ss_h, ss_x, ss_y, ss_vx, ss_vy;
-        ss_h << std::fixed << std::setprecision(2) << data[i].h_days; rowStrings.push_back(tgui::String(ss_h.str()));
-        ss_x << std::fixed << std::setprecision(2) << data[i].x; rowStrings.push_back(tgui::String(ss_x.str()));
-        ss_y << std::fixed << std::setprecision(2) << data[i].y; rowStrings.push_back(tgui::String(ss_y.str()));
-        ss_vx << std::fixed << std::setprecision(2) << data[i].Vx; rowStrings.push_back(tgui::String(ss_vx.str()));
-        ss_vy << std::fixed << std::setprecision(2) << data[i].Vy; rowStrings.push_back(tgui::String(ss_vy.str()));
-
-        for (size_t j = 0; j < rowStrings.size(); ++j) {
-            auto cellLabel = tgui::Label::create(rowStrings[j]);
-            if (cellLabel) {
-                cellLabel->getRenderer()->setTextColor(tgui::Color::Black);
-                cellLabel->setHorizontalAlignment(tgui::Label::HorizontalAlignment::Center);
-                cellLabel->setVerticalAlignment(tgui::Label::VerticalAlignment::Center);
-
-                float cellWidth = actualDataGridWidth * columnWidthPercentages[j];
-                cellLabel->setSize({ std::max(1.0f, cellWidth), CELL_ROW_HEIGHT });
-
-                if (grid_row_index < 1 && i < 1 * step) { //      
-                    std::cout << "  Cell (" << grid_row_index << "," << j << ") text: '" << rowStrings[j].toStdString()
-                        << "' wants cellWidth: " << cellWidth << " actual labelSize: " << cellLabel->getSize().x << "x" << cellLabel->getSize().y << std::endl;
-                }
-
-                unsigned int rightB_data = (j < rowStrings.size() - 1) ? borderThicknessData : 0;
-                cellLabel->getRenderer()->setBorders({ 0, 0, rightB_data, 0 });
-                cellLabel->getRenderer()->setBorderColor(tgui::Color(200, 200, 200));
-                m_tableDataGrid->addWidget(cellLabel, grid_row_index, static_cast<unsigned int>(j));
-            }
-        }
-        grid_row_index++;
-    }
-
-    if (m_tableDataPanel && m_tableDataGrid) {
-        float totalGridHeight = grid_row_index * CELL_ROW_HEIGHT;
-        if (data.empty() && m_tableDataGrid->getWidgets().size() > 0) totalGridHeight = CELL_ROW_HEIGHT;
-        else if (data.empty()) totalGridHeight = 0;
-
-        m_tableDataGrid->setSize({ actualDataGridWidth, totalGridHeight });
-        m_tableDataPanel->setContentSize({ actualDataGridWidth, totalGridHeight });
-    }
+    m_tableView.setTrajectory(getTrajectoryData(), getTrajectorySize(), m_lastCalculationDT, m_lastTimeUnit);
 }
 
-InputParameters UserInterface::validateAndParseParameters(
-    const std::string& m_str, const std::string& M_str, const std::string& V0_str,
-    const std::string& T_str, const std::string& k_str, const std::string& F_str) {
-
-    InputParameters params;
-    std::wstringstream errorMessages;
-
-    try {
-        params.m_satellite_kg = std::stod(m_str); 
-        if (params.m_satellite_kg < 0.1 || params.m_satellite_kg > 100000.0) {
-            params.isValid = false;
-            errorMessages << L"  (m)   [0.1, 100.000] .\n"; 
-        }
-    }
-    catch (const std::exception&) {
-        params.isValid = false;
-        errorMessages << L"    (m).\n";
-    }
-
-    try {
-        params.M_central_body_factor = std::stod(M_str);
-        if (params.M_central_body_factor < 0.1 || params.M_central_body_factor > 1.0e5) {
-            params.isValid = false;
-            errorMessages << L" .  (M)   [0,1, 100.000].\n";
-        }
-    }
-    catch (const std::exception&) {
-        params.isValid = false;
-        errorMessages << L"   .  (M).\n";
-    }
-
-    try {
-        params.V0_m_per_s = std::stod(V0_str);
-        if (params.V0_m_per_s < 0.0 || params.V0_m_per_s > 1000) { 
-            params.isValid = false;
-            errorMessages << L"  (V0)   [0, 1000] /.\n";
-        }
-    }
-    catch (const std::exception&) {
-        params.isValid = false;
-        errorMessages << L"    (V0).\n";
-    }
-
-    try {
-        params.T_days = std::stod(T_str);
-        if (params.T_days < 1 || params.T_days > 1.0e7) {
-            params.isValid = false;
-            errorMessages << L"  (T)   [1, 10.000.000] .\n";
-        }
-    }
-    catch (const std::exception&) {
-        params.isValid = false;
-        errorMessages << L"    (T).\n";
-    }
+// ---      ---
+void UserInterface::run() {
+    m_window.setFramerateLimit(60); //       
+    m_frameStatsClock.restart();
+    m_frameStatsCpuStart = getProcessCpuSeconds();
+    while (m_window.isOpen()) {
+        handleEvents(canWaitForEvents());
+        update();
+        if (m_gui.updateTime()) m_windowDirty = true; //  ,     TGUI
 
-    try {
-        params.k_coeff = std::stod(k_str);
-        if (params.k_coeff < 0.0 || params.k_coeff > 2.0) {
-            params.isValid = false;
-            errorMessages << L" k   [0.0, 2.0].\n";
+        if (m_windowDirty || m_canvasDirty) {
+            render();
         }
-    }
-    catch (const std::exception&) {
-        params.isValid = false;
-        errorMessages << L"   k.\n";
-    }
-
-    try {
-        params.F_coeff = std::stod(F_str);
-        if (params.F_coeff < 0.0 || params.F_coeff > 2.0) {
-            params.isValid = false;
-            errorMessages << L" F   [0.0, 2.0].\n";
+        else if (!canWaitForEvents()) {
+            sf::sleep(sf::milliseconds(IDLE_POLL_INTERVAL_MS)); //       TGUI
         }
+        updateFrameStats();
     }
-    catch (const std::exception&) {
-        params.isValid = false;
-        errorMessages << L"   F.\n";
-    }
-
-    params.errorMessage = errorMessages.str();
-    return params;
+    m_nbodyControl.cancelRequested = true; //      N    
+    m_ensembleControl.cancelRequested = true;
 }
 
-// ---      ---
-void UserInterface::run() {
-    m_window.setFramerateLimit(60); //  FPS     
-    while (m_window.isOpen()) {
-        handleEvents();
-        update();
-        render();
-    }
+bool UserInterface::canWaitForEvents() {
+    if (m_windowDirty || m_canvasDirty) return false;
+    //     ,       
+    SimulationJob::Status simulationStatus = m_simulationJob.getStatus();
+    if (simulationStatus == SimulationJob::Status::Running || simulationStatus == SimulationJob::Status::Finished) return false;
+    CsvExportJob::Status exportStatus = m_csvExportJob.getStatus();
+    if (exportStatus == CsvExportJob::Status::Running || exportStatus == CsvExportJob::Status::Finished
+        || exportStatus == CsvExportJob::Status::Failed) return false;
+    if (m_nbodyResult.valid() || m_ensembleResult.valid()) return false;
+    if (m_lastActivityClock.getElapsedTime() < sf::milliseconds(ANIMATION_LINGER_MS)) return false; //  
+
+    //       ,     ,  
+    tgui::Widget::Ptr focused = m_gui.getFocusedLeaf();
+    if (focused && (focused->getWidgetType() == "EditBox" || focused->getWidgetType() == "TextArea")) return false;
+    return true;
 }
 
-void UserInterface::handleEvents() {
+void UserInterface::handleEvents(bool waitForEvent) {
     sf::Event event;
-    while (m_window.pollEvent(event)) {
+    bool hasEvent = waitForEvent ? m_window.waitEvent(event) : m_window.pollEvent(event);
+    while (hasEvent) {
+        m_windowDirty = true; //      
+        m_lastActivityClock.restart();
         m_gui.handleEvent(event);
+        m_tableView.handleMouseWheel(event);
 
         if (event.type == sf::Event::Closed) {
             m_window.close();
         }
         else if (event.type == sf::Event::Resized) {
             sf::FloatRect visibleArea(0.f, 0.f, static_cast<float>(event.size.width), static_cast<float>(event.size.height));
-            m_window.setView(sf::View(visibleArea));
-
-            //     
-            // : m_currentTableData   
-            if (m_trajectoryAvailable || !m_currentTableData.empty() || m_tableDataGrid->getWidgets().size() > 0) {
-                populateTable(m_currentTableData);
-            }
+            m_window.setView(sf::View(visibleArea)); //      
         }
 
-        
+        hasEvent = m_window.pollEvent(event);
     }
 }
 
+//   FRAME_STATS_INTERVAL_MS   ,      .
+//     waitEvent,  ,       .
+void UserInterface::updateFrameStats() {
+    ++m_frameStatsWakeups;
+    float elapsed = m_frameStatsClock.getElapsedTime().asSeconds();
+    if (elapsed * 1000.f < FRAME_STATS_INTERVAL_MS) return;
+
+    double cpuNow = getProcessCpuSeconds();
+    double cpuPercent = 100.0 * (cpuNow - m_frameStatsCpuStart) / elapsed;
+    double frameMs = m_frameStatsFrames > 0 ? 1000.0 * m_frameStatsRenderTime.asSeconds() / m_frameStatsFrames : 0.0;
+
+    char text[128];
+    std::snprintf(text, sizeof(text), "%.1f fps, frame %.2f ms, CPU %.1f%%, wakeups %.1f/s",
+        m_frameStatsFrames / elapsed, frameMs, cpuPercent, m_frameStatsWakeups / elapsed);
+    if (m_frameStatsLabel && m_frameStatsLabel->getText() != text) {
+        m_frameStatsLabel->setText(text);
+        m_windowDirty = true;
+    }
+
+    m_frameStatsClock.restart();
+    m_frameStatsCpuStart = cpuNow;
+    m_frameStatsFrames = 0;
+    m_frameStatsWakeups = 0;
+    m_frameStatsRenderTime = sf::Time::Zero;
+}
+
 void UserInterface::update() {
-    //     ReadME
+    updateNBodySimulation();
+    updateEnsemble();
+
+    switch (m_simulationJob.getStatus()) {
+    case SimulationJob::Status::Running:
+        updateSimulationProgress();
+        drainLivePreview();
+        break;
+    case SimulationJob::Status::Finished:
+        onSimulationFinished();
+        m_windowDirty = true;
+        break;
+    default:
+        break;
+    }
+
+    switch (m_csvExportJob.getStatus()) {
+    case CsvExportJob::Status::Running:
+        updateCsvExportProgress();
+        break;
+    case CsvExportJob::Status::Finished:
+    case CsvExportJob::Status::Failed:
+        onCsvExportFinished();
+        m_windowDirty = true;
+        break;
+    default:
+        break;
+    }
 }
 
 void UserInterface::render() {
+    sf::Clock frameClock;
     if (m_trajectoryCanvas) {
         sf::RenderTexture& canvasRT = m_trajectoryCanvas->getRenderTexture();
         sf::Vector2f canvasWidgetSize = m_trajectoryCanvas->getSize(); //   TGUI
@@ -1452,14 +1988,22 @@ void UserInterface::render() {
                 if (!canvasRT.create(static_cast<unsigned int>(canvasWidgetSize.x), static_cast<unsigned int>(canvasWidgetSize.y))) {
                     std::cerr << "ERROR: Failed to recreate Canvas RenderTexture!" << std::endl;
                 }
+                m_canvasDirty = true; //    
             }
         }
 
-        canvasRT.clear(sf::Color(250, 250, 250));   //  
-        drawTrajectoryOnCanvas(canvasRT);           //        View
-        m_trajectoryCanvas->display();
+        //        ,    
+        if (m_canvasDirty) {
+            canvasRT.clear(sf::Color(250, 250, 250));   //  
+            drawTrajectoryOnCanvas(canvasRT);           //        View
+            m_trajectoryCanvas->display();
+            m_canvasDirty = false;
+        }
     }
     m_window.clear(sf::Color(220, 220, 220));
     m_gui.draw();
+    m_frameStatsRenderTime += frameClock.getElapsedTime(); //    display() -  FPS
+    ++m_frameStatsFrames;
+    m_windowDirty = false;
     m_window.display();
 }
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "../include/WorkStealingPool.h"
+
+#include <algorithm> //  std::max
+
+WorkStealingPool::WorkStealingPool(unsigned threadCount)
+    : m_task(nullptr),
+    m_batchId(0),
+    m_activeWorkers(0),
+    m_stop(false),
+    m_remaining(0) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    m_queues.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i) {
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    m_workers.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i) {
+        m_workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_batchMutex);
+        m_stop = true;
+    }
+    m_batchStart.notify_all();
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+void WorkStealingPool::parallelFor(size_t count, const std::function<void(size_t, unsigned)>& task) {
+    if (count == 0) return;
+    std::lock_guard<std::mutex> callLock(m_callMutex);
+
+    //  :    
+    const size_t threadCount = m_queues.size();
+    for (size_t w = 0; w < threadCount; ++w) {
+        size_t begin = count * w / threadCount;
+        size_t end = count * (w + 1) / threadCount;
+        std::lock_guard<std::mutex> queueLock(m_queues[w]->mutex);
+        for (size_t i = begin; i < end; ++i) m_queues[w]->tasks.push_back(i);
+    }
+
+    std::unique_lock<std::mutex> lock(m_batchMutex);
+    m_task = &task;
+    m_remaining.store(count, std::memory_order_release);
+    ++m_batchId;
+    m_batchStart.notify_all();
+
+    m_batchDone.wait(lock, [this] {
+        return m_remaining.load(std::memory_order_acquire) == 0 && m_activeWorkers == 0;
+    });
+    m_task = nullptr;
+}
+
+void WorkStealingPool::workerLoop(unsigned workerId) {
+    size_t seenBatch = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_batchMutex);
+            m_batchStart.wait(lock, [&] { return m_stop || m_batchId != seenBatch; });
+            if (m_stop) return;
+            seenBatch = m_batchId;
+            ++m_activeWorkers;
+        }
+
+        runBatch(workerId);
+
+        {
+            std::lock_guard<std::mutex> lock(m_batchMutex);
+            --m_activeWorkers;
+        }
+        m_batchDone.notify_all();
+    }
+}
+
+void WorkStealingPool::runBatch(unsigned workerId) {
+    size_t index = 0;
+    while (m_remaining.load(std::memory_order_acquire) > 0) {
+        if (popLocal(workerId, index) || steal(workerId, index)) {
+            (*m_task)(index, workerId);
+            m_remaining.fetch_sub(1, std::memory_order_acq_rel);
+        }
+        else {
+            std::this_thread::yield(); //  ,     
+        }
+    }
+}
+
+bool WorkStealingPool::popLocal(unsigned workerId, size_t& index) {
+    WorkerQueue& queue = *m_queues[workerId];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    index = queue.tasks.back();
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(unsigned thiefId, size_t& index) {
+    const size_t threadCount = m_queues.size();
+    for (size_t offset = 1; offset < threadCount; ++offset) {
+        WorkerQueue& victim = *m_queues[(thiefId + offset) % threadCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            index = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,331 @@
+﻿// Консольный запуск расчета без SFML/TGUI: читает файл параметров, считает траекторию
+// и пишет CSV (в файл или stdout) либо двоичный .trjb. Сообщения и сводка выводятся в stderr.
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h> // Для SetConsoleOutputCP
+#endif
+
+#include "../include/Calculations.h"
+#include "../include/SimulationConfig.h"
+#include "../include/TrajectorySink.h"
+#include "../include/TrajectoryFile.h"
+#include "../include/NBodySimulation.h"
+#include "../include/MonteCarloEnsemble.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace {
+
+    void printUsage(const char* program) {
+        std::cerr << "Usage: " << program << " [options]\n"
+            << "  --params FILE        parameter file (default: data/simulation_params.txt)\n"
+            << "  --output FILE        output file, '-' for CSV on stdout (default: -);\n"
+            << "                       a name ending in .trjb selects the binary format\n"
+            << "  --integrator NAME    rk4, dp45, verlet or yoshida4 (overrides the 'integrator' key)\n"
+            << "  --drift              report energy and angular momentum drift (meaningful for k = F = 0\n"
+            << "                       and no perturbation keys)\n"
+            << "  --checkpoint FILE    save a checkpoint (last state, step, parameters) every\n"
+            << "                       --checkpoint-every points and at the end of the run;\n"
+            << "                       needs a .trjb --output\n"
+            << "  --checkpoint-every N points between checkpoints (default: 100000)\n"
+            << "  --resume FILE        continue from a checkpoint up to the STEPS of the parameter\n"
+            << "                       file; --output must be the .trjb file of the interrupted or\n"
+            << "                       shorter run, new points are appended after the checkpoint\n"
+            << "  --nbody FILE         run an N-body scenario (see data/nbody_debris.txt) instead of\n"
+            << "                       the parameter file; --output gets one CSV row per body and frame,\n"
+            << "                       --drift reports the total energy drift (O(N^2) at start and end)\n"
+            << "  --ensemble           run a Monte-Carlo ensemble around the parameter file (mc_* keys)\n"
+            << "                       and print impact statistics; --output gets the mean position\n"
+            << "                       and covariance over time as CSV\n"
+            << "  --quiet              do not print the run summary\n"
+            << "  --convert IN OUT     convert a trajectory between CSV and .trjb and exit\n"
+            << "  --help               show this help\n";
+    }
+
+    // Сообщения проверки хранятся как std::wstring (для TGUI); в консоль выводим UTF-8
+    std::string toUtf8(const std::wstring& text) {
+        std::string result;
+        for (wchar_t wc : text) {
+            unsigned long c = static_cast<unsigned long>(wc);
+            if (c < 0x80) {
+                result += static_cast<char>(c);
+            }
+            else if (c < 0x800) {
+                result += static_cast<char>(0xC0 | (c >> 6));
+                result += static_cast<char>(0x80 | (c & 0x3F));
+            }
+            else {
+                result += static_cast<char>(0xE0 | ((c >> 12) & 0x0F));
+                result += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+                result += static_cast<char>(0x80 | (c & 0x3F));
+            }
+        }
+        return result;
+    }
+
+    int runNBodyScenario(const std::string& scenarioPath, const std::string& outputPath, bool reportDrift, bool quiet) {
+        NBodyParameters params;
+        NBodySystem system;
+        if (!NBodySimulation::loadScenario(scenarioPath, params, system)) return EXIT_FAILURE;
+        if (TrajectoryFile::hasBinaryExtension(outputPath)) {
+            std::cerr << "Error: N-body frames are written as CSV only.\n";
+            return EXIT_FAILURE;
+        }
+        std::unique_ptr<NBodyCsvSink> output = (outputPath == "-")
+            ? std::make_unique<NBodyCsvSink>(std::cout)
+            : std::make_unique<NBodyCsvSink>(outputPath);
+        if (output->hasFailed()) return EXIT_FAILURE;
+
+        NBodySimulation simulation;
+        const double initialEnergy = reportDrift ? simulation.computeEnergy(params, system) : 0.0;
+        auto startTime = std::chrono::steady_clock::now();
+        if (!simulation.run(params, system, *output)) return EXIT_FAILURE;
+        auto endTime = std::chrono::steady_clock::now();
+        if (output->hasFailed()) return EXIT_FAILURE;
+
+        if (!quiet) {
+            const NBodyStats& stats = simulation.getLastStats();
+            double seconds = std::chrono::duration<double>(endTime - startTime).count();
+            std::cerr << "N-body: " << system.size() << " bodies, DT = " << params.DT << ", STEPS = " << params.STEPS
+                << ", theta = " << params.theta << ", softening = " << params.softening << "\n"
+                << "Forces: " << (stats.treeNodes > 0 ? "Barnes-Hut tree (" + std::to_string(stats.treeNodes) + " nodes)" : std::string("direct sum"))
+                << ", " << stats.forceEvaluations << " evaluations on " << simulation.getThreadCount() << " threads\n"
+                << "Wall time: " << seconds << " s (" << 1000.0 * seconds / std::max(1, params.STEPS) << " ms per step, including output)\n";
+        }
+        if (reportDrift) {
+            const double finalEnergy = simulation.computeEnergy(params, system);
+            std::cerr << "Energy drift |dE/E0|: " << std::abs((finalEnergy - initialEnergy) / initialEnergy)
+                << " (E0 = " << initialEnergy << ")\n";
+        }
+        return EXIT_SUCCESS;
+    }
+
+    int runEnsemble(const InputParameters& input, const SimulationParameters& params, double timeUnit,
+        const std::string& outputPath, bool quiet) {
+        EnsembleDispersion dispersion;
+        EnsembleSettings settings;
+        if (!SimulationConfig::toEnsembleSettings(input, dispersion, settings)) return EXIT_FAILURE;
+        if (TrajectoryFile::hasBinaryExtension(outputPath)) {
+            std::cerr << "Error: ensemble statistics are written as CSV only.\n";
+            return EXIT_FAILURE;
+        }
+
+        MonteCarloEnsemble ensemble;
+        auto startTime = std::chrono::steady_clock::now();
+        const EnsembleResult result = ensemble.run(params, dispersion, settings);
+        auto endTime = std::chrono::steady_clock::now();
+
+        std::ofstream file;
+        if (outputPath != "-") {
+            file.open(outputPath);
+            if (!file) {
+                std::cerr << "Error: could not open '" << outputPath << "' for writing.\n";
+                return EXIT_FAILURE;
+            }
+        }
+        std::ostream& out = (outputPath == "-") ? std::cout : file;
+        out << "Time_dimless,Runs_In_Flight,Mean_x_dimless,Mean_y_dimless,Var_x,Var_y,Cov_xy\n";
+        out.precision(10);
+        for (const EnsembleTimeSample& sample : result.samples) {
+            out << sample.time << ',' << sample.count << ',' << sample.meanX << ',' << sample.meanY << ','
+                << sample.varianceX << ',' << sample.varianceY << ',' << sample.covarianceXY << '\n';
+        }
+        out.flush();
+        if (!out) return EXIT_FAILURE;
+
+        const double daysPerUnit = timeUnit / SimulationConfig::SECONDS_PER_DAY;
+        std::cerr << "Ensemble: " << result.runs << " runs, seed " << settings.seed << ", sigma V0 = " << dispersion.velocitySigma
+            << ", sigma position = " << dispersion.positionSigma << ", sigma k = " << dispersion.dragSigma << " (dimensionless)\n"
+            << "Impacts: " << result.impacts << ", probability " << result.impactProbability << "\n";
+        if (result.impacts > 0) {
+            std::cerr << "Time to impact: mean " << result.meanImpactTime * daysPerUnit << " days, std dev "
+                << result.impactTimeStdDev * daysPerUnit << " days\n";
+        }
+        if (!quiet && result.impacts > 0) {
+            // Гистограмма времени до столкновения: строка на столбец, пустые столбцы по краям опущены
+            const size_t maxCount = *std::max_element(result.impactTimeHistogram.begin(), result.impactTimeHistogram.end());
+            size_t first = 0, last = result.impactTimeHistogram.size();
+            while (result.impactTimeHistogram[first] == 0) ++first;
+            while (result.impactTimeHistogram[last - 1] == 0) --last;
+            for (size_t b = first; b < last; ++b) {
+                const size_t count = result.impactTimeHistogram[b];
+                std::cerr << "  " << b * result.histogramBinWidth * daysPerUnit << " days: "
+                    << std::string((count * 50 + maxCount - 1) / maxCount, '#') << " " << count << "\n";
+            }
+        }
+        if (!quiet) {
+            double seconds = std::chrono::duration<double>(endTime - startTime).count();
+            std::cerr << "Wall time: " << seconds << " s on " << ensemble.getThreadCount() << " threads\n";
+        }
+        return EXIT_SUCCESS;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+#ifdef _WIN32
+    SetConsoleOutputCP(CP_UTF8);
+#endif
+
+    std::string paramsPath = "data/simulation_params.txt";
+    std::string outputPath = "-";
+    std::string integratorOverride;
+    std::string checkpointPath;
+    std::string resumePath;
+    std::string nbodyPath;
+    long long checkpointInterval = 100000;
+    bool reportDrift = false;
+    bool quiet = false;
+    bool runEnsembleMode = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (std::strcmp(arg, "--params") == 0 && hasValue) paramsPath = argv[++i];
+        else if (std::strcmp(arg, "--output") == 0 && hasValue) outputPath = argv[++i];
+        else if (std::strcmp(arg, "--integrator") == 0 && hasValue) integratorOverride = argv[++i];
+        else if (std::strcmp(arg, "--checkpoint") == 0 && hasValue) checkpointPath = argv[++i];
+        else if (std::strcmp(arg, "--checkpoint-every") == 0 && hasValue) checkpointInterval = std::atoll(argv[++i]);
+        else if (std::strcmp(arg, "--resume") == 0 && hasValue) resumePath = argv[++i];
+        else if (std::strcmp(arg, "--nbody") == 0 && hasValue) nbodyPath = argv[++i];
+        else if (std::strcmp(arg, "--drift") == 0) reportDrift = true;
+        else if (std::strcmp(arg, "--quiet") == 0) quiet = true;
+        else if (std::strcmp(arg, "--ensemble") == 0) runEnsembleMode = true;
+        else if (std::strcmp(arg, "--convert") == 0 && i + 2 < argc) {
+            std::string from = argv[i + 1];
+            std::string to = argv[i + 2];
+            bool ok = TrajectoryFile::hasBinaryExtension(from)
+                ? TrajectoryFileConverter::binaryToCsv(from, to)
+                : TrajectoryFileConverter::csvToBinary(from, to);
+            return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+        else if (std::strcmp(arg, "--help") == 0) { printUsage(argv[0]); return EXIT_SUCCESS; }
+        else {
+            std::cerr << "Unknown or incomplete option: " << arg << "\n";
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!nbodyPath.empty()) return runNBodyScenario(nbodyPath, outputPath, reportDrift, quiet);
+
+    ParameterStrings values;
+    if (!SimulationConfig::loadParameterFile(paramsPath, values)) return EXIT_FAILURE;
+    if (!integratorOverride.empty()) values.integrator = integratorOverride;
+
+    InputParameters input = SimulationConfig::validate(values);
+    if (!input.isValid) {
+        std::cerr << "Error: invalid parameters in '" << paramsPath << "':\n" << toUtf8(input.errorMessage);
+        return EXIT_FAILURE;
+    }
+
+    SimulationParameters params;
+    double timeUnit = 1.0;
+    if (!SimulationConfig::toSimulationParameters(input, params, timeUnit)) return EXIT_FAILURE;
+    if (runEnsembleMode) return runEnsemble(input, params, timeUnit, outputPath, quiet);
+
+    if (checkpointInterval <= 0) {
+        std::cerr << "Error: --checkpoint-every must be a positive number of points.\n";
+        return EXIT_FAILURE;
+    }
+    if (!checkpointPath.empty() && !TrajectoryFile::hasBinaryExtension(outputPath)) {
+        // Продолжить можно только файл *.trjb, поэтому контрольные точки для CSV бесполезны
+        std::cerr << "Error: --checkpoint needs --output with a .trjb file.\n";
+        return EXIT_FAILURE;
+    }
+    SimulationCheckpoint resumeFrom;
+    if (!resumePath.empty()) {
+        if (!TrajectoryFile::hasBinaryExtension(outputPath)) {
+            std::cerr << "Error: --resume needs --output with the .trjb file to continue.\n";
+            return EXIT_FAILURE;
+        }
+        if (!TrajectoryFile::loadCheckpoint(resumePath, resumeFrom)) return EXIT_FAILURE;
+        if (!Calculations::sameModel(params, resumeFrom.params)) {
+            std::cerr << "Error: checkpoint '" << resumePath << "' was written for other parameters than '" << paramsPath << "'.\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    // CSV идет в исходный stdout; диагностика расчета (std::cout) перенаправляется в stderr
+    std::ostream csvStdout(std::cout.rdbuf());
+    std::streambuf* originalCoutBuffer = std::cout.rdbuf(std::cerr.rdbuf());
+
+    // Ровно один из двух получателей создается в зависимости от имени выходного файла
+    std::shared_ptr<BinaryTrajectorySink> binaryOutput;
+    std::shared_ptr<CsvTrajectorySink> csvOutput;
+    if (!resumePath.empty()) {
+        // Точки до контрольной включительно уже в файле; записанные после нее отбрасываются
+        binaryOutput = std::make_shared<BinaryTrajectorySink>(outputPath, timeUnit, resumeFrom);
+    }
+    else if (TrajectoryFile::hasBinaryExtension(outputPath)) {
+        binaryOutput = std::make_shared<BinaryTrajectorySink>(outputPath, timeUnit);
+    }
+    else if (outputPath == "-") {
+        csvOutput = std::make_shared<CsvTrajectorySink>(csvStdout);
+    }
+    else {
+        csvOutput = std::make_shared<CsvTrajectorySink>(outputPath);
+    }
+    auto outputFailed = [&] { return binaryOutput ? binaryOutput->hasFailed() : csvOutput->hasFailed(); };
+
+    if (outputFailed()) {
+        std::cout.rdbuf(originalCoutBuffer);
+        return EXIT_FAILURE;
+    }
+
+    // Контрольные точки пишутся после блока данных, который они описывают
+    FanOutSink sinks;
+    if (binaryOutput) sinks.add(binaryOutput);
+    else sinks.add(csvOutput);
+    std::shared_ptr<CheckpointSink> checkpoints;
+    if (!checkpointPath.empty()) {
+        checkpoints = std::make_shared<CheckpointSink>(checkpointPath, static_cast<size_t>(checkpointInterval), binaryOutput.get());
+        sinks.add(checkpoints);
+    }
+    std::shared_ptr<ConservationSink> conservation;
+    if (reportDrift) {
+        conservation = std::make_shared<ConservationSink>();
+        sinks.add(conservation);
+    }
+
+    Calculations calculator;
+    auto startTime = std::chrono::steady_clock::now();
+    bool resumed = true;
+    if (resumePath.empty()) calculator.runSimulation(params, sinks);
+    else resumed = calculator.resumeSimulation(params, resumeFrom, sinks);
+    auto endTime = std::chrono::steady_clock::now();
+
+    std::cout.rdbuf(originalCoutBuffer);
+    if (!resumed || outputFailed() || (checkpoints && checkpoints->hasFailed())) return EXIT_FAILURE;
+
+    if (!quiet) {
+        const IntegrationStats& stats = calculator.getLastStats();
+        double seconds = std::chrono::duration<double>(endTime - startTime).count();
+        std::cerr << "Integrator: " << SimulationConfig::getIntegratorKey(params.integrator)
+            << ", DT = " << params.DT << ", STEPS = " << params.STEPS
+            << ", time unit = " << timeUnit << " s\n";
+        if (!resumePath.empty()) std::cerr << "Resumed from step " << resumeFrom.stepIndex << " of '" << resumePath << "'\n";
+        if (checkpoints) std::cerr << "Checkpoints written: " << checkpoints->getWrittenCount() << " ('" << checkpointPath << "')\n";
+        std::cerr
+            << "Accepted steps: " << stats.acceptedSteps << ", rejected: " << stats.rejectedSteps
+            << ", derivative evaluations: " << stats.derivativeEvaluations << "\n"
+            << "Wall time: " << seconds << " s (including output)\n";
+    }
+    if (conservation) {
+        // Отчет о дрейфе выводится и с --quiet: его запрашивают явно
+        const ConservationReport& report = conservation->getReport();
+        std::cerr << "Energy drift |dE/E0|: max " << report.maxEnergyDrift << ", final " << report.finalEnergyDrift
+            << " (E0 = " << report.initialEnergy << ")\n"
+            << "Angular momentum drift |dL/L0|: max " << report.maxAngularMomentumDrift << ", final " << report.finalAngularMomentumDrift
+            << " (L0 = " << report.initialAngularMomentum << ", " << report.points << " points)\n";
+    }
+    return EXIT_SUCCESS;
+}
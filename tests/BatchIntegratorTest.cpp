@@ -0,0 +1,87 @@
+// TrajectoryBatch   Calculations::runSimulation
+#include "TestHarness.h"
+
+#include "../include/BatchIntegrator.h"
+#include "../include/ParameterSweep.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+    //     : ,  STEPS  k/F,   .
+    //     SIMD,      
+    std::vector<SimulationParameters> makeMixedLanes() {
+        std::vector<SimulationParameters> lanes;
+        for (int i = 0; i < 11; ++i) {
+            SimulationParameters params;
+            params.DT = 0.005;
+            params.STEPS = 3000 + 500 * (i % 4);
+            params.initialState.vy = 0.35 + 0.05 * i;
+            params.DRAG_COEFFICIENT = (i % 3 == 0) ? 0.05 : 0.0;
+            params.THRUST_COEFFICIENT = (i % 5 == 1) ? 0.02 : 0.0;
+            lanes.push_back(params);
+        }
+        lanes[2].initialState.vy = 0.05;          //   : 
+        lanes[7].initialState = { 0.005, 0.0, 0.0, 0.0 }; //      
+        lanes[9].STEPS = 1;
+        return lanes;
+    }
+
+    bool sameState(const State& a, const State& b) {
+        return a.x == b.x && a.y == b.y && a.vx == b.vx && a.vy == b.vy;
+    }
+
+    double relativeDeviation(const State& reference, const State& value) {
+        const double scale = std::max(std::hypot(reference.x, reference.y), 1e-300);
+        return std::hypot(reference.x - value.x, reference.y - value.y) / scale;
+    }
+
+    void checkBatchAgainstScalar(BatchKernel kernel) {
+        const std::vector<SimulationParameters> lanes = makeMixedLanes();
+        TrajectoryBatch batch(lanes, kernel);
+        long long maxSteps = 0;
+        for (const SimulationParameters& params : lanes) maxSteps = std::max<long long>(maxSteps, params.STEPS);
+        batch.advance(maxSteps + 1);
+        CHECK(!batch.hasActiveLanes());
+
+        Calculations calculator;
+        calculator.setEventMessages(false);
+        bool sawImpact = false;
+        for (size_t lane = 0; lane < lanes.size(); ++lane) {
+            SummarySink summary;
+            CollectingSink states;
+            calculator.runSimulation(lanes[lane], summary);
+            calculator.runSimulation(lanes[lane], states);
+            const SweepRunSummary& expected = summary.getSummary();
+            const State& last = states.getStates().back();
+
+            CHECK(batch.getImpactStep(lane) == expected.impactStep);
+            CHECK(batch.getStepsTaken(lane) + 1 == static_cast<long long>(expected.pointCount));
+            sawImpact = sawImpact || expected.impactStep >= 0;
+#ifdef TRAJCALC_NO_FP_CONTRACT
+            //    FMA     RK4 
+            CHECK(sameState(batch.getState(lane), last));
+            CHECK(batch.getMinR(lane) == expected.minR);
+            CHECK(batch.getMaxR(lane) == expected.maxR);
+#else
+            const double tolerance = TrajectoryBatch::BATCH_REFERENCE_TOLERANCE;
+            CHECK(relativeDeviation(last, batch.getState(lane)) <= tolerance);
+            CHECK_NEAR(batch.getMinR(lane), expected.minR, tolerance * expected.maxR);
+            CHECK_NEAR(batch.getMaxR(lane), expected.maxR, tolerance * expected.maxR);
+            (void)sameState;
+#endif
+        }
+        CHECK(sawImpact);
+        CHECK(batch.getImpactStep(7) == 0);
+    }
+
+} // namespace
+
+TRAJCALC_TEST(BatchScalarKernelMatchesRunSimulation) {
+    checkBatchAgainstScalar(BatchKernel::Scalar);
+}
+
+TRAJCALC_TEST(BatchNativeKernelMatchesRunSimulation) {
+    checkBatchAgainstScalar(BatchKernel::Native);
+}
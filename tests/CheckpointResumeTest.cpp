@@ -0,0 +1,192 @@
+//        ,     
+#include "TestHarness.h"
+
+#include "../include/Calculations.h"
+#include "../include/TrajectoryFile.h"
+#include "../include/TrajectorySink.h"
+
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+    constexpr int SHORT_STEPS = 6000;
+    constexpr int FULL_STEPS = 15000;
+    constexpr size_t CHECKPOINT_INTERVAL = 1000;
+
+    SimulationParameters makeParams(int steps) {
+        SimulationParameters params; //    ,    FULL_STEPS
+        params.DT = 0.002;
+        params.STEPS = steps;
+        return params;
+    }
+
+    std::vector<State> runUninterrupted(const SimulationParameters& params) {
+        Calculations calculator;
+        calculator.setEventMessages(false);
+        CollectingSink states;
+        calculator.runSimulation(params, states);
+        return states.getStates();
+    }
+
+    //  : SHORT_STEPS   *.trjb   
+    bool writeShortRun(const std::string& dataPath, const std::string& checkpointPath) {
+        auto data = std::make_shared<BinaryTrajectorySink>(dataPath);
+        auto checkpoints = std::make_shared<CheckpointSink>(checkpointPath, CHECKPOINT_INTERVAL, data.get());
+        FanOutSink sinks;
+        sinks.add(data);
+        sinks.add(checkpoints);
+        Calculations calculator;
+        calculator.setEventMessages(false);
+        calculator.runSimulation(makeParams(SHORT_STEPS), sinks);
+        return !data->hasFailed() && !checkpoints->hasFailed() && checkpoints->getWrittenCount() > 1;
+    }
+
+    bool resumeInto(const std::string& dataPath, const SimulationCheckpoint& checkpoint) {
+        BinaryTrajectorySink data(dataPath, 0.0, checkpoint);
+        Calculations calculator;
+        calculator.setEventMessages(false);
+        const bool resumed = calculator.resumeSimulation(makeParams(FULL_STEPS), checkpoint, data);
+        return resumed && !data.hasFailed();
+    }
+
+    void checkSameTrajectory(const std::string& dataPath, const std::vector<State>& expected) {
+        MappedTrajectoryFile file;
+        CHECK(file.open(dataPath));
+        CHECK(file.size() == expected.size());
+        if (file.size() != expected.size()) return;
+        CHECK(std::memcmp(file.data(), expected.data(), expected.size() * sizeof(State)) == 0);
+    }
+
+    std::vector<char> readBytes(const std::string& path) {
+        std::ifstream file(std::filesystem::u8path(path), std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    //  32-  (little-endian)   offset   
+    bool patchU32(const std::string& path, std::streamoff offset, std::uint32_t value) {
+        const char bytes[] = { static_cast<char>(value & 0xFF), static_cast<char>((value >> 8) & 0xFF),
+            static_cast<char>((value >> 16) & 0xFF), static_cast<char>((value >> 24) & 0xFF) };
+        std::fstream file(std::filesystem::u8path(path), std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(offset);
+        return static_cast<bool>(file.write(bytes, sizeof(bytes)));
+    }
+
+} // namespace
+
+TRAJCALC_TEST(ResumeExtendsToSameTrajectory) {
+    testing_detail::TemporaryDirectory directory("trajcalc_checkpoint_test");
+    const std::string dataPath = directory.file("run.trjb");
+    const std::string checkpointPath = directory.file("run.ckpt");
+    const std::vector<State> expected = runUninterrupted(makeParams(FULL_STEPS));
+    CHECK(expected.size() == static_cast<size_t>(FULL_STEPS) + 1);
+
+    CHECK(writeShortRun(dataPath, checkpointPath));
+    SimulationCheckpoint checkpoint;
+    CHECK(TrajectoryFile::loadCheckpoint(checkpointPath, checkpoint));
+    CHECK(checkpoint.stepIndex == static_cast<std::uint64_t>(SHORT_STEPS));
+    CHECK(resumeInto(dataPath, checkpoint));
+    checkSameTrajectory(dataPath, expected);
+}
+
+TRAJCALC_TEST(ResumeAfterCrashDropsPointsPastCheckpoint) {
+    testing_detail::TemporaryDirectory directory("trajcalc_checkpoint_test");
+    const std::string dataPath = directory.file("crash.trjb");
+    const std::string checkpointPath = directory.file("crash.ckpt");
+    const std::vector<State> expected = runUninterrupted(makeParams(FULL_STEPS));
+
+    // :     SHORT_STEPS + 1 ,      
+    CHECK(writeShortRun(dataPath, checkpointPath));
+    SimulationCheckpoint checkpoint;
+    checkpoint.params = makeParams(SHORT_STEPS);
+    checkpoint.stepIndex = 2 * CHECKPOINT_INTERVAL + 17;
+    checkpoint.state = expected[checkpoint.stepIndex];
+    CHECK(TrajectoryFile::saveCheckpoint(checkpointPath, checkpoint));
+
+    SimulationCheckpoint loaded;
+    CHECK(TrajectoryFile::loadCheckpoint(checkpointPath, loaded));
+    CHECK(loaded.stepIndex == checkpoint.stepIndex);
+    CHECK(std::memcmp(&loaded.state, &checkpoint.state, sizeof(State)) == 0);
+    CHECK(!std::filesystem::exists(std::filesystem::u8path(checkpointPath + ".tmp")));
+
+    CHECK(resumeInto(dataPath, loaded));
+    checkSameTrajectory(dataPath, expected);
+}
+
+TRAJCALC_TEST(ResumeLeavesForeignFileUntouched) {
+    testing_detail::TemporaryDirectory directory("trajcalc_checkpoint_test");
+    const std::string dataPath = directory.file("foreign.trjb");
+    const std::string checkpointPath = directory.file("foreign.ckpt");
+    CHECK(writeShortRun(dataPath, checkpointPath));
+    SimulationCheckpoint checkpoint;
+    CHECK(TrajectoryFile::loadCheckpoint(checkpointPath, checkpoint));
+    checkpoint.stepIndex = 2 * CHECKPOINT_INTERVAL; //   :      
+    {
+        MappedTrajectoryFile file;
+        CHECK(file.open(dataPath));
+        CHECK(file.size() > checkpoint.stepIndex);
+        if (file.size() <= checkpoint.stepIndex) return;
+        checkpoint.state = file.data()[checkpoint.stepIndex];
+    }
+    const std::vector<char> original = readBytes(dataPath);
+
+    //     ( DT)
+    SimulationCheckpoint otherModel = checkpoint;
+    otherModel.params.DT *= 2;
+    BinaryTrajectorySink otherModelSink(dataPath, 0.0, otherModel);
+    CHECK(otherModelSink.hasFailed());
+    CHECK(!otherModelSink.isOpen());
+    CHECK(readBytes(dataPath) == original);
+
+    //   ,       stepIndex  
+    SimulationCheckpoint otherState = checkpoint;
+    otherState.state.vx = std::nextafter(otherState.state.vx, 0.0);
+    BinaryTrajectorySink otherStateSink(dataPath, 0.0, otherState);
+    CHECK(otherStateSink.hasFailed());
+    CHECK(readBytes(dataPath) == original);
+
+    //    
+    SimulationCheckpoint pastEnd = checkpoint;
+    pastEnd.stepIndex = static_cast<std::uint64_t>(SHORT_STEPS) + 1;
+    BinaryTrajectorySink pastEndSink(dataPath, 0.0, pastEnd);
+    CHECK(pastEndSink.hasFailed());
+    CHECK(readBytes(dataPath) == original);
+
+    //    ,     
+    BinaryTrajectorySink matchingSink(dataPath, 0.0, checkpoint);
+    CHECK(!matchingSink.hasFailed());
+    CHECK(readBytes(dataPath).size() == TrajectoryFile::HEADER_SIZE + (checkpoint.stepIndex + 1) * sizeof(State));
+}
+
+TRAJCALC_TEST(HeadersWithUnknownIntegratorOrTooManyStepsAreRejected) {
+    testing_detail::TemporaryDirectory directory("trajcalc_checkpoint_test");
+    const std::string dataPath = directory.file("header.trjb");
+    const std::string checkpointPath = directory.file("header.ckpt");
+    constexpr std::streamoff OFFSET_STEPS = 112;
+    constexpr std::streamoff OFFSET_INTEGRATOR = 116;
+
+    CHECK(writeShortRun(dataPath, checkpointPath));
+    MappedTrajectoryFile file;
+    SimulationCheckpoint checkpoint;
+    CHECK(file.open(dataPath));
+    file.close();
+    CHECK(TrajectoryFile::loadCheckpoint(checkpointPath, checkpoint));
+
+    CHECK(patchU32(dataPath, OFFSET_INTEGRATOR, static_cast<std::uint32_t>(IntegratorType::Yoshida4) + 1));
+    CHECK(patchU32(checkpointPath, OFFSET_INTEGRATOR, static_cast<std::uint32_t>(IntegratorType::Yoshida4) + 1));
+    CHECK(!file.open(dataPath));
+    CHECK(!TrajectoryFile::loadCheckpoint(checkpointPath, checkpoint));
+
+    CHECK(patchU32(dataPath, OFFSET_INTEGRATOR, static_cast<std::uint32_t>(IntegratorType::RK4)));
+    CHECK(patchU32(checkpointPath, OFFSET_INTEGRATOR, static_cast<std::uint32_t>(IntegratorType::RK4)));
+    CHECK(patchU32(dataPath, OFFSET_STEPS, 0x80000000u));
+    CHECK(patchU32(checkpointPath, OFFSET_STEPS, 0x80000000u));
+    CHECK(!file.open(dataPath));
+    CHECK(!TrajectoryFile::loadCheckpoint(checkpointPath, checkpoint));
+}
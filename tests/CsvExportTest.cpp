@@ -0,0 +1,125 @@
+//   CSV   std::to_chars(fixed, PRECISION)   
+#include "TestHarness.h"
+
+#include "../include/CsvExport.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    std::string toCharsFixed(double value) {
+        char buffer[512];
+        const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, CsvTrajectoryWriter::PRECISION);
+        return std::string(buffer, result.ptr);
+    }
+
+    //     1  dt = value    value:    
+    //      to_chars.    ( ).
+    int countMismatches(const std::vector<double>& values) {
+        std::ostringstream out;
+        {
+            CsvTrajectoryWriter writer(out);
+            for (double value : values) {
+                const State state = { value, value, value, value };
+                writer.writeRows(1, &state, 1, value);
+            }
+        }
+        std::istringstream rows(out.str());
+        std::string row;
+        int mismatches = 0;
+        for (double value : values) {
+            const std::string field = toCharsFixed(value);
+            const std::string expected = "1,  " + field + ",  " + field + ",  " + field + ",  " + field + ",  " + field;
+            if (std::getline(rows, row) && row == expected) continue;
+            if (++mismatches <= 5) {
+                std::cerr << "    " << std::hexfloat << value << std::defaultfloat << ": '" << row << "' vs '" << expected << "'" << std::endl;
+            }
+        }
+        return mismatches;
+    }
+
+    //      double     
+    std::vector<double> withNeighbours(std::initializer_list<double> values, int neighbours = 3) {
+        std::vector<double> result;
+        for (double value : values) {
+            result.push_back(value);
+            double below = value, above = value;
+            for (int i = 0; i < neighbours; ++i) {
+                below = std::nextafter(below, -std::numeric_limits<double>::infinity());
+                above = std::nextafter(above, std::numeric_limits<double>::infinity());
+                result.push_back(below);
+                result.push_back(above);
+            }
+        }
+        return result;
+    }
+
+} // namespace
+
+TRAJCALC_TEST(CsvFixedFormatMatchesToCharsOnExactTies) {
+    // value * 10^5 == n + 0.5     m / 64:    
+    std::vector<double> values;
+    for (std::int64_t m : { 1LL, 3LL, 5LL, 63LL, 65LL, 127LL, 12345LL, 1000001LL, 987654321LL }) {
+        const double tie = static_cast<double>(m) / 64.0;
+        for (double value : withNeighbours({ tie, -tie })) values.push_back(value);
+    }
+    //  "",   double      
+    for (double value : withNeighbours({ 0.000005, 0.000015, 0.000025, 1.000005, 2.675005, 123.456785 })) {
+        values.push_back(value);
+        values.push_back(-value);
+    }
+    CHECK(countMismatches(values) == 0);
+}
+
+TRAJCALC_TEST(CsvFixedFormatMatchesToCharsOnSignedZeroAndTinyValues) {
+    std::vector<double> values = { 0.0, -0.0 };
+    for (double value : { 1e-300, 4.9e-324, 1e-7, 4.99999e-6, 5.00001e-6 }) {
+        values.push_back(value);
+        values.push_back(-value); // -0.00000,   printf
+    }
+    CHECK(countMismatches(values) == 0);
+}
+
+TRAJCALC_TEST(CsvFixedFormatMatchesToCharsNearFastPathLimit) {
+    //   std::to_chars  |value| * 10^5 >= 2^51
+    const double limit = 2251799813685248.0 / 1e5;
+    std::vector<double> values = withNeighbours({ limit, -limit }, 16);
+    const std::int64_t tieNumerator = static_cast<std::int64_t>(limit * 64.0) | 1; // :  
+    for (std::int64_t m = tieNumerator - 8; m <= tieNumerator + 8; m += 2) {
+        const double tie = static_cast<double>(m) / 64.0;
+        for (double value : withNeighbours({ tie, -tie })) values.push_back(value);
+    }
+    CHECK(countMismatches(values) == 0);
+}
+
+TRAJCALC_TEST(CsvFixedFormatMatchesToCharsOnLargeAndSpecialValues) {
+    std::vector<double> values;
+    for (double value : { 1e11, 4503599627370496.0, 1e15, 1e20, 1e100, 1e300, std::numeric_limits<double>::max() }) {
+        values.push_back(value);
+        values.push_back(-value);
+    }
+    values.push_back(std::numeric_limits<double>::infinity());
+    values.push_back(-std::numeric_limits<double>::infinity());
+    values.push_back(std::numeric_limits<double>::quiet_NaN());
+    values.push_back(-std::numeric_limits<double>::quiet_NaN());
+    CHECK(countMismatches(values) == 0);
+}
+
+TRAJCALC_TEST(CsvFixedFormatMatchesToCharsOnRandomValues) {
+    //       1e-8  1e12 (   )
+    std::mt19937_64 generator(20240607);
+    std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+    std::uniform_int_distribution<int> exponent(-8, 12);
+    std::vector<double> values(200000);
+    for (double& value : values) value = mantissa(generator) * std::pow(10.0, exponent(generator));
+    CHECK(countMismatches(values) == 0);
+}
@@ -0,0 +1,165 @@
+//          
+#include "TestHarness.h"
+
+#include "../include/MonteCarloEnsemble.h"
+#include "../include/ParameterSweep.h"
+#include "../include/SimulationConfig.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+    struct TwoPassStatistics {
+        double meanX = 0.0, meanY = 0.0;
+        double varianceX = 0.0, varianceY = 0.0, covarianceXY = 0.0;
+    };
+
+    TwoPassStatistics computeTwoPass(const std::vector<double>& x, const std::vector<double>& y) {
+        TwoPassStatistics result;
+        const double n = static_cast<double>(x.size());
+        for (size_t i = 0; i < x.size(); ++i) {
+            result.meanX += x[i] / n;
+            result.meanY += y[i] / n;
+        }
+        for (size_t i = 0; i < x.size(); ++i) {
+            const double dx = x[i] - result.meanX, dy = y[i] - result.meanY;
+            result.varianceX += dx * dx / (n - 1.0);
+            result.varianceY += dy * dy / (n - 1.0);
+            result.covarianceXY += dx * dy / (n - 1.0);
+        }
+        return result;
+    }
+
+    //     (   )    
+    void makeDefaultEnsemble(SimulationParameters& nominal, EnsembleDispersion& dispersion, EnsembleSettings& settings) {
+        ParameterStrings values;
+        values.m_satellite_kg = "500";
+        values.M_central_body_factor = "5";
+        values.V0_m_per_s = "130";
+        values.T_days = "500000";
+        values.k_coeff = "0,05";
+        values.F_coeff = "0";
+        const InputParameters input = SimulationConfig::validate(values);
+        double timeUnit = 0.0;
+        SimulationConfig::toSimulationParameters(input, nominal, timeUnit);
+        SimulationConfig::toEnsembleSettings(input, dispersion, settings);
+        settings.runs = 2 * MonteCarloEnsemble::RUNS_PER_TASK + 11; //  ,  
+        settings.seed = 12345;
+        settings.sampleCount = 9;
+        settings.histogramBins = 10;
+    }
+
+    bool sameResult(const EnsembleResult& a, const EnsembleResult& b) {
+        if (a.runs != b.runs || a.impacts != b.impacts || a.meanImpactTime != b.meanImpactTime
+            || a.impactTimeStdDev != b.impactTimeStdDev || a.impactTimeHistogram != b.impactTimeHistogram
+            || a.samples.size() != b.samples.size()) return false;
+        for (size_t k = 0; k < a.samples.size(); ++k) {
+            const EnsembleTimeSample& p = a.samples[k];
+            const EnsembleTimeSample& q = b.samples[k];
+            if (p.count != q.count || p.meanX != q.meanX || p.meanY != q.meanY || p.varianceX != q.varianceX
+                || p.varianceY != q.varianceY || p.covarianceXY != q.covarianceXY) return false;
+        }
+        return true;
+    }
+
+} // namespace
+
+//    ( )    ,   
+//    ,       
+TRAJCALC_TEST(MergedCovarianceMatchesTwoPass) {
+    std::mt19937_64 generator(7);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    std::vector<double> x, y;
+    for (int i = 0; i < 5000; ++i) {
+        const double u = normal(generator), v = normal(generator);
+        x.push_back(1.0e6 + 1e-3 * u);
+        y.push_back(-2.0e6 + 1e-3 * (0.6 * u + 0.8 * v));
+    }
+    const TwoPassStatistics expected = computeTwoPass(x, y);
+
+    const size_t bounds[] = { 0, 1, 700, 701, 3100, x.size() }; //   1, 699, 1, 2399  1900 
+    RunningCovariance2D merged;
+    for (size_t part = 0; part + 1 < sizeof(bounds) / sizeof(bounds[0]); ++part) {
+        RunningCovariance2D partial;
+        for (size_t i = bounds[part]; i < bounds[part + 1]; ++i) partial.add(x[i], y[i]);
+        merged.merge(partial);
+    }
+    merged.merge(RunningCovariance2D()); //     
+
+    CHECK(merged.count() == x.size());
+    CHECK_NEAR(merged.meanX(), expected.meanX, 1e-12 * std::abs(expected.meanX));
+    CHECK_NEAR(merged.meanY(), expected.meanY, 1e-12 * std::abs(expected.meanY));
+    CHECK_NEAR(merged.varianceX(), expected.varianceX, 1e-6 * expected.varianceX);
+    CHECK_NEAR(merged.varianceY(), expected.varianceY, 1e-6 * expected.varianceY);
+    CHECK_NEAR(merged.covarianceXY(), expected.covarianceXY, 1e-6 * expected.varianceX);
+    CHECK_NEAR(merged.covarianceXY() / std::sqrt(merged.varianceX() * merged.varianceY()), 0.6, 0.05);
+}
+
+TRAJCALC_TEST(EnsembleDoesNotDependOnThreadCount) {
+    SimulationParameters nominal;
+    EnsembleDispersion dispersion;
+    EnsembleSettings settings;
+    makeDefaultEnsemble(nominal, dispersion, settings);
+
+    const EnsembleResult one = MonteCarloEnsemble(1).run(nominal, dispersion, settings);
+    const EnsembleResult many = MonteCarloEnsemble(4).run(nominal, dispersion, settings);
+    CHECK(one.runs == settings.runs);
+    CHECK(sameResult(one, many));
+}
+
+//     ( , SummarySink  CollectingSink),
+//         
+TRAJCALC_TEST(EnsembleStatisticsMatchIndividualRuns) {
+    SimulationParameters nominal;
+    EnsembleDispersion dispersion;
+    EnsembleSettings settings;
+    makeDefaultEnsemble(nominal, dispersion, settings);
+    const EnsembleResult result = MonteCarloEnsemble(2).run(nominal, dispersion, settings);
+
+    const size_t sampleIndex = settings.sampleCount / 4; // ,     
+    const size_t sampleStep = sampleIndex * static_cast<size_t>(nominal.STEPS) / (settings.sampleCount - 1);
+    std::vector<double> impactTimes, sampleX, sampleY;
+    std::vector<size_t> histogram(settings.histogramBins, 0);
+    Calculations calculator;
+    calculator.setEventMessages(false);
+    for (size_t runIndex = 0; runIndex < settings.runs; ++runIndex) {
+        const size_t task = runIndex / MonteCarloEnsemble::RUNS_PER_TASK;
+        std::mt19937_64 generator = MonteCarloEnsemble::makeTaskGenerator(settings.seed, task);
+        SimulationParameters params;
+        for (size_t skip = task * MonteCarloEnsemble::RUNS_PER_TASK; skip <= runIndex; ++skip) {
+            params = MonteCarloEnsemble::samplePerturbed(nominal, dispersion, generator);
+        }
+        SummarySink summary;
+        CollectingSink states;
+        calculator.runSimulation(params, summary);
+        calculator.runSimulation(params, states);
+        if (summary.getSummary().impactStep >= 0) {
+            const double time = static_cast<double>(summary.getSummary().impactStep) * params.DT;
+            impactTimes.push_back(time);
+            ++histogram[std::min(static_cast<size_t>(time / result.histogramBinWidth), histogram.size() - 1)];
+        }
+        if (states.getStates().size() > sampleStep) {
+            sampleX.push_back(states.getStates()[sampleStep].x);
+            sampleY.push_back(states.getStates()[sampleStep].y);
+        }
+    }
+
+    CHECK(result.impacts == impactTimes.size());
+    CHECK(result.impacts > 1);
+    CHECK(result.impactTimeHistogram == histogram);
+    const TwoPassStatistics times = computeTwoPass(impactTimes, impactTimes);
+    CHECK_NEAR(result.meanImpactTime, times.meanX, 1e-12 * times.meanX);
+    CHECK_NEAR(result.impactTimeStdDev, std::sqrt(times.varianceX), 1e-9 * std::sqrt(times.varianceX));
+
+    const EnsembleTimeSample& sample = result.samples[sampleIndex];
+    const TwoPassStatistics positions = computeTwoPass(sampleX, sampleY);
+    CHECK(sample.count == sampleX.size());
+    CHECK_NEAR(sample.meanX, positions.meanX, 1e-12);
+    CHECK_NEAR(sample.meanY, positions.meanY, 1e-12);
+    CHECK_NEAR(sample.varianceX, positions.varianceX, 1e-9 * positions.varianceX);
+    CHECK_NEAR(sample.varianceY, positions.varianceY, 1e-9 * positions.varianceY);
+    CHECK_NEAR(sample.covarianceXY, positions.covarianceXY, 1e-9 * std::sqrt(positions.varianceX * positions.varianceY));
+}
@@ -0,0 +1,75 @@
+//   -   
+#include "TestHarness.h"
+
+#include "../include/NBodySimulation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+    //    theta = 0.5: max |a_tree - a_direct|      
+    //    (  2e-3    3000  )
+    constexpr double TREE_ERROR_BOUND = 1e-2;
+
+    //     ,      :
+    //       ,     
+    NBodySystem makeHeavyRing(const NBodyParameters& params, size_t particles) {
+        NBodySystem system;
+        system.addBody(1.0, { 0.0, 0.0, 0.0, 0.0 });
+        NBodySimulation::addDebrisRing(system, params.G, 0, particles, 1.2, 2.0, 1e-3, 42);
+        return system;
+    }
+
+    double maxDeviationToRms(const std::vector<double>& ax, const std::vector<double>& ay,
+        const std::vector<double>& referenceX, const std::vector<double>& referenceY) {
+        double sumSquares = 0.0, maxDeviation = 0.0;
+        for (size_t i = 0; i < referenceX.size(); ++i) {
+            sumSquares += referenceX[i] * referenceX[i] + referenceY[i] * referenceY[i];
+            maxDeviation = std::max(maxDeviation, std::hypot(ax[i] - referenceX[i], ay[i] - referenceY[i]));
+        }
+        return maxDeviation / std::sqrt(sumSquares / static_cast<double>(referenceX.size()));
+    }
+
+} // namespace
+
+TRAJCALC_TEST(BarnesHutMatchesDirectSumWithinBound) {
+    NBodyParameters params;
+    params.theta = 0.5;
+    params.directSumThreshold = 0; //  
+    const NBodySystem system = makeHeavyRing(params, 3000);
+
+    NBodySimulation simulation(2);
+    std::vector<double> treeX, treeY, directX, directY;
+    simulation.computeAccelerations(params, system, treeX, treeY);
+    CHECK(simulation.getLastStats().treeNodes > 0);
+    simulation.computeAccelerationsDirect(params, system, directX, directY);
+
+    const double deviation = maxDeviationToRms(treeX, treeY, directX, directY);
+    CHECK(deviation <= TREE_ERROR_BOUND);
+    CHECK(deviation > 0.0); //     
+}
+
+TRAJCALC_TEST(BarnesHutDoesNotDependOnThreadCount) {
+    NBodyParameters params;
+    params.directSumThreshold = 0;
+    const NBodySystem system = makeHeavyRing(params, 1500);
+
+    std::vector<double> oneX, oneY, manyX, manyY;
+    NBodySimulation(1).computeAccelerations(params, system, oneX, oneY);
+    NBodySimulation(4).computeAccelerations(params, system, manyX, manyY);
+    CHECK(oneX == manyX && oneY == manyY);
+}
+
+TRAJCALC_TEST(SmallSystemsUseDirectSum) {
+    NBodyParameters params;
+    const NBodySystem system = makeHeavyRing(params, params.directSumThreshold - 1);
+
+    NBodySimulation simulation(1);
+    std::vector<double> ax, ay, directX, directY;
+    simulation.computeAccelerations(params, system, ax, ay);
+    CHECK(simulation.getLastStats().treeNodes == 0);
+    simulation.computeAccelerationsDirect(params, system, directX, directY);
+    CHECK(ax == directX && ay == directY);
+}
@@ -0,0 +1,228 @@
+//   ,  ,  LRU    
+#include "TestHarness.h"
+
+#include "../include/SimulationCache.h"
+#include "../include/TrajectoryFile.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+    SimulationParameters makeParams(int steps) {
+        SimulationParameters params;
+        params.STEPS = steps;
+        return params;
+    }
+
+    // -:  ,     ,   
+    SimulationCache::StatesPtr makeStates(size_t count, double mark) {
+        auto states = std::make_shared<std::vector<State>>(count);
+        for (size_t i = 0; i < count; ++i) (*states)[i] = { mark, static_cast<double>(i), 0.0, 0.0 };
+        return states;
+    }
+
+    std::filesystem::path getCachePath(const testing_detail::TemporaryDirectory& directory, const SimulationParameters& params) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.trjb", static_cast<unsigned long long>(SimulationCache::makeKey(params)));
+        return directory.path() / name;
+    }
+
+    void setLastUsed(const std::filesystem::path& path, std::chrono::hours age) {
+        std::error_code error;
+        std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now() - age, error);
+        CHECK(!error);
+    }
+
+} // namespace
+
+TRAJCALC_TEST(CacheKeyIgnoresNegativeZeroAndUnusedAdaptiveSettings) {
+    const SimulationParameters base = makeParams(1000);
+
+    SimulationParameters negativeZero = base;
+    negativeZero.initialState.y = -0.0;
+    CHECK(base.initialState.y == 0.0);
+    CHECK(SimulationCache::makeKey(negativeZero) == SimulationCache::makeKey(base));
+
+    SimulationParameters rk4Adaptive = base; // RK4     
+    rk4Adaptive.adaptive.rtol *= 10;
+    rk4Adaptive.adaptive.maxStep *= 2;
+    CHECK(SimulationCache::makeKey(rk4Adaptive) == SimulationCache::makeKey(base));
+
+    SimulationParameters dp45 = base;
+    dp45.integrator = IntegratorType::DormandPrince45;
+    SimulationParameters dp45Adaptive = dp45;
+    dp45Adaptive.adaptive.rtol *= 10;
+    CHECK(SimulationCache::makeKey(dp45) != SimulationCache::makeKey(base));
+    CHECK(SimulationCache::makeKey(dp45Adaptive) != SimulationCache::makeKey(dp45));
+}
+
+TRAJCALC_TEST(CacheMissesWhenDtChanges) {
+    SimulationCache cache;
+    const SimulationParameters params = makeParams(10);
+    cache.store(params, makeStates(11, 1.0));
+
+    SimulationParameters otherDt = params;
+    otherDt.DT *= 0.5;
+    CHECK(SimulationCache::makeKey(otherDt) != SimulationCache::makeKey(params));
+    SimulationCache::StatesPtr states;
+    CHECK(!cache.find(otherDt, states));
+    CHECK(cache.getMissCount() == 1);
+
+    SimulationParameters sameRun = params;
+    sameRun.initialState.y = -0.0;
+    CHECK(cache.find(sameRun, states));
+    CHECK(states && states->size() == 11 && (*states)[0].x == 1.0);
+    CHECK(cache.getHitCount() == 1);
+}
+
+TRAJCALC_TEST(CacheRejectsKeyCollisionOnDisk) {
+    testing_detail::TemporaryDirectory directory("trajcalc_cache_test");
+    const SimulationParameters stored = makeParams(10);
+    SimulationParameters requested = stored;
+    requested.DT *= 2;
+    {
+        SimulationCache cache(directory.path().u8string());
+        cache.store(stored, makeStates(11, 1.0));
+    }
+    // :       
+    std::error_code error;
+    std::filesystem::rename(getCachePath(directory, stored), getCachePath(directory, requested), error);
+    CHECK(!error);
+
+    SimulationCache cache(directory.path().u8string());
+    SimulationCache::StatesPtr states;
+    CHECK(!cache.find(requested, states));
+    CHECK(!states);
+    CHECK(cache.getMissCount() == 1);
+    CHECK(cache.getMemoryBytes() == 0);
+}
+
+TRAJCALC_TEST(CacheEvictsLeastRecentlyUsedFromMemory) {
+    const size_t pointsPerRun = 101;
+    SimulationCache cache("", 2 * pointsPerRun * sizeof(State)); //  ,  
+    const SimulationParameters a = makeParams(100), b = makeParams(200), c = makeParams(300);
+    cache.store(a, makeStates(pointsPerRun, 1.0));
+    cache.store(b, makeStates(pointsPerRun, 2.0));
+
+    SimulationCache::StatesPtr states;
+    CHECK(cache.find(a, states)); // a   , b -  
+    cache.store(c, makeStates(pointsPerRun, 3.0));
+    CHECK(cache.getMemoryBytes() == 2 * pointsPerRun * sizeof(State));
+
+    CHECK(!cache.find(b, states));
+    CHECK(cache.find(a, states) && (*states)[0].x == 1.0);
+    CHECK(cache.find(c, states) && (*states)[0].x == 3.0);
+}
+
+TRAJCALC_TEST(CacheEvictsLeastRecentlyUsedFromDisk) {
+    testing_detail::TemporaryDirectory directory("trajcalc_cache_test");
+    const size_t pointsPerRun = 101;
+    const std::uintmax_t fileBytes = 256 + pointsPerRun * sizeof(State);
+    //   ( 0),     
+    SimulationCache cache(directory.path().u8string(), 0, 2 * fileBytes + fileBytes / 2);
+    const SimulationParameters a = makeParams(100), b = makeParams(200), c = makeParams(300);
+    cache.store(a, makeStates(pointsPerRun, 1.0));
+    cache.store(b, makeStates(pointsPerRun, 2.0));
+    CHECK(cache.getMemoryBytes() == 0);
+    setLastUsed(getCachePath(directory, a), std::chrono::hours(2));
+    setLastUsed(getCachePath(directory, b), std::chrono::hours(1));
+
+    SimulationCache::StatesPtr states;
+    CHECK(cache.find(a, states) && (*states)[0].x == 1.0); //    a
+    cache.store(c, makeStates(pointsPerRun, 3.0));
+
+    CHECK(std::filesystem::exists(getCachePath(directory, a)));
+    CHECK(!std::filesystem::exists(getCachePath(directory, b)));
+    CHECK(std::filesystem::exists(getCachePath(directory, c)));
+    CHECK(!cache.find(b, states));
+}
+
+TRAJCALC_TEST(CacheExtendsOnlyCompleteShorterRk4Runs) {
+    testing_detail::TemporaryDirectory directory("trajcalc_cache_test");
+    testing_detail::TemporaryDirectory output("trajcalc_cache_test");
+    const std::string prefixPath = output.file("prefix.trjb");
+    const SimulationParameters requested = makeParams(20);
+
+    //   (13   12)  prefixPath      
+    auto checkPrefix = [&prefixPath](const SimulationCheckpoint& from) {
+        CHECK(from.stepIndex == 12 && from.params.STEPS == 12 && from.state.x == 12.0 && from.state.y == 12.0);
+        MappedTrajectoryFile file;
+        CHECK(file.open(prefixPath));
+        CHECK(file.size() == 13 && file.data()[0].x == 12.0);
+    };
+    {
+        SimulationCache cache(directory.path().u8string());
+        cache.store(makeParams(10), makeStates(11, 10.0));
+        cache.store(makeParams(12), makeStates(13, 12.0)); //   
+        cache.store(makeParams(15), makeStates(8, 15.0));  // :  
+        cache.store(makeParams(25), makeStates(26, 25.0)); //  
+        SimulationParameters otherModel = makeParams(18);
+        otherModel.DT *= 2;
+        cache.store(otherModel, makeStates(19, 18.0));
+
+        SimulationCheckpoint from;
+        CHECK(cache.findExtendable(requested, prefixPath, from));
+        checkPrefix(from);
+        CHECK(cache.getHitCount() == 0 && cache.getMissCount() == 0);
+
+        SimulationParameters dp45 = requested;
+        dp45.integrator = IntegratorType::DormandPrince45;
+        CHECK(!cache.findExtendable(dp45, output.file("dp45.trjb"), from));
+        CHECK(!std::filesystem::exists(std::filesystem::u8path(output.file("dp45.trjb"))));
+
+        CHECK(!cache.findExtendable(makeParams(10), output.file("same.trjb"), from)); //    
+    }
+    //     
+    {
+        SimulationCache cache(directory.path().u8string());
+        SimulationCheckpoint from;
+        CHECK(cache.findExtendable(requested, prefixPath, from));
+        checkPrefix(from);
+    }
+    //    
+    SimulationCache memoryOnly;
+    memoryOnly.store(makeParams(12), makeStates(13, 12.0));
+    SimulationCheckpoint from;
+    CHECK(memoryOnly.findExtendable(requested, prefixPath, from));
+    checkPrefix(from);
+}
+
+TRAJCALC_TEST(CacheSharesMemoryEntriesAndAdoptsStreamedFiles) {
+    SimulationCache memoryOnly;
+    const SimulationParameters params = makeParams(10);
+    const SimulationCache::StatesPtr stored = makeStates(11, 1.0);
+    memoryOnly.store(params, stored);
+    SimulationCache::StatesPtr found;
+    CHECK(memoryOnly.find(params, found));
+    CHECK(found.get() == stored.get()); //  
+    CHECK(memoryOnly.getTemporaryPath(params).empty());
+
+    //        ,     
+    testing_detail::TemporaryDirectory directory("trajcalc_cache_test");
+    SimulationCache cache(directory.path().u8string());
+    const std::string temporaryPath = cache.getTemporaryPath(params);
+    CHECK(!temporaryPath.empty());
+    {
+        BinaryTrajectorySink file(temporaryPath);
+        file.begin(params);
+        file.consume(0, stored->data(), stored->size());
+        file.end();
+        CHECK(!file.hasFailed());
+    }
+    const std::string storedPath = cache.storeFile(params, temporaryPath);
+    CHECK(std::filesystem::u8path(storedPath) == getCachePath(directory, params));
+    CHECK(!std::filesystem::exists(std::filesystem::u8path(temporaryPath)));
+    CHECK(cache.getMemoryBytes() == 0);
+
+    SimulationCache reopened(directory.path().u8string());
+    CHECK(reopened.find(params, found));
+    CHECK(found && found->size() == stored->size());
+    if (found && found->size() == stored->size()) CHECK(std::memcmp(found->data(), stored->data(), stored->size() * sizeof(State)) == 0);
+}
@@ -0,0 +1,54 @@
+//       
+#include "TestHarness.h"
+
+#include "../include/SimulationConfig.h"
+
+#include <climits>
+
+namespace {
+
+    ParameterStrings makeValues(const char* M, const char* T, const char* dt) {
+        ParameterStrings values;
+        values.m_satellite_kg = "500";
+        values.M_central_body_factor = M;
+        values.V0_m_per_s = "130";
+        values.T_days = T;
+        values.k_coeff = "0,05";
+        values.F_coeff = "0";
+        values.dt = dt;
+        return values;
+    }
+
+} // namespace
+
+TRAJCALC_TEST(DefaultParametersGiveExpectedSteps) {
+    const InputParameters input = SimulationConfig::validate(makeValues("5", "500000", ""));
+    CHECK(input.isValid);
+    SimulationParameters params;
+    double timeUnit = 0.0;
+    CHECK(SimulationConfig::toSimulationParameters(input, params, timeUnit));
+    CHECK(params.STEPS == 79235);
+}
+
+// T / dt  2.2e10 :    int  STEPS = 1  
+TRAJCALC_TEST(StepCountAboveIntMaxIsRejected) {
+    const InputParameters input = SimulationConfig::validate(makeValues("100000", "10000000", "0,00001"));
+    CHECK(!input.isValid);
+    CHECK(input.errorMessage.find(L"") != std::wstring::npos);
+
+    //  validate (,    )   
+    InputParameters unchecked = input;
+    unchecked.isValid = true;
+    SimulationParameters params;
+    double timeUnit = 0.0;
+    CHECK(!SimulationConfig::toSimulationParameters(unchecked, params, timeUnit));
+}
+
+TRAJCALC_TEST(LargeButRepresentableStepCountIsAccepted) {
+    const InputParameters input = SimulationConfig::validate(makeValues("100000", "10000000", "0,001"));
+    CHECK(input.isValid);
+    SimulationParameters params;
+    double timeUnit = 0.0;
+    CHECK(SimulationConfig::toSimulationParameters(input, params, timeUnit));
+    CHECK(params.STEPS > 100000000 && params.STEPS < INT_MAX);
+}
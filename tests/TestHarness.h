@@ -0,0 +1,66 @@
+#pragma once
+#ifndef TESTHARNESS_H
+#define TESTHARNESS_H
+
+//        :  
+// TRAJCALC_TEST() { ... },  - CHECK  CHECK_NEAR.  
+//   std::cerr,  ; trajcalc_tests  ,
+//      .
+
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+namespace testing_detail {
+
+    using TestFunction = void (*)();
+
+    //     
+    struct TestRegistrar {
+        TestRegistrar(const char* name, TestFunction function);
+    };
+
+    void reportFailure(const char* file, int line, const char* expression);
+
+    //          
+    // (      );   
+    class TemporaryDirectory {
+    public:
+        explicit TemporaryDirectory(const char* prefix);
+        ~TemporaryDirectory();
+        TemporaryDirectory(const TemporaryDirectory&) = delete;
+        TemporaryDirectory& operator=(const TemporaryDirectory&) = delete;
+
+        const std::filesystem::path& path() const { return m_path; }
+        //    name    UTF-8
+        std::string file(const char* name) const { return (m_path / name).u8string(); }
+
+    private:
+        std::filesystem::path m_path;
+    };
+
+} // namespace testing_detail
+
+#define TRAJCALC_TEST(name)                                                              \
+    static void name();                                                                  \
+    static const testing_detail::TestRegistrar name##Registrar(#name, &name);            \
+    static void name()
+
+#define CHECK(condition)                                                                 \
+    do {                                                                                 \
+        if (!(condition)) testing_detail::reportFailure(__FILE__, __LINE__, #condition); \
+    } while (false)
+
+// |actual - expected| <= tolerance;     
+#define CHECK_NEAR(actual, expected, tolerance)                                          \
+    do {                                                                                 \
+        const double checkActual = (actual), checkExpected = (expected);                 \
+        if (!(std::abs(checkActual - checkExpected) <= (tolerance))) {                   \
+            testing_detail::reportFailure(__FILE__, __LINE__, #actual " ~ " #expected);  \
+            std::cerr << "    " << checkActual << " vs " << checkExpected                \
+                << " (tolerance " << (tolerance) << ")" << std::endl;                    \
+        }                                                                                \
+    } while (false)
+
+#endif // TESTHARNESS_H
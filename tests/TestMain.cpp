@@ -0,0 +1,70 @@
+//   : trajcalc_tests [  ]
+#include "TestHarness.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+    struct TestCase {
+        const char* name;
+        testing_detail::TestFunction function;
+    };
+
+    std::vector<TestCase>& getRegistry() {
+        static std::vector<TestCase> registry;
+        return registry;
+    }
+
+    int g_failedChecks = 0;
+
+} // namespace
+
+testing_detail::TestRegistrar::TestRegistrar(const char* name, TestFunction function) {
+    getRegistry().push_back({ name, function });
+}
+
+void testing_detail::reportFailure(const char* file, int line, const char* expression) {
+    ++g_failedChecks;
+    std::cerr << file << ":" << line << ": CHECK failed: " << expression << std::endl;
+}
+
+testing_detail::TemporaryDirectory::TemporaryDirectory(const char* prefix) {
+    std::random_device device;
+    std::mt19937_64 generator((static_cast<std::uint64_t>(device()) << 32) ^ device());
+    std::error_code error;
+    const std::filesystem::path base = std::filesystem::temp_directory_path(error);
+    // create_directory  false,    :    
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        m_path = base / (std::string(prefix) + "_" + std::to_string(generator()));
+        if (std::filesystem::create_directory(m_path, error)) return;
+    }
+    std::cerr << "TemporaryDirectory: Could not create a directory in '" << base.u8string() << "'." << std::endl;
+}
+
+testing_detail::TemporaryDirectory::~TemporaryDirectory() {
+    std::error_code error;
+    std::filesystem::remove_all(m_path, error);
+}
+
+int main(int argc, char** argv) {
+    const char* filter = (argc > 1) ? argv[1] : nullptr;
+    int failedTests = 0;
+    int runTests = 0;
+    for (const TestCase& test : getRegistry()) {
+        if (filter && !std::strstr(test.name, filter)) continue;
+        const int failedBefore = g_failedChecks;
+        test.function();
+        ++runTests;
+        const bool passed = (g_failedChecks == failedBefore);
+        if (!passed) ++failedTests;
+        std::cout << (passed ? "[ OK   ] " : "[ FAIL ] ") << test.name << std::endl;
+    }
+    std::cout << runTests - failedTests << " of " << runTests << " tests passed" << std::endl;
+    return (failedTests == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}